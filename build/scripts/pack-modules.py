@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+
+"""Packs the JavaScript and JSON sources of an application into a module bundle.
+
+Usage: pack-modules.py <application path> [<output file>]
+
+Every .js and .json file under <application path>/app is stored with its path
+relative to <application path>. The runtime maps <application path>/app.tnsmodules
+on startup and resolves and loads modules from it before looking at loose files.
+See src/NativeScript/ModuleBundle.h for the layout.
+"""
+
+import os
+import struct
+import sys
+
+MAGIC = b"TNSM"
+VERSION = 1
+HEADER_FORMAT = "<4sII"
+ENTRY_FORMAT = "<IIII"
+EXTENSIONS = (".js", ".json")
+
+
+def collect_modules(application_path):
+    modules = []
+    for directory, _, files in os.walk(os.path.join(application_path, "app")):
+        for name in files:
+            if name.endswith(EXTENSIONS):
+                path = os.path.join(directory, name)
+                relative_path = os.path.relpath(path, application_path).replace(os.sep, "/")
+                modules.append((relative_path.encode("utf-8"), path))
+
+    # The runtime binary searches the entries, keep them sorted by the raw path bytes
+    modules.sort(key=lambda module: module[0])
+    return modules
+
+
+def pack(modules, output):
+    data_offset = struct.calcsize(HEADER_FORMAT) + len(modules) * struct.calcsize(ENTRY_FORMAT)
+    entries = []
+    blobs = []
+    for relative_path, path in modules:
+        with open(path, "rb") as source:
+            content = source.read()
+
+        path_offset = data_offset
+        content_offset = path_offset + len(relative_path)
+        data_offset = content_offset + len(content)
+        if data_offset > 0xFFFFFFFF:
+            raise ValueError("module bundle exceeds 4 GB")
+
+        entries.append(struct.pack(ENTRY_FORMAT, path_offset, len(relative_path), content_offset, len(content)))
+        blobs.append(relative_path)
+        blobs.append(content)
+
+    output.write(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(modules)))
+    for entry in entries:
+        output.write(entry)
+    for blob in blobs:
+        output.write(blob)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.stderr.write("Application path argument is missing\n")
+        sys.exit(2)
+
+    application_path = sys.argv[1]
+    output_path = sys.argv[2] if len(sys.argv) > 2 else os.path.join(application_path, "app.tnsmodules")
+
+    modules = collect_modules(application_path)
+    with open(output_path, "wb") as output:
+        pack(modules, output)
+
+    sys.stdout.write("Packed {} modules into {}\n".format(len(modules), output_path))
@@ -8,6 +8,7 @@ function(CreateNativeScriptApp _target _main _plist _resources)
         "-ObjC"
         "-framework CoreGraphics"
         "-framework UIKit"
+        "-framework QuartzCore"
         "-framework MobileCoreServices"
         "-framework Security"
     )
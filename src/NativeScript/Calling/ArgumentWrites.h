@@ -0,0 +1,98 @@
+//
+//  ArgumentWrites.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__ArgumentWrites__
+#define __NativeScript__ArgumentWrites__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace NativeScript {
+
+/// How a parameter is marshalled, resolved from its type when the call is initialized.
+/// Parameters of the common types are written inline, all others through their method table.
+enum class ArgumentWriteKind : uint8_t {
+    Generic,
+    Bool,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Double,
+    Object,
+    // NSString parameters, which are mostly passed JavaScript strings
+    String
+};
+
+struct ArgumentWrite {
+    ArgumentWriteKind kind;
+    size_t offset;
+};
+
+/// Writes an argument to its place in the invocation buffer. The conversions which need the engine are
+/// left to the marshaller, which FFICall implements with JavaScriptCore:
+///
+///     bool toBoolean(const Value&);
+///     double toNumber(const Value&);
+///     void writeObject(const Value&, void* buffer);
+///     void writeString(const Value&, void* buffer);
+///     void writeGeneric(size_t parameterIndex, const Value&, void* buffer);
+template <typename Marshaller, typename Value>
+inline void writeArgument(Marshaller& marshaller, const ArgumentWrite& argumentWrite, uint8_t* invocationBuffer, size_t parameterIndex, const Value& argument) {
+    void* buffer = invocationBuffer + argumentWrite.offset;
+
+    // Numbers are converted the same way as by the numeric method tables, without the indirect call
+    switch (argumentWrite.kind) {
+    case ArgumentWriteKind::Bool:
+        *static_cast<bool*>(buffer) = marshaller.toBoolean(argument);
+        return;
+    case ArgumentWriteKind::Int8:
+        *static_cast<int8_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::UInt8:
+        *static_cast<uint8_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::Int16:
+        *static_cast<int16_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::UInt16:
+        *static_cast<uint16_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::Int32:
+        *static_cast<int32_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::UInt32:
+        *static_cast<uint32_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::Int64:
+        *static_cast<int64_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::UInt64:
+        *static_cast<uint64_t*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::Float:
+        *static_cast<float*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::Double:
+        *static_cast<double*>(buffer) = marshaller.toNumber(argument);
+        return;
+    case ArgumentWriteKind::Object:
+        return marshaller.writeObject(argument, buffer);
+    case ArgumentWriteKind::String:
+        return marshaller.writeString(argument, buffer);
+    case ArgumentWriteKind::Generic:
+        return marshaller.writeGeneric(parameterIndex, argument, buffer);
+    }
+}
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__ArgumentWrites__) */
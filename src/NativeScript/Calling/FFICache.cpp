@@ -11,6 +11,11 @@
 
 namespace NativeScript {
 
+static void deleteCif(ffi_cif* cif) {
+    delete[] cif->arg_types;
+    delete cif;
+}
+
 FFICache* FFICache::global() {
 
     static FFICache* instance;
@@ -20,4 +25,23 @@ FFICache* FFICache::global() {
     return instance;
 }
 
+std::shared_ptr<ffi_cif> FFICache::getCif(const std::vector<const ffi_type*>& signature) {
+    WTF::LockHolder lock(this->_cacheLock);
+
+    std::shared_ptr<ffi_cif>& cif = this->cifCache[signature];
+    if (!cif) {
+        // The parameter types array is owned by the cif, so it is only allocated for a signature which is not cached yet
+        unsigned parametersCount = signature.size() - 1;
+        ffi_type** parameterTypes = new ffi_type*[parametersCount];
+        for (unsigned i = 0; i < parametersCount; i++) {
+            parameterTypes[i] = const_cast<ffi_type*>(signature[i + 1]);
+        }
+
+        cif = std::shared_ptr<ffi_cif>(new ffi_cif, deleteCif);
+        ffi_prep_cif(cif.get(), FFI_DEFAULT_ABI, parametersCount, const_cast<ffi_type*>(signature[0]), parameterTypes);
+    }
+
+    return cif;
+}
+
 } // namespace NativeScript
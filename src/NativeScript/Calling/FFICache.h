@@ -10,6 +10,8 @@
 #define __NativeScript__FFICache__
 
 #include "FFIType.h"
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace NativeScript {
@@ -33,6 +35,10 @@ public:
     FFIMap cifCache;
 
     static FFICache* global();
+
+    // Returns the cif of a signature, which lists the return type followed by the parameter types
+    std::shared_ptr<ffi_cif> getCif(const std::vector<const ffi_type*>& signature);
+
     WTF::Lock _cacheLock;
 };
 
@@ -8,6 +8,8 @@
 #ifndef FFICall_h
 #define FFICall_h
 
+#include "ArgumentWrites.h"
+#include "FFICallLayout.h"
 #include "FFIType.h"
 #include "ReleasePool.h"
 #include <JavaScriptCore/Exception.h>
@@ -22,6 +24,7 @@ class FFICall {
 public:
     class Invocation {
         friend class FunctionWrapper;
+        friend class FFICall;
 
         WTF_MAKE_NONCOPYABLE(Invocation)
         WTF_MAKE_FAST_ALLOCATED;
@@ -30,7 +33,7 @@ public:
         void* function;
 
         void* argumentBuffer(unsigned index) {
-            return _buffer + owner->_argValueOffsets[index];
+            return _buffer + owner->_layout.argValueOffsets[index];
         }
 
         template <typename T>
@@ -44,7 +47,7 @@ public:
         }
 
         void* resultBuffer() {
-            return _buffer + owner->_returnOffset;
+            return _buffer + owner->_layout.returnOffset;
         }
 
         template <typename T>
@@ -61,10 +64,10 @@ public:
     private:
         Invocation(FFICall* owner)
             : owner(owner) {
-            _buffer = reinterpret_cast<uint8_t*>(WTF::fastMalloc(owner->_stackSize));
-            void** argsArray = reinterpret_cast<void**>(_buffer + owner->_argsArrayOffset);
+            _buffer = reinterpret_cast<uint8_t*>(WTF::fastMalloc(owner->_layout.stackSize));
+            void** argsArray = reinterpret_cast<void**>(_buffer + owner->_layout.argsArrayOffset);
             for (size_t i = 0; i < owner->_argsCount; i++) {
-                argsArray[i] = _buffer + owner->_argValueOffsets[i];
+                argsArray[i] = _buffer + owner->_layout.argValueOffsets[i];
             }
         }
 
@@ -102,15 +105,15 @@ public:
     }
 
     size_t stackSize() const {
-        return this->_stackSize;
+        return this->_layout.stackSize;
     }
 
     size_t returnOffset() const {
-        return this->_returnOffset;
+        return this->_layout.returnOffset;
     }
 
     size_t argsArrayOffset() const {
-        return this->_argsArrayOffset;
+        return this->_layout.argsArrayOffset;
     }
 
     JSC::WriteBarrier<JSC::JSCell> returnTypeCell() const {
@@ -125,8 +128,6 @@ public:
         return this->_parameterTypes;
     }
 
-    std::shared_ptr<ffi_cif> getCif(unsigned int nargs, ffi_type* rtype, ffi_type** atypes);
-
     std::vector<const ffi_type*> signatureVector;
 
     void preCall(JSC::ExecState* execState, Invocation& invocation) {
@@ -142,9 +143,7 @@ public:
         // TODO: Check if arguments can be converted
 
         for (size_t i = 0; i < execState->argumentCount(); i++) {
-            JSC::JSValue argument = execState->uncheckedArgument(i);
-            JSCell* parameterType = _parameterTypesCells[i].get();
-            _parameterTypes[i].write(execState, argument, invocation.argumentBuffer(i + _initialArgumentIndex), parameterType);
+            this->writeArgument(execState, invocation, i);
 
             if (scope.exception()) {
                 return;
@@ -160,9 +159,66 @@ public:
         }
     }
 
+    // Everything about a call which depends only on its types, so that calls of the same types can share it
+    struct PreparedCall {
+        std::vector<const ffi_type*> signatureVector;
+        std::shared_ptr<ffi_cif> cif;
+        FFITypeMethodTable returnType;
+        WTF::Vector<FFITypeMethodTable> parameterTypes;
+        WTF::Vector<ArgumentWrite> argumentWrites;
+        size_t initialArgumentIndex;
+        size_t argsCount;
+        FFICallLayout layout;
+    };
+
     void initializeFFI(JSC::VM&, const InvocationHooks&, JSC::JSCell* returnType, const WTF::Vector<Strong<JSC::JSCell>>& parameterTypes, size_t initialArgumentIndex = 0);
 
+    // Reuses a signature and stack layout prepared for the same types
+    void initializeFFI(JSC::VM&, const InvocationHooks&, JSC::JSCell* returnType, const WTF::Vector<JSC::WriteBarrier<JSC::JSCell>>& parameterTypes, const PreparedCall&);
+
+    static std::shared_ptr<const PreparedCall> prepare(JSC::VM&, JSC::JSCell* returnType, const WTF::Vector<Strong<JSC::JSCell>>& parameterTypes, size_t initialArgumentIndex);
+
 protected:
+    template <typename TypeCell>
+    void initializeFromPreparedCall(JSC::VM&, const InvocationHooks&, JSC::JSCell* returnType, const WTF::Vector<TypeCell>& parameterTypes, const PreparedCall&);
+
+    static ArgumentWriteKind argumentWriteKind(JSC::VM&, JSC::JSCell* type, const FFITypeMethodTable&);
+
+    static void writeObject(JSC::ExecState*, const JSC::JSValue&, void* buffer);
+
+    static void writeString(JSC::ExecState*, const JSC::JSValue&, void* buffer);
+
+    // The conversions of writeArgument() in ArgumentWrites.h
+    struct ArgumentMarshaller {
+        JSC::ExecState* execState;
+        FFICall* call;
+
+        bool toBoolean(const JSC::JSValue& value) {
+            return value.toBoolean(execState);
+        }
+
+        double toNumber(const JSC::JSValue& value) {
+            return value.toNumber(execState);
+        }
+
+        void writeObject(const JSC::JSValue& value, void* buffer) {
+            FFICall::writeObject(execState, value, buffer);
+        }
+
+        void writeString(const JSC::JSValue& value, void* buffer) {
+            FFICall::writeString(execState, value, buffer);
+        }
+
+        void writeGeneric(size_t parameterIndex, const JSC::JSValue& value, void* buffer) {
+            call->_parameterTypes[parameterIndex].write(execState, value, buffer, call->_parameterTypesCells[parameterIndex].get());
+        }
+    };
+
+    void writeArgument(JSC::ExecState* execState, Invocation& invocation, size_t parameterIndex) {
+        ArgumentMarshaller marshaller = { execState, this };
+        NativeScript::writeArgument(marshaller, this->_argumentWrites[parameterIndex], invocation._buffer, parameterIndex, execState->uncheckedArgument(parameterIndex));
+    }
+
     std::shared_ptr<ffi_cif> _cif;
 
     FunctionWrapper* owner;
@@ -174,14 +230,12 @@ protected:
 
     WTF::Vector<FFITypeMethodTable> _parameterTypes;
     WTF::Vector<JSC::WriteBarrier<JSC::JSCell>> _parameterTypesCells;
+    WTF::Vector<ArgumentWrite> _argumentWrites;
 
     size_t _initialArgumentIndex;
 
     size_t _argsCount;
-    size_t _stackSize;
-    size_t _returnOffset;
-    size_t _argsArrayOffset;
-    std::vector<size_t> _argValueOffsets;
+    FFICallLayout _layout;
 };
 } // namespace NativeScript
 
@@ -0,0 +1,143 @@
+//
+//  FFICall.mm
+//  NativeScript
+//
+//  Copyright (c) 2014 г. Telerik. All rights reserved.
+//  Created by Teodor Dermendzhiev on 10/15/18.
+//
+
+#include "FFICall.h"
+#include "FFICache.h"
+#include "FFINumericTypes.h"
+#include "FFIPrimitiveTypes.h"
+#include "FunctionWrapper.h"
+#include "ObjCConstructorBase.h"
+#include "ObjCPrimitiveTypes.h"
+#include "ObjCTypes.h"
+#include "ObjCWrapperObject.h"
+#include <JavaScriptCore/JSPromiseDeferred.h>
+#include <JavaScriptCore/interpreter/FrameTracers.h>
+#include <JavaScriptCore/interpreter/Interpreter.h>
+#include <dispatch/dispatch.h>
+
+namespace NativeScript {
+
+std::shared_ptr<const FFICall::PreparedCall> FFICall::prepare(VM& vm, JSCell* returnType, const Vector<Strong<JSCell>>& parameterTypes, size_t initialArgumentIndex) {
+    std::shared_ptr<PreparedCall> preparedCall = std::make_shared<PreparedCall>();
+
+    preparedCall->initialArgumentIndex = initialArgumentIndex;
+
+    preparedCall->returnType = getFFITypeMethodTable(vm, returnType);
+
+    size_t parametersCount = parameterTypes.size();
+
+    preparedCall->signatureVector.push_back(preparedCall->returnType.ffiType);
+
+    for (size_t i = 0; i < initialArgumentIndex; ++i) {
+        preparedCall->signatureVector.push_back(&ffi_type_pointer);
+    }
+
+    for (size_t i = 0; i < parametersCount; i++) {
+        const FFITypeMethodTable& ffiTypeMethodTable = getFFITypeMethodTable(vm, parameterTypes[i].get());
+        preparedCall->parameterTypes.append(ffiTypeMethodTable);
+
+        preparedCall->signatureVector.push_back(ffiTypeMethodTable.ffiType);
+    }
+
+    preparedCall->cif = FFICache::global()->getCif(preparedCall->signatureVector);
+
+    preparedCall->argsCount = preparedCall->cif->nargs;
+    preparedCall->layout = FFICallLayout(*preparedCall->cif);
+
+    preparedCall->argumentWrites.reserveInitialCapacity(parametersCount);
+    for (size_t i = 0; i < parametersCount; i++) {
+        ArgumentWriteKind kind = argumentWriteKind(vm, parameterTypes[i].get(), preparedCall->parameterTypes[i]);
+        preparedCall->argumentWrites.uncheckedAppend({ kind, preparedCall->layout.argValueOffsets[i + initialArgumentIndex] });
+    }
+
+    return preparedCall;
+}
+
+template <typename TypeCell>
+void FFICall::initializeFromPreparedCall(VM& vm, const InvocationHooks& hooks, JSCell* returnType, const Vector<TypeCell>& parameterTypes, const PreparedCall& preparedCall) {
+    this->_invocationHooks = hooks;
+
+    this->_initialArgumentIndex = preparedCall.initialArgumentIndex;
+
+    this->_returnTypeCell.set(vm, owner, returnType);
+    this->_returnType = preparedCall.returnType;
+
+    this->_parameterTypes = preparedCall.parameterTypes;
+    this->_parameterTypesCells.reserveInitialCapacity(parameterTypes.size());
+    for (const TypeCell& parameterType : parameterTypes) {
+        this->_parameterTypesCells.uncheckedAppend(WriteBarrier<JSCell>(vm, owner, parameterType.get()));
+    }
+
+    this->signatureVector = preparedCall.signatureVector;
+    this->_cif = preparedCall.cif;
+
+    this->_argsCount = preparedCall.argsCount;
+    this->_layout = preparedCall.layout;
+    this->_argumentWrites = preparedCall.argumentWrites;
+}
+
+void FFICall::initializeFFI(VM& vm, const InvocationHooks& hooks, JSCell* returnType, const Vector<Strong<JSCell>>& parameterTypes, size_t initialArgumentIndex) {
+    this->initializeFromPreparedCall(vm, hooks, returnType, parameterTypes, *prepare(vm, returnType, parameterTypes, initialArgumentIndex));
+}
+
+void FFICall::initializeFFI(VM& vm, const InvocationHooks& hooks, JSCell* returnType, const Vector<WriteBarrier<JSCell>>& parameterTypes, const PreparedCall& preparedCall) {
+    this->initializeFromPreparedCall(vm, hooks, returnType, parameterTypes, preparedCall);
+}
+
+ArgumentWriteKind FFICall::argumentWriteKind(VM& vm, JSCell* type, const FFITypeMethodTable& methodTable) {
+    // Simple types copy their method table, so they are recognized by its write function
+    static const std::pair<decltype(FFITypeMethodTable::write), ArgumentWriteKind> inlineWrites[] = {
+        { boolTypeMethodTable.write, ArgumentWriteKind::Bool },
+        { int8TypeMethodTable.write, ArgumentWriteKind::Int8 },
+        { uint8TypeMethodTable.write, ArgumentWriteKind::UInt8 },
+        { int16TypeMethodTable.write, ArgumentWriteKind::Int16 },
+        { uint16TypeMethodTable.write, ArgumentWriteKind::UInt16 },
+        { int32TypeMethodTable.write, ArgumentWriteKind::Int32 },
+        { uint32TypeMethodTable.write, ArgumentWriteKind::UInt32 },
+        { int64TypeMethodTable.write, ArgumentWriteKind::Int64 },
+        { uint64TypeMethodTable.write, ArgumentWriteKind::UInt64 },
+        { floatTypeMethodTable.write, ArgumentWriteKind::Float },
+        { doubleTypeMethodTable.write, ArgumentWriteKind::Double },
+        { objCInstancetypeTypeMethodTable.write, ArgumentWriteKind::Object },
+    };
+
+    for (const auto& inlineWrite : inlineWrites) {
+        if (methodTable.write == inlineWrite.first) {
+            return inlineWrite.second;
+        }
+    }
+
+    if (ObjCConstructorBase* constructor = jsDynamicCast<ObjCConstructorBase*>(vm, type)) {
+        if (constructor->writesWithToObject()) {
+            return constructor->klass() == [NSString class] ? ArgumentWriteKind::String : ArgumentWriteKind::Object;
+        }
+    }
+
+    return ArgumentWriteKind::Generic;
+}
+
+void FFICall::writeObject(ExecState* execState, const JSValue& value, void* buffer) {
+    // Wrappers of native objects and nil are by far the most common, everything else goes through toObject
+    if (value.isCell() && value.asCell()->type() == static_cast<JSType>(ObjCWrapperObjectType)) {
+        *static_cast<id*>(buffer) = jsCast<ObjCWrapperObject*>(value.asCell())->wrappedObject();
+    } else if (value.isUndefinedOrNull()) {
+        *static_cast<id*>(buffer) = nil;
+    } else {
+        *static_cast<id*>(buffer) = NativeScript::toObject(execState, value);
+    }
+}
+
+void FFICall::writeString(ExecState* execState, const JSValue& value, void* buffer) {
+    if (value.isString()) {
+        *static_cast<id*>(buffer) = [[static_cast<NSString*>(asString(value)->value(execState)) copy] autorelease];
+    } else {
+        writeObject(execState, value, buffer);
+    }
+}
+
+} // namespace NativeScript
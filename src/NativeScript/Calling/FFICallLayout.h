@@ -0,0 +1,49 @@
+//
+//  FFICallLayout.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__FFICallLayout__
+#define __NativeScript__FFICallLayout__
+
+#include <algorithm>
+#include <malloc/malloc.h>
+#include <vector>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundef"
+#include <ffi.h>
+#pragma clang diagnostic pop
+
+namespace NativeScript {
+
+/// Placement of the parts of an FFICall invocation in its buffer: the array of argument pointers passed
+/// to ffi_call, followed by the return value and the argument values. Every slot is at least ffi_arg
+/// sized and is rounded up to a malloc size class.
+struct FFICallLayout {
+    size_t stackSize = 0;
+    size_t argsArrayOffset = 0;
+    size_t returnOffset = 0;
+    std::vector<size_t> argValueOffsets;
+
+    FFICallLayout() = default;
+
+    explicit FFICallLayout(const ffi_cif& cif) {
+        this->argsArrayOffset = this->stackSize;
+        this->stackSize += malloc_good_size(sizeof(void*) * cif.nargs);
+
+        this->returnOffset = this->stackSize;
+        this->stackSize += malloc_good_size(std::max(cif.rtype->size, sizeof(ffi_arg)));
+
+        this->argValueOffsets.reserve(cif.nargs);
+        for (unsigned i = 0; i < cif.nargs; i++) {
+            this->argValueOffsets.push_back(this->stackSize);
+            this->stackSize += malloc_good_size(std::max(cif.arg_types[i]->size, sizeof(ffi_arg)));
+        }
+    }
+};
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__FFICallLayout__) */
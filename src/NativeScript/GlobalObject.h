@@ -25,6 +25,9 @@ class ObjCWrapperObject;
 class GlobalObjectInspectorController;
 class FFICallPrototype;
 class ReleasePoolBase;
+class ModuleBundle;
+class JSTimers;
+class JSFrameCallbacks;
 
 class GlobalObject : public JSC::JSGlobalObject {
 public:
@@ -75,31 +78,46 @@ public:
     }
 
     JSC::Structure* objCBlockCallbackStructure() const {
-        return this->_objCBlockCallbackStructure.get();
+        return this->_objCBlockCallbackStructure.get(this);
     }
 
     JSC::Structure* objCMethodCallbackStructure() const {
-        return this->_objCMethodCallbackStructure.get();
+        return this->_objCMethodCallbackStructure.get(this);
     }
 
     JSC::Structure* ffiFunctionCallbackStructure() const {
-        return this->_ffiFunctionCallbackStructure.get();
+        return this->_ffiFunctionCallbackStructure.get(this);
     }
 
     JSC::Structure* recordFieldGetterStructure() const {
-        return this->_recordFieldGetterStructure.get();
+        return this->_recordFieldGetterStructure.get(this);
     }
 
     JSC::Structure* recordFieldSetterStructure() const {
-        return this->_recordFieldSetterStructure.get();
+        return this->_recordFieldSetterStructure.get(this);
     }
 
     Interop* interop() const {
-        return this->_interop.get();
+        return this->_interop.get(this);
     }
 
     JSC::Strong<ObjCConstructorBase> constructorFor(Class klass, Class fallback = Nil, bool searchBaseClasses = true);
 
+    // When enabled, constructors of native classes are held weakly and are not cached as global
+    // properties, so ones without live instances or JS references can be collected and are
+    // rematerialized on next use. Constructors of classes extended from JS are always held strongly.
+    bool weaklyHoldsClassConstructors() const {
+        return this->_weaklyHoldsClassConstructors;
+    }
+
+    void setWeaklyHoldsClassConstructors(bool weaklyHoldsClassConstructors) {
+        this->_weaklyHoldsClassConstructors = weaklyHoldsClassConstructors;
+    }
+
+    // Estimated JS heap bytes held by the constructor, prototype, structures and lazily
+    // created member wrappers of each materialized class
+    std::map<Class, size_t> interopHeapUsage();
+
     JSC::Strong<ObjCProtocolWrapper> protocolWrapperFor(Protocol* aProtocol);
 
     JSC::Structure* weakRefConstructorStructure() const {
@@ -127,15 +145,15 @@ public:
     }
 
     JSC::Structure* unmanagedInstanceStructure() const {
-        return this->_unmanagedInstanceStructure.get();
+        return this->_unmanagedInstanceStructure.get(this);
     }
 
     JSC::JSFunction* typeScriptOriginalExtendsFunction() const {
-        return this->_typeScriptOriginalExtendsFunction.get();
+        return this->_typeScriptOriginalExtendsFunction.get(this);
     }
 
     JSC::JSFunction* smartStringifyFunction() const {
-        return this->_smartStringifyFunction.get();
+        return this->_smartStringifyFunction.get(this);
     }
 
     GlobalObjectInspectorController& inspectorController() const {
@@ -151,7 +169,7 @@ public:
     }
 
     JSC::Structure* fastEnumerationIteratorStructure() const {
-        return this->_fastEnumerationIteratorStructure.get();
+        return this->_fastEnumerationIteratorStructure.get(this);
     }
 
     CFRunLoopSourceRef microtaskRunLoopSource() const {
@@ -166,6 +184,14 @@ public:
         return this->_microtaskRunLoops;
     }
 
+    JSTimers& timers() const {
+        return *this->_timers.get();
+    }
+
+    JSFrameCallbacks& frameCallbacks() const {
+        return *this->_frameCallbacks.get();
+    }
+
     void drainMicrotasks();
 
     WTF::Deque<WTF::RefPtr<JSC::Microtask>>& microtasks() {
@@ -180,6 +206,10 @@ public:
         return this->_commonJSModuleFunctionIdentifier;
     }
 
+    const ModuleBundle* moduleBundle() const {
+        return this->_moduleBundle;
+    }
+
     WTF::HashMap<WTF::String, WTF::String, WTF::ASCIICaseInsensitiveHash>& modulePathCache() {
         return this->_modulePathCache;
     }
@@ -192,6 +222,8 @@ public:
 protected:
     static JSC::EncodedJSValue JSC_HOST_CALL commonJSRequire(JSC::ExecState*);
 
+    JSC::JSFunction* createCommonJSRequire(JSC::VM&, JSC::JSValue referrer);
+
     GlobalObject(JSC::VM& vm, JSC::Structure* structure);
 
     ~GlobalObject();
@@ -203,6 +235,9 @@ private:
 
     WTF::Deque<WTF::RefPtr<JSC::Microtask>> _microtasksQueue;
 
+    // While set, newly queued microtasks belong to a synchronous require() and are kept out of _microtasksQueue.
+    WTF::Deque<WTF::RefPtr<JSC::Microtask>>* _moduleLoaderMicrotasks;
+
     static void destroy(JSC::JSCell* cell) {
         static_cast<GlobalObject*>(cell)->~GlobalObject();
     }
@@ -221,6 +256,8 @@ private:
 
     static WTF::String defaultLanguage();
 
+    void cacheNativeConstructor(Class, ObjCConstructorBase*);
+
     JSC::Identifier _jsUncaughtErrorCallbackIdentifier;
     JSC::Identifier _jsUncaughtErrorCallbackIdentifierFallback;
     JSC::Identifier _jsDiscardedErrorCallbackIdentifier;
@@ -232,6 +269,8 @@ private:
     std::list<WTF::RetainPtr<CFRunLoopRef>> _microtaskRunLoops;
     WTF::RetainPtr<CFRunLoopSourceRef> _microtaskRunLoopSource;
     WTF::RetainPtr<CFRunLoopObserverRef> _runLoopBeforeWaitingObserver;
+    std::unique_ptr<JSTimers> _timers;
+    std::unique_ptr<JSFrameCallbacks> _frameCallbacks;
 
     JSC::WriteBarrier<FFICallPrototype> _ffiCallPrototype;
     JSC::WriteBarrier<JSC::Structure> _objCMethodWrapperStructure;
@@ -239,22 +278,22 @@ private:
     JSC::WriteBarrier<JSC::Structure> _objCBlockWrapperStructure;
     JSC::WriteBarrier<JSC::Structure> _ffiFunctionWrapperStructure;
 
-    JSC::WriteBarrier<JSC::Structure> _objCBlockCallbackStructure;
-    JSC::WriteBarrier<JSC::Structure> _objCMethodCallbackStructure;
-    JSC::WriteBarrier<JSC::Structure> _ffiFunctionCallbackStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _objCBlockCallbackStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _objCMethodCallbackStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _ffiFunctionCallbackStructure;
 
-    JSC::WriteBarrier<JSC::Structure> _recordFieldGetterStructure;
-    JSC::WriteBarrier<JSC::Structure> _recordFieldSetterStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _recordFieldGetterStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _recordFieldSetterStructure;
 
-    JSC::WriteBarrier<JSC::Structure> _fastEnumerationIteratorStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _fastEnumerationIteratorStructure;
 
     JSC::WriteBarrier<TypeFactory> _typeFactory;
 
     JSC::Identifier _interopIdentifier;
-    JSC::WriteBarrier<Interop> _interop;
+    JSC::LazyProperty<GlobalObject, Interop> _interop;
 
-    JSC::WriteBarrier<JSC::JSFunction> _typeScriptOriginalExtendsFunction;
-    JSC::WriteBarrier<JSC::JSFunction> _smartStringifyFunction;
+    JSC::LazyProperty<GlobalObject, JSC::JSFunction> _typeScriptOriginalExtendsFunction;
+    JSC::LazyProperty<GlobalObject, JSC::JSFunction> _smartStringifyFunction;
 
     JSC::WriteBarrier<JSC::Structure> _weakRefConstructorStructure;
     JSC::WriteBarrier<JSC::Structure> _weakRefPrototypeStructure;
@@ -264,17 +303,33 @@ private:
     JSC::WriteBarrier<JSC::Structure> _workerPrototypeStructure;
     JSC::WriteBarrier<JSC::Structure> _workerInstanceStructure;
 
-    JSC::WriteBarrier<JSC::Structure> _unmanagedInstanceStructure;
+    JSC::LazyProperty<GlobalObject, JSC::Structure> _unmanagedInstanceStructure;
 
     std::map<Class, JSC::Strong<ObjCConstructorBase>> _objCConstructors;
 
+    bool _weaklyHoldsClassConstructors;
+    JSC::WeakGCMap<Class, ObjCConstructorBase> _weakObjCConstructors;
+
     std::map<const Protocol*, JSC::Strong<ObjCProtocolWrapper>> _objCProtocolWrappers;
 
     WTF::Deque<std::map<std::string, std::unique_ptr<ReleasePoolBase>>> _releasePools;
 
     JSC::Identifier _commonJSModuleFunctionIdentifier;
+    JSC::Identifier _commonJSIdIdentifier;
+    JSC::Identifier _commonJSFilenameIdentifier;
+    JSC::Identifier _commonJSExportsIdentifier;
+    JSC::Identifier _commonJSRequireIdentifier;
+
+    // Structure shared by all per-module require functions, whose referrer is stored at _commonJSRequireReferrerOffset.
+    JSC::WriteBarrier<JSC::Structure> _commonJSRequireStructure;
+    JSC::PropertyOffset _commonJSRequireReferrerOffset;
+
+    const ModuleBundle* _moduleBundle;
 
     WTF::HashMap<WTF::String, WTF::String, WTF::ASCIICaseInsensitiveHash> _modulePathCache;
+
+    // referrer -> (specifier -> loaded module record)
+    WTF::HashMap<WTF::String, WTF::HashMap<WTF::String, JSC::Strong<JSC::JSModuleRecord>>> _requireCache;
 };
 } // namespace NativeScript
 
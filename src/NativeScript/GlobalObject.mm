@@ -13,6 +13,8 @@
 #include "FFIFunctionCallback.h"
 #include "Interop.h"
 #include "JSErrors.h"
+#include "JSFrameCallbacks.h"
+#include "JSTimers.h"
 #include "JSWeakRefConstructor.h"
 #include "JSWeakRefInstance.h"
 #include "JSWeakRefPrototype.h"
@@ -20,6 +22,7 @@
 #include "JSWorkerInstance.h"
 #include "JSWorkerPrototype.h"
 #include "Metadata.h"
+#include "ModuleBundle.h"
 #include "ObjCBlockCall.h"
 #include "ObjCBlockCallback.h"
 #include "ObjCConstructorCall.h"
@@ -47,7 +50,10 @@
 #include <JavaScriptCore/Completion.h>
 #include <JavaScriptCore/FunctionConstructor.h>
 #include <JavaScriptCore/FunctionPrototype.h>
+#include <JavaScriptCore/LazyPropertyInlines.h>
+#include <JavaScriptCore/LiteralParser.h>
 #include <JavaScriptCore/Microtask.h>
+#include <JavaScriptCore/ObjectConstructor.h>
 #include <JavaScriptCore/inspector/JSGlobalObjectConsoleClient.h>
 #include <JavaScriptCore/runtime/JSGlobalObjectFunctions.h>
 #include <JavaScriptCore/runtime/VMEntryScope.h>
@@ -106,7 +112,12 @@ const GlobalObjectMethodTable GlobalObject::globalObjectMethodTable = { &support
                                                                         nullptr /*promiseRejectionTracker*/, &defaultLanguage, nullptr /*compileStreaming*/, nullptr /*instantiateStreaming*/ };
 
 GlobalObject::GlobalObject(VM& vm, Structure* structure)
-    : JSGlobalObject(vm, structure, &GlobalObject::globalObjectMethodTable) {
+    : JSGlobalObject(vm, structure, &GlobalObject::globalObjectMethodTable)
+    , _moduleLoaderMicrotasks(nullptr)
+    , _weaklyHoldsClassConstructors(false)
+    , _weakObjCConstructors(vm)
+    , _commonJSRequireReferrerOffset(invalidOffset)
+    , _moduleBundle(nullptr) {
 }
 
 GlobalObject::~GlobalObject() {
@@ -189,17 +200,31 @@ void GlobalObject::finishCreation(VM& vm, WTF::String applicationPath) {
     this->putDirect(vm, vm.propertyNames->global, globalExec->globalThisValue(), static_cast<unsigned>(PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly));
 
     this->_applicationPath = applicationPath;
+    this->_moduleBundle = ModuleBundle::forApplicationPath(applicationPath);
 
     this->_ffiCallPrototype.set(vm, this, FFICallPrototype::create(vm, this, FFICallPrototype::createStructure(vm, this, this->functionPrototype())).get());
     this->_objCMethodWrapperStructure.set(vm, this, ObjCMethodWrapper::createStructure(vm, this, this->ffiCallPrototype()));
     this->_objCConstructorWrapperStructure.set(vm, this, ObjCConstructorWrapper::createStructure(vm, this, this->functionPrototype()));
     this->_objCBlockWrapperStructure.set(vm, this, ObjCBlockWrapper::createStructure(vm, this, this->ffiCallPrototype()));
     this->_ffiFunctionWrapperStructure.set(vm, this, CFunctionWrapper::createStructure(vm, this, this->ffiCallPrototype()));
-    this->_objCBlockCallbackStructure.set(vm, this, ObjCBlockCallback::createStructure(vm, this, jsNull()));
-    this->_objCMethodCallbackStructure.set(vm, this, ObjCMethodCallback::createStructure(vm, this, jsNull()));
-    this->_ffiFunctionCallbackStructure.set(vm, this, FFIFunctionCallback::createStructure(vm, this, jsNull()));
-    this->_recordFieldGetterStructure.set(vm, this, RecordProtoFieldGetter::createStructure(vm, this, this->functionPrototype()));
-    this->_recordFieldSetterStructure.set(vm, this, RecordProtoFieldSetter::createStructure(vm, this, this->functionPrototype()));
+
+    // What is set up with initLater is created when a script first uses the corresponding feature,
+    // which keeps global objects, especially those of short-lived workers, cheap to create.
+    this->_objCBlockCallbackStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        init.set(ObjCBlockCallback::createStructure(init.vm, init.owner, jsNull()));
+    });
+    this->_objCMethodCallbackStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        init.set(ObjCMethodCallback::createStructure(init.vm, init.owner, jsNull()));
+    });
+    this->_ffiFunctionCallbackStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        init.set(FFIFunctionCallback::createStructure(init.vm, init.owner, jsNull()));
+    });
+    this->_recordFieldGetterStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        init.set(RecordProtoFieldGetter::createStructure(init.vm, init.owner, init.owner->functionPrototype()));
+    });
+    this->_recordFieldSetterStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        init.set(RecordProtoFieldSetter::createStructure(init.vm, init.owner, init.owner->functionPrototype()));
+    });
 
     this->_typeFactory.set(vm, this, TypeFactory::create(vm, this, TypeFactory::createStructure(vm, this, jsNull())).get());
 
@@ -215,15 +240,21 @@ void GlobalObject::finishCreation(VM& vm, WTF::String applicationPath) {
     this->_workerInstanceStructure.set(vm, this, JSWorkerInstance::createStructure(vm, this, workerPrototype.get()));
     this->putDirect(vm, Identifier::fromString(&vm, "Worker"_s), JSWorkerConstructor::create(vm, this->workerConstructorStructure(), workerPrototype.get()).get());
 
-    auto fastEnumerationIteratorPrototype = ObjCFastEnumerationIteratorPrototype::create(vm, this, ObjCFastEnumerationIteratorPrototype::createStructure(vm, this, this->objectPrototype()));
-    this->_fastEnumerationIteratorStructure.set(vm, this, ObjCFastEnumerationIterator::createStructure(vm, this, fastEnumerationIteratorPrototype.get()));
+    this->_fastEnumerationIteratorStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        auto fastEnumerationIteratorPrototype = ObjCFastEnumerationIteratorPrototype::create(init.vm, init.owner, ObjCFastEnumerationIteratorPrototype::createStructure(init.vm, init.owner, init.owner->objectPrototype()));
+        init.set(ObjCFastEnumerationIterator::createStructure(init.vm, init.owner, fastEnumerationIteratorPrototype.get()));
+    });
 
-    JSC::Structure* unmanagedPrototypeStructure = UnmanagedPrototype::createStructure(vm, this, this->objectPrototype());
-    auto unmanagedPrototype = UnmanagedPrototype::create(vm, this, unmanagedPrototypeStructure);
-    this->_unmanagedInstanceStructure.set(vm, this, UnmanagedInstance::createStructure(this, unmanagedPrototype.get()));
+    this->_unmanagedInstanceStructure.initLater([](const LazyProperty<GlobalObject, Structure>::Initializer& init) {
+        JSC::Structure* unmanagedPrototypeStructure = UnmanagedPrototype::createStructure(init.vm, init.owner, init.owner->objectPrototype());
+        auto unmanagedPrototype = UnmanagedPrototype::create(init.vm, init.owner, unmanagedPrototypeStructure);
+        init.set(UnmanagedInstance::createStructure(init.owner, unmanagedPrototype.get()));
+    });
 
     this->_interopIdentifier = Identifier::fromString(&vm, Interop::info()->className);
-    this->_interop.set(vm, this, Interop::create(vm, this, Interop::createStructure(vm, this, this->objectPrototype())).get());
+    this->_interop.initLater([](const LazyProperty<GlobalObject, Interop>::Initializer& init) {
+        init.set(Interop::create(init.vm, init.owner, Interop::createStructure(init.vm, init.owner, init.owner->objectPrototype())).get());
+    });
 
     this->putDirectNativeFunction(vm, this, Identifier::fromString(globalExec, "__collect"), 0, &collectGarbage, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
 
@@ -231,14 +262,19 @@ void GlobalObject::finishCreation(VM& vm, WTF::String applicationPath) {
 
     this->putDirectNativeFunction(vm, this, Identifier::fromString(globalExec, "__releaseNativeCounterpart"), 1, &releaseNativeCounterpart, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
 
-    this->_smartStringifyFunction.set(vm, this, jsCast<JSFunction*>(evaluate(this->globalExec(), makeSource(WTF::String(smartStringify_js, smartStringify_js_len), SourceOrigin()), JSValue())));
+    this->_smartStringifyFunction.initLater([](const LazyProperty<GlobalObject, JSFunction>::Initializer& init) {
+        init.set(jsCast<JSFunction*>(evaluate(init.owner->globalExec(), makeSource(WTF::String(smartStringify_js, smartStringify_js_len), SourceOrigin()), JSValue())));
+    });
 
+    this->_typeScriptOriginalExtendsFunction.initLater([](const LazyProperty<GlobalObject, JSFunction>::Initializer& init) {
 #ifdef DEBUG
-    SourceCode sourceCode = makeSource(WTF::String(__extends_js, __extends_js_len), SourceOrigin(), "__extends.ts"_s);
+        SourceCode sourceCode = makeSource(WTF::String(__extends_js, __extends_js_len), SourceOrigin(), "__extends.ts"_s);
 #else
-    SourceCode sourceCode = makeSource(WTF::String(__extends_js, __extends_js_len), SourceOrigin());
+        SourceCode sourceCode = makeSource(WTF::String(__extends_js, __extends_js_len), SourceOrigin());
 #endif
-    this->_typeScriptOriginalExtendsFunction.set(vm, this, jsCast<JSFunction*>(evaluate(globalExec, sourceCode, globalExec->thisValue())));
+        ExecState* globalExec = init.owner->globalExec();
+        init.set(jsCast<JSFunction*>(evaluate(globalExec, sourceCode, globalExec->thisValue())));
+    });
     this->putDirectNativeFunction(vm, this, Identifier::fromString(globalExec, "__extends"), 2, ObjCTypeScriptExtendFunction, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly));
 
     ObjCConstructorNative* NSObjectConstructor = this->typeFactory()->NSObjectConstructor(this).get();
@@ -262,7 +298,24 @@ void GlobalObject::finishCreation(VM& vm, WTF::String applicationPath) {
     _microtaskRunLoopSource = WTF::adoptCF(CFRunLoopSourceCreate(kCFAllocatorDefault, 0, &context));
     _runLoopBeforeWaitingObserver = WTF::adoptCF(CFRunLoopObserverCreate(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, YES, 0, &runLoopBeforeWaitingPerformWork, &observerContext));
 
+    _timers = std::make_unique<JSTimers>(this);
+    this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "__setTimeout"_s), 2, &JSTimers::setTimeout, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
+    this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "__setInterval"_s), 2, &JSTimers::setInterval, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
+    this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "__clearTimeout"_s), 1, &JSTimers::clearTimer, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
+    this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "__clearInterval"_s), 1, &JSTimers::clearTimer, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
+
+    _frameCallbacks = std::make_unique<JSFrameCallbacks>(this);
+    this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "__requestAnimationFrame"_s), 1, &JSFrameCallbacks::requestAnimationFrame, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
+    this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "__cancelAnimationFrame"_s), 1, &JSFrameCallbacks::cancelAnimationFrame, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum));
+
     _commonJSModuleFunctionIdentifier = Identifier::fromString(&vm, "CommonJSModuleFunction");
+    _commonJSIdIdentifier = Identifier::fromString(&vm, "id");
+    _commonJSFilenameIdentifier = Identifier::fromString(&vm, "filename");
+    _commonJSExportsIdentifier = Identifier::fromString(&vm, "exports");
+    _commonJSRequireIdentifier = Identifier::fromString(&vm, "require");
+    JSFunction* commonJSRequireTemplate = this->createCommonJSRequire(vm, jsUndefined());
+    _commonJSRequireStructure.set(vm, this, commonJSRequireTemplate->structure(vm));
+    _commonJSRequireReferrerOffset = commonJSRequireTemplate->getDirectOffset(vm, vm.propertyNames->sourceURL);
     this->putDirectNativeFunction(vm, this, Identifier::fromString(&vm, "require"), 1, commonJSRequire, NoIntrinsic, static_cast<unsigned>(PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly));
 
     this->putDirect(vm, Identifier::fromString(&vm, "__runtimeVersion"), jsString(&vm, STRINGIZE_VALUE_OF(NATIVESCRIPT_VERSION)), static_cast<unsigned>(PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly));
@@ -280,29 +333,72 @@ void GlobalObject::visitChildren(JSCell* cell, SlotVisitor& visitor) {
     GlobalObject* globalObject = jsCast<GlobalObject*>(cell);
     Base::visitChildren(globalObject, visitor);
 
-    visitor.append(globalObject->_interop);
+    globalObject->_interop.visit(visitor);
     visitor.append(globalObject->_typeFactory);
-    visitor.append(globalObject->_typeScriptOriginalExtendsFunction);
-    visitor.append(globalObject->_smartStringifyFunction);
+    globalObject->_typeScriptOriginalExtendsFunction.visit(visitor);
+    globalObject->_smartStringifyFunction.visit(visitor);
     visitor.append(globalObject->_ffiCallPrototype);
     visitor.append(globalObject->_objCMethodWrapperStructure);
     visitor.append(globalObject->_objCConstructorWrapperStructure);
     visitor.append(globalObject->_objCBlockWrapperStructure);
     visitor.append(globalObject->_ffiFunctionWrapperStructure);
-    visitor.append(globalObject->_objCBlockCallbackStructure);
-    visitor.append(globalObject->_objCMethodCallbackStructure);
-    visitor.append(globalObject->_ffiFunctionCallbackStructure);
-    visitor.append(globalObject->_recordFieldGetterStructure);
-    visitor.append(globalObject->_recordFieldSetterStructure);
-    visitor.append(globalObject->_unmanagedInstanceStructure);
+    globalObject->_objCBlockCallbackStructure.visit(visitor);
+    globalObject->_objCMethodCallbackStructure.visit(visitor);
+    globalObject->_ffiFunctionCallbackStructure.visit(visitor);
+    globalObject->_recordFieldGetterStructure.visit(visitor);
+    globalObject->_recordFieldSetterStructure.visit(visitor);
+    globalObject->_unmanagedInstanceStructure.visit(visitor);
     visitor.append(globalObject->_weakRefConstructorStructure);
     visitor.append(globalObject->_weakRefPrototypeStructure);
     visitor.append(globalObject->_weakRefInstanceStructure);
     visitor.append(globalObject->_workerConstructorStructure);
     visitor.append(globalObject->_workerInstanceStructure);
     visitor.append(globalObject->_workerPrototypeStructure);
-    visitor.append(globalObject->_fastEnumerationIteratorStructure);
+    globalObject->_fastEnumerationIteratorStructure.visit(visitor);
+    visitor.append(globalObject->_commonJSRequireStructure);
+}
+
+// The metadata generator emits enums as `__tsEnum({"name":value,...})`. Their argument is valid JSON, so
+// the enum object is built from it directly, without parsing and compiling a program for every enum.
+// `__tsEnum` is a non-configurable global (see inlineFunctions.js), so this is observably the same.
+static JSValue createEnumFromJsCode(ExecState* execState, const char* source) {
+    static const char prefix[] = "__tsEnum(";
+    static const size_t prefixLength = sizeof(prefix) - 1;
+
+    size_t length = strlen(source);
+    if (length < prefixLength + 1 || strncmp(source, prefix, prefixLength) != 0 || source[length - 1] != ')') {
+        return JSValue();
+    }
+
+    VM& vm = execState->vm();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    LiteralParser<LChar> parser(execState, reinterpret_cast<const LChar*>(source + prefixLength), length - prefixLength - 1, StrictJSON);
+    JSValue members = parser.tryLiteralParse();
+    if (!members || !members.isObject()) {
+        scope.clearException();
+        return JSValue();
+    }
+
+    JSObject* membersObject = asObject(members);
+    PropertyNameArray names(&vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
+    membersObject->methodTable(vm)->getOwnPropertyNames(membersObject, execState, names, EnumerationMode());
+
+    JSObject* result = constructEmptyObject(execState);
+    for (const Identifier& name : names) {
+        JSValue value = membersObject->get(execState, name);
+        result->putDirectMayBeIndex(execState, name, value);
+        result->putDirectMayBeIndex(execState, value.toPropertyKey(execState), jsString(&vm, name.string()));
+    }
+
+    if (UNLIKELY(scope.exception())) {
+        scope.clearException();
+        return JSValue();
+    }
+
+    return result;
 }
+
 /// This method is called whenever a property on the global JavaScript object is accessed for the first time.
 /// It is called once for each property and cached by JSC, i.e. it is never called again for the same property.
 bool GlobalObject::getOwnPropertySlot(JSObject* object, ExecState* execState, PropertyName propertyName, PropertySlot& propertySlot) {
@@ -328,6 +424,7 @@ bool GlobalObject::getOwnPropertySlot(JSObject* object, ExecState* execState, Pr
 
     Strong<JSCell> strongSymbolWrapper;
     JSValue symbolWrapper;
+    bool cacheOnGlobalObject = true;
 
     switch (symbolMeta->type()) {
     case Interface: {
@@ -340,7 +437,8 @@ bool GlobalObject::getOwnPropertySlot(JSObject* object, ExecState* execState, Pr
         if (klass) {
             auto constructor = globalObject->_typeFactory.get()->getObjCNativeConstructor(globalObject, symbolMeta->jsName());
             strongSymbolWrapper = constructor;
-            globalObject->_objCConstructors.insert({ klass, constructor });
+            globalObject->cacheNativeConstructor(klass, constructor.get());
+            cacheOnGlobalObject = !globalObject->_weaklyHoldsClassConstructors;
         }
         break;
     }
@@ -397,8 +495,11 @@ bool GlobalObject::getOwnPropertySlot(JSObject* object, ExecState* execState, Pr
         break;
     }
     case JsCode: {
-        WTF::String source = WTF::String(static_cast<const JsCodeMeta*>(symbolMeta)->jsCode());
-        symbolWrapper = evaluate(execState, makeSource(source, SourceOrigin()));
+        const char* jsCode = static_cast<const JsCodeMeta*>(symbolMeta)->jsCode();
+        symbolWrapper = createEnumFromJsCode(execState, jsCode);
+        if (!symbolWrapper) {
+            symbolWrapper = evaluate(execState, makeSource(WTF::String(jsCode), SourceOrigin()));
+        }
         break;
     }
     default: {
@@ -421,7 +522,9 @@ bool GlobalObject::getOwnPropertySlot(JSObject* object, ExecState* execState, Pr
         return true;
     }
 
-    object->putDirectWithoutTransition(vm, propertyName, symbolWrapper);
+    if (cacheOnGlobalObject) {
+        object->putDirectWithoutTransition(vm, propertyName, symbolWrapper);
+    }
     propertySlot.setValue(object, static_cast<unsigned>(PropertyAttribute::None), symbolWrapper);
     return true;
 }
@@ -457,6 +560,10 @@ Strong<ObjCConstructorBase> GlobalObject::constructorFor(Class klass, Class fall
         return kvp->second;
     }
 
+    if (ObjCConstructorBase* constructor = this->_weakObjCConstructors.get(klass)) {
+        return Strong<ObjCConstructorBase>(this->vm(), constructor);
+    }
+
     const Meta* meta = MetaFile::instance()->globalTable()->findMeta(class_getName(klass));
     if(!searchBaseClasses && meta == nullptr) {
         return Strong<ObjCConstructorBase>();
@@ -476,10 +583,86 @@ Strong<ObjCConstructorBase> GlobalObject::constructorFor(Class klass, Class fall
         return kvp->second;
     }
 
+    if (ObjCConstructorBase* constructor = this->_weakObjCConstructors.get(klass)) {
+        return Strong<ObjCConstructorBase>(this->vm(), constructor);
+    }
+
     auto constructor = this->_typeFactory.get()->getObjCNativeConstructor(this, meta->jsName());
-    this->_objCConstructors.insert({ klass, constructor });
-    this->putDirect(this->vm(), Identifier::fromString(this->globalExec(), class_getName(klass)), constructor.get());
-    return constructor;
+    this->cacheNativeConstructor(klass, constructor.get());
+    if (!this->_weaklyHoldsClassConstructors) {
+        this->putDirect(this->vm(), Identifier::fromString(this->globalExec(), class_getName(klass)), constructor.get());
+    }
+    return Strong<ObjCConstructorBase>(this->vm(), constructor.get());
+}
+
+void GlobalObject::cacheNativeConstructor(Class klass, ObjCConstructorBase* constructor) {
+    if (this->_weaklyHoldsClassConstructors) {
+        this->_weakObjCConstructors.set(klass, constructor);
+    } else {
+        this->_objCConstructors.insert({ klass, Strong<ObjCConstructorBase>(this->vm(), constructor) });
+    }
+}
+
+static size_t estimatedCellSize(JSCell* cell) {
+    return cell ? cell->estimatedSizeInBytes() : 0;
+}
+
+static size_t estimatedObjectSize(VM& vm, JSObject* object, JSCell* owner) {
+    if (!object) {
+        return 0;
+    }
+
+    Structure* structure = object->structure(vm);
+    size_t size = estimatedCellSize(object) + estimatedCellSize(structure);
+
+    // Method wrappers and property accessors are materialized lazily as direct properties
+    structure->forEachProperty(vm, [&](const PropertyMapEntry& entry) -> bool {
+        JSValue value = object->getDirect(entry.offset);
+        if (!value.isCell() || value.asCell() == owner) {
+            return true;
+        }
+
+        size += estimatedCellSize(value.asCell());
+        if (GetterSetter* accessor = jsDynamicCast<GetterSetter*>(vm, value)) {
+            size += estimatedCellSize(accessor->getter()) + estimatedCellSize(accessor->setter());
+        }
+        return true;
+    });
+
+    return size;
+}
+
+static size_t estimatedConstructorSize(VM& vm, ObjCConstructorBase* constructor) {
+    ObjCPrototype* prototype = constructor->getObjCPrototype();
+    if (prototype && prototype->klass() != constructor->klass()) {
+        // Derived classes reach the prototype of their native base, which is accounted for there
+        prototype = nullptr;
+    }
+
+    size_t size = estimatedObjectSize(vm, constructor, prototype) + estimatedObjectSize(vm, prototype, constructor) + estimatedCellSize(constructor->instancesStructure());
+
+    if (ObjCConstructorNative* nativeConstructor = jsDynamicCast<ObjCConstructorNative*>(vm, constructor)) {
+        size += estimatedCellSize(nativeConstructor->allocatedPlaceholderStructure());
+    }
+
+    return size;
+}
+
+std::map<Class, size_t> GlobalObject::interopHeapUsage() {
+    VM& vm = this->vm();
+    std::map<Class, size_t> usage;
+
+    for (auto& entry : this->_objCConstructors) {
+        usage[entry.first] = estimatedConstructorSize(vm, entry.second.get());
+    }
+
+    for (auto& entry : this->_weakObjCConstructors) {
+        if (ObjCConstructorBase* constructor = entry.value.get()) {
+            usage[entry.key] = estimatedConstructorSize(vm, constructor);
+        }
+    }
+
+    return usage;
 }
 
 Strong<ObjCProtocolWrapper> GlobalObject::protocolWrapperFor(Protocol* aProtocol) {
@@ -579,6 +762,12 @@ bool GlobalObject::isUIApplicationMainAtTopOfCallstack() {
 
 void GlobalObject::queueTaskToEventLoop(JSGlobalObject& globalObject, WTF::Ref<Microtask>&& task) {
     auto self = static_cast<GlobalObject*>(&globalObject);
+    if (self->_moduleLoaderMicrotasks) {
+        // A require() call is driving the module loader, its jobs are run synchronously by the caller.
+        self->_moduleLoaderMicrotasks->append(WTFMove(task));
+        return;
+    }
+
     self->_microtasksQueue.append(WTFMove(task));
     CFRunLoopSourceSignal(self->_microtaskRunLoopSource.get());
     for (auto runLoop : self->microtaskRunLoops()) {
@@ -10,6 +10,8 @@
 #include "Interop.h"
 #include "LiveEdit/EditableSourceProvider.h"
 #include "ManualInstrumentation.h"
+#include "ModuleBundle.h"
+#include "ModulePathResolver.h"
 #include "ObjCTypes.h"
 #include "TNSRuntime.h"
 #include <JavaScriptCore/BuiltinNames.h>
@@ -20,6 +22,7 @@
 #include <JavaScriptCore/JSArrayBuffer.h>
 #include <JavaScriptCore/JSInternalPromise.h>
 #include <JavaScriptCore/JSInternalPromiseDeferred.h>
+#include <JavaScriptCore/JSMap.h>
 #include <JavaScriptCore/JSModuleLoader.h>
 #include <JavaScriptCore/JSModuleRecord.h>
 #include <JavaScriptCore/JSNativeStdFunction.h>
@@ -35,6 +38,8 @@
 #include <JavaScriptCore/parser/Parser.h>
 #include <JavaScriptCore/tools/CodeProfiling.h>
 #include <sys/stat.h>
+#include <wtf/SetForScope.h>
+#include <wtf/text/ASCIIFastPath.h>
 
 static UChar pathSeparator() {
 #if OS(WINDOWS)
@@ -114,105 +119,29 @@ static String resolvePath(const DirectoryName& directoryName, const ModuleName&
 namespace NativeScript {
 using namespace JSC;
 
-template <mode_t mode>
-static mode_t stat(NSString* path) {
-    struct stat statbuf;
-    if (stat(path.fileSystemRepresentation, &statbuf) == 0) {
-        return (statbuf.st_mode & S_IFMT) & mode;
-    }
-
-    return 0;
-}
-
-static NSString* resolveAbsolutePath(NSString* absolutePath, WTF::HashMap<WTF::String, WTF::String, WTF::ASCIICaseInsensitiveHash>& cache, NSError** error) {
-    if (cache.contains(absolutePath)) {
-        return cache.get(absolutePath);
-    }
-    // LOAD_AS_FILE(X)
-    // 1. If X is a file, load X as JavaScript text.  STOP
-    // 2. If X.js is a file, load X.js as JavaScript text.  STOP
-    // 3. If X.json is a file, parse X.json to a JavaScript Object.  STOP
-
-    mode_t absolutePathStat = stat<S_IFDIR | S_IFREG>(absolutePath);
-    if (absolutePathStat & S_IFREG) {
-        cache.set(absolutePath, absolutePath);
-        return absolutePath;
-    }
-
-    NSString* candidatePath = [absolutePath stringByAppendingPathExtension:@"js"];
-    if (stat<S_IFREG>(candidatePath)) {
-        cache.set(absolutePath, candidatePath);
-        return candidatePath;
-    }
-
-    candidatePath = [absolutePath stringByAppendingPathExtension:@"json"];
-    if (stat<S_IFREG>(candidatePath)) {
-        cache.set(absolutePath, candidatePath);
-        return candidatePath;
-    }
-
-    if (absolutePathStat & S_IFDIR) {
-        //LOAD_AS_DIRECTORY(X)
-        // 1. If X/package.json is a file,
-        //    a. Parse X/package.json, and look for "main" field.
-        //    b. let M = X + (json main field)
-        //    c. LOAD_AS_FILE(M)
-        //    d. LOAD_INDEX(M)
-        // 2. LOAD_INDEX(X)
-
-        // LOAD_INDEX(X)
-        // 1. If X/index.js is a file, load X/index.js as JavaScript text.  STOP
-        // 2. If X/index.json is a file, parse X/index.json to a JavaScript object. STOP
-
-        // pass index to LOAD_AS_FILE if no package.json is found to cover both .js and .json cases
-        // (as a side effect there'll be an additional case 0. If X/index is a file, load it as JS text
-        // which is not present in the specification but shouldn't do any harm)
-        NSString* mainName = @"index";
-        NSString* packageJsonPath = [absolutePath stringByAppendingPathComponent:@"package.json"];
-        if (stat<S_IFREG>(packageJsonPath)) {
-            NSData* packageJsonData = [NSData dataWithContentsOfFile:packageJsonPath options:0 error:error];
-            if (!packageJsonData && error) {
-                return nil;
-            }
-
-            NSDictionary* packageJson = [NSJSONSerialization JSONObjectWithData:packageJsonData options:0 error:error];
-            if (!packageJson && error) {
-                return nil;
-            }
-
-            if (NSString* packageMain = [packageJson objectForKey:@"main"]) {
-                mainName = packageMain;
-            }
+// package.json files are parsed with NSJSONSerialization
+static PackageMainReader packageMainReader(const ModuleBundle* bundle, NSError** error) {
+    return [bundle, error](const WTF::String& packageJsonPath, WTF::String& main) {
+        const char* bundledPackageJson;
+        size_t bundledPackageJsonLength;
+        NSData* packageJsonData = bundle && bundle->contents(packageJsonPath, bundledPackageJson, bundledPackageJsonLength)
+                                      ? [NSData dataWithBytesNoCopy:const_cast<char*>(bundledPackageJson) length:bundledPackageJsonLength freeWhenDone:NO]
+                                      : [NSData dataWithContentsOfFile:packageJsonPath options:0 error:error];
+        if (!packageJsonData) {
+            return false;
         }
 
-        NSString* resolved = resolveAbsolutePath([[absolutePath stringByAppendingPathComponent:mainName] stringByStandardizingPath], cache, error);
-        if (*error) {
-            return nil;
+        NSDictionary* packageJson = [NSJSONSerialization JSONObjectWithData:packageJsonData options:0 error:error];
+        if (!packageJson) {
+            return false;
         }
 
-        cache.set(absolutePath, resolved);
-        return resolved;
-    }
-
-    return nil;
-}
-
-NSString* normalizePath(NSString* path) {
-    NSArray<NSString*>* pathComponents = [path componentsSeparatedByString:@"/"];
-    NSMutableArray* stack = [[NSMutableArray alloc] initWithCapacity:pathComponents.count];
-    for (NSString* pathComponent in pathComponents) {
-        if ([pathComponent isEqualToString:@".."]) {
-            [stack removeLastObject];
-        } else if (![pathComponent isEqualToString:@"."] && ![pathComponent isEqualToString:@""]) {
-            [stack addObject:pathComponent];
+        if (NSString* packageMain = [packageJson objectForKey:@"main"]) {
+            main = packageMain;
         }
-    }
-    NSString* result = [stack componentsJoinedByString:@"/"];
-    if ([path hasPrefix:@"/"]) {
-        result = [@"/" stringByAppendingString:result];
-    }
-    [stack release];
-    return result;
+
+        return true;
+    };
 }
 
 Identifier GlobalObject::moduleLoaderResolve(JSGlobalObject* globalObject, ExecState* execState, JSModuleLoader* loader, JSValue keyValue, JSValue referrerValue, JSValue initiator) {
@@ -225,86 +154,31 @@ Identifier GlobalObject::moduleLoaderResolve(JSGlobalObject* globalObject, ExecS
     JSC::VM& vm = execState->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
 
-    NSString* path = keyValue.toWTFString(execState);
+    WTF::String path = keyValue.toWTFString(execState);
     RETURN_IF_EXCEPTION(scope, {});
 
     GlobalObject* self = jsCast<GlobalObject*>(globalObject);
-
-    NSString* absolutePath = path;
-    unichar pathChar = [path characterAtIndex:0];
-
-    bool isModuleRequire = false;
-
-    if (pathChar != '/') {
-        if (pathChar == '.') {
-            if (referrerValue.isString()) {
-                absolutePath = [static_cast<NSString*>(referrerValue.toWTFString(execState)) stringByDeletingLastPathComponent];
-            } else {
-                absolutePath = [static_cast<NSString*>(self->applicationPath()) stringByAppendingPathComponent:@"app"];
-            }
-        } else if (pathChar == '~') {
-            absolutePath = [static_cast<NSString*>(self->applicationPath()) stringByAppendingPathComponent:@"app"];
-            path = [path substringFromIndex:2];
-        } else {
-            absolutePath = [static_cast<NSString*>(self->applicationPath()) stringByAppendingPathComponent:@"app/tns_modules/tns-core-modules"];
-            isModuleRequire = true;
-        }
-        absolutePath = [normalizePath([absolutePath stringByAppendingPathComponent:path]) stringByStandardizingPath];
-    }
+    WTF::String referrer = referrerValue.isString() ? referrerValue.toWTFString(execState) : WTF::String();
 
     NSError* error = nil;
-    NSString* absoluteFilePath = resolveAbsolutePath(absolutePath, self->modulePathCache(), &error);
-    if (error) {
-        throwException(execState, scope, self->interop()->wrapError(execState, error));
-    }
-
-    // From https://nodejs.org/api/modules.html:
-    //    require(X) from module at path Y
-    //    1. If X is a core module,
-    //        a. return the core module
-    //        b. STOP
-    //    2. If X begins with '/'
-    //        a. set Y to be the filesystem root
-    //    3. If X begins with './' or '/' or '../'
-    //        a. LOAD_AS_FILE(Y + X)
-    //        b. LOAD_AS_DIRECTORY(Y + X)
-    //    4. LOAD_NODE_MODULES(X, dirname(Y))
-    //    5. THROW "not found"
-    if (isModuleRequire) {
-        if (!absoluteFilePath) {
-            NSString* currentSearchPath = [static_cast<NSString*>(referrerValue.toWTFString(execState)) stringByDeletingLastPathComponent];
-            do {
-                NSString* currentNodeModulesPath = [[currentSearchPath stringByAppendingPathComponent:@"node_modules"] stringByStandardizingPath];
-                if (stat<S_IFDIR>(currentNodeModulesPath)) {
-                    absoluteFilePath = resolveAbsolutePath([currentNodeModulesPath stringByAppendingPathComponent:path], self -> modulePathCache(), &error);
-                    if (error) {
-                        throwException(execState, scope, self->interop()->wrapError(execState, error));
-                    }
-
-                    if (absoluteFilePath) {
-                        break;
-                    }
-                }
-                currentSearchPath = [currentSearchPath stringByDeletingLastPathComponent];
-            } while (currentSearchPath.length > self->applicationPath().length());
-        }
-
-        if (!absoluteFilePath) {
-            absolutePath = [[[static_cast<NSString*>(self->applicationPath()) stringByAppendingPathComponent:@"app/tns_modules"] stringByAppendingPathComponent:path] stringByStandardizingPath];
-            absoluteFilePath = resolveAbsolutePath(absolutePath, self->modulePathCache(), &error);
-            if (error) {
-                throwException(execState, scope, self->interop()->wrapError(execState, error));
-            }
+    WTF::String absoluteFilePath;
+    WTF::String absolutePath;
+    if (!resolveModuleSpecifier(self->moduleBundle(), self->applicationPath(), path, referrer, self->modulePathCache(), packageMainReader(self->moduleBundle(), &error), absoluteFilePath, absolutePath)) {
+        if (error) {
+            throwException(execState, scope, self->interop()->wrapError(execState, error));
+        } else {
+            throwException(execState, scope, createError(execState, makeString("Could not read a package.json while resolving module '", path, "'.")));
         }
+        return Identifier();
     }
 
-    if (!absoluteFilePath) {
-        WTF::String errorMessage = WTF::String::format("Could not find module '%s'. Computed path '%s'.", keyValue.toWTFString(execState).utf8().data(), absolutePath.UTF8String);
+    if (absoluteFilePath.isNull()) {
+        WTF::String errorMessage = WTF::String::format("Could not find module '%s'. Computed path '%s'.", path.utf8().data(), absolutePath.utf8().data());
         throwException(execState, scope, createError(execState, errorMessage));
         return Identifier();
     }
 
-    return Identifier::fromString(&vm, String(absoluteFilePath));
+    return Identifier::fromString(&vm, absoluteFilePath);
 }
 
 JSInternalPromise* GlobalObject::moduleLoaderFetch(JSGlobalObject* globalObject, ExecState* execState, JSModuleLoader* loader, JSValue keyValue, JSC::JSValue parameters, JSValue initiator) {
@@ -321,14 +195,27 @@ JSInternalPromise* GlobalObject::moduleLoaderFetch(JSGlobalObject* globalObject,
 
     GlobalObject* self = jsCast<GlobalObject*>(globalObject);
 
-    NSError* error = nil;
-    NSData* moduleContent = [NSData dataWithContentsOfFile:modulePath options:NSDataReadingMappedIfSafe error:&error];
-    if (error) {
-        return deferred->reject(execState, self->interop()->wrapError(execState, error));
+    String moduleContentStr;
+    const char* bundledContent;
+    size_t contentLength;
+    if (self->moduleBundle() && self->moduleBundle()->contents(modulePath, bundledContent, contentLength)) {
+        // The bundle stays mapped for the lifetime of the process, so ASCII sources are used in place.
+        const LChar* characters = reinterpret_cast<const LChar*>(bundledContent);
+        moduleContentStr = charactersAreAllASCII(characters, contentLength)
+                               ? String(StringImpl::createWithoutCopying(characters, contentLength))
+                               : String::fromUTF8(characters, contentLength);
+    } else {
+        NSError* error = nil;
+        NSData* moduleContent = [NSData dataWithContentsOfFile:modulePath options:NSDataReadingMappedIfSafe error:&error];
+        if (error) {
+            return deferred->reject(execState, self->interop()->wrapError(execState, error));
+        }
+
+        contentLength = moduleContent.length;
+        moduleContentStr = WTF::String::fromUTF8((const LChar*)moduleContent.bytes, contentLength);
     }
 
-    String moduleContentStr = WTF::String::fromUTF8((const LChar*)moduleContent.bytes, moduleContent.length);
-    if (moduleContentStr.isNull() && moduleContent.length > 0) {
+    if (moduleContentStr.isNull() && contentLength > 0) {
         return deferred->reject(execState, createTypeError(execState, WTF::String::format("Only UTF-8 character encoding is supported: %s", keyValue.toWTFString(execState).utf8().data())));
     }
 
@@ -357,6 +244,36 @@ JSObject* GlobalObject::moduleLoaderCreateImportMetaProperties(JSGlobalObject* g
     return metaProperties;
 }
 
+JSFunction* GlobalObject::createCommonJSRequire(VM& vm, JSValue referrer) {
+    JSFunction* require = JSFunction::create(vm, this, 1, "require"_s, commonJSRequire);
+    require->putDirect(vm, vm.propertyNames->sourceURL, referrer, PropertyAttribute::ReadOnly | PropertyAttribute::DontDelete | PropertyAttribute::DontEnum);
+    return require;
+}
+
+static JSValue moduleRecordExports(ExecState* execState, GlobalObject* globalObject, JSModuleRecord* record) {
+    // maybe the require'd module is a CommonJS module?
+    if (JSValue moduleFunction = record->getDirect(execState->vm(), globalObject->commonJSModuleFunctionIdentifier())) {
+        JSValue module = moduleFunction.get(execState, execState->vm().propertyNames->builtinNames().moduleEvaluationPrivateName());
+        return module.get(execState, globalObject->_commonJSExportsIdentifier);
+    }
+
+    JSModuleRecord::Resolution resolution = record->resolveExport(execState, execState->vm().propertyNames->defaultKeyword);
+    if (resolution.type == JSModuleRecord::Resolution::Type::Resolved) {
+        JSValue defaultExport = record->moduleEnvironment()->get(execState, resolution.localName);
+        ASSERT(!defaultExport.isEmpty());
+        return defaultExport;
+    }
+
+    return jsUndefined();
+}
+
+static bool isModuleRegistered(ExecState* execState, GlobalObject* globalObject, const String& moduleKey) {
+    VM& vm = execState->vm();
+    JSValue registry = globalObject->moduleLoader()->get(execState, Identifier::fromString(&vm, "registry"));
+    JSMap* registryMap = jsDynamicCast<JSMap*>(vm, registry);
+    return registryMap && registryMap->has(execState, jsString(execState, moduleKey));
+}
+
 EncodedJSValue JSC_HOST_CALL GlobalObject::commonJSRequire(ExecState* execState) {
     tns::instrumentation::Frame frame;
     JSC::VM& vm = execState->vm();
@@ -366,20 +283,49 @@ EncodedJSValue JSC_HOST_CALL GlobalObject::commonJSRequire(ExecState* execState)
         return JSValue::encode(throwTypeError(execState, scope, "Expected module identifier to be a string."_s));
     }
 
-    JSValue callee = execState->callee().asCell();
-    JSValue refererKey = callee.get(execState, vm.propertyNames->sourceURL);
-
     GlobalObject* globalObject = jsCast<GlobalObject*>(execState->lexicalGlobalObject());
+
+    JSObject* callee = execState->jsCallee();
+    JSValue refererKey = callee->structure(vm) == globalObject->_commonJSRequireStructure.get()
+                             ? callee->getDirect(globalObject->_commonJSRequireReferrerOffset)
+                             : callee->get(execState, vm.propertyNames->sourceURL);
+
+    // Modules which have already been loaded from this referrer are served directly from their record,
+    // skipping resolution and the module loader's promise pipeline altogether.
+    WTF::String referrer = refererKey.isString() ? refererKey.toWTFString(execState) : emptyString();
+    WTF::String specifier = moduleName.toWTFString(execState);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+
+    auto referrerCache = globalObject->_requireCache.find(referrer);
+    if (referrerCache != globalObject->_requireCache.end()) {
+        auto cachedRecord = referrerCache->value.find(specifier);
+        if (cachedRecord != referrerCache->value.end()) {
+            return JSValue::encode(moduleRecordExports(execState, globalObject, cachedRecord->value.get()));
+        }
+    }
+
+    // Settle the module loader's promises on a private queue so that pending application microtasks
+    // are not run from inside require(). Module bodies switch back to the application queue while they run.
+    WTF::Deque<WTF::RefPtr<Microtask>> moduleLoaderMicrotasks;
+    SetForScope<WTF::Deque<WTF::RefPtr<Microtask>>*> moduleLoaderMicrotasksScope(globalObject->_moduleLoaderMicrotasks, &moduleLoaderMicrotasks);
+
     JSInternalPromise* promise = globalObject->moduleLoader()->resolve(execState, moduleName, refererKey, refererKey);
 
-    JSValue error;
-    JSFunction* errorHandler = JSNativeStdFunction::create(execState->vm(), globalObject, 1, String(), [&error](ExecState* execState) {
-        error = execState->argument(0);
+    // A load which waits on another one's steps settles after require() has returned, so the
+    // continuations must not refer to its frame.
+    struct RequireResult {
+        JSModuleRecord* record = nullptr;
+        JSValue error;
+        String moduleKey;
+    };
+    auto result = std::make_shared<RequireResult>();
+
+    JSFunction* errorHandler = JSNativeStdFunction::create(execState->vm(), globalObject, 1, String(), [result](ExecState* execState) {
+        result->error = execState->argument(0);
         return JSValue::encode(jsUndefined());
     });
 
-    JSModuleRecord* record = nullptr;
-    promise->then(execState, JSNativeStdFunction::create(execState->vm(), globalObject, 1, String(), [&record, errorHandler, frame](ExecState* execState) {
+    promise->then(execState, JSNativeStdFunction::create(execState->vm(), globalObject, 1, String(), [result, errorHandler, frame](ExecState* execState) {
                       JSValue moduleLoader = execState->lexicalGlobalObject()->moduleLoader();
                       JSObject* function = jsCast<JSObject*>(moduleLoader.get(execState, execState->vm().propertyNames->builtinNames().loadAndEvaluateModulePublicName()));
                       CallData callData;
@@ -391,7 +337,8 @@ EncodedJSValue JSC_HOST_CALL GlobalObject::commonJSRequire(ExecState* execState)
                       // and is eligible for garbage collection as soon as it returns.
                       JSValue moduleKeyJs = execState->argument(0);
                       String moduleKey = moduleKeyJs.toWTFString(execState);
-                      promise = promise->then(execState, JSNativeStdFunction::create(execState->vm(), execState->lexicalGlobalObject(), 1, String(), [moduleKey, &record, frame](ExecState* execState) {
+                      result->moduleKey = moduleKey;
+                      promise = promise->then(execState, JSNativeStdFunction::create(execState->vm(), execState->lexicalGlobalObject(), 1, String(), [moduleKey, result, frame](ExecState* execState) {
                                                   JSValue moduleLoader = execState->lexicalGlobalObject()->moduleLoader();
                                                   JSObject* function = jsCast<JSObject*>(moduleLoader.get(execState, execState->vm().propertyNames->builtinNames().ensureRegisteredPublicName()));
 
@@ -401,7 +348,7 @@ EncodedJSValue JSC_HOST_CALL GlobalObject::commonJSRequire(ExecState* execState)
                                                   MarkedArgumentBuffer args;
                                                   args.append(JSValue(jsString(execState, moduleKey)));
                                                   JSValue entry = JSC::call(execState, function, callType, callData, moduleLoader, args);
-                                                  record = jsCast<JSModuleRecord*>(entry.get(execState, Identifier::fromString(execState, "module")));
+                                                  result->record = jsCast<JSModuleRecord*>(entry.get(execState, Identifier::fromString(execState, "module")));
 
                                                   if (frame.check()) {
                                                       NSString* moduleName = (NSString*)moduleKey.createCFString().get();
@@ -419,26 +366,33 @@ EncodedJSValue JSC_HOST_CALL GlobalObject::commonJSRequire(ExecState* execState)
                       return JSValue::encode(promise);
                   }),
                   errorHandler);
-    globalObject->drainMicrotasks();
+    while (!moduleLoaderMicrotasks.isEmpty()) {
+        moduleLoaderMicrotasks.takeFirst()->run(globalObject->globalExec());
+    }
 
+    JSValue error = result->error;
     if (!error.isUndefinedOrNull() && error.isCell() && error.asCell() != nullptr) {
         return JSValue::encode(scope.throwException(execState, error));
     }
 
-    // maybe the require'd module is a CommonJS module?
-    if (JSValue moduleFunction = record->getDirect(execState->vm(), globalObject->_commonJSModuleFunctionIdentifier)) {
-        JSValue module = moduleFunction.get(execState, execState->vm().propertyNames->builtinNames().moduleEvaluationPrivateName());
-        return JSValue::encode(module.get(execState, Identifier::fromString(execState, "exports")));
-    }
+    JSModuleRecord* record = result->record;
+    if (!record) {
+        if (!error.isEmpty()) {
+            return JSValue::encode(scope.throwException(execState, error));
+        }
 
-    JSModuleRecord::Resolution resolution = record->resolveExport(execState, execState->vm().propertyNames->defaultKeyword);
-    if (resolution.type == JSModuleRecord::Resolution::Type::Resolved) {
-        JSValue defaultExport = record->moduleEnvironment()->get(execState, resolution.localName);
-        ASSERT(!defaultExport.isEmpty());
-        return JSValue::encode(defaultExport);
+        // Another load of the same module, usually an import(), registered it first and this one waits on
+        // its steps. They are application jobs and are not run from here.
+        if (!result->moduleKey.isNull() && isModuleRegistered(execState, globalObject, result->moduleKey)) {
+            return JSValue::encode(throwException(execState, scope, createError(execState, makeString("Cannot require module '", specifier, "' while it is being loaded by an import(). Wait for the import() to settle before requiring it."))));
+        }
+
+        return JSValue::encode(throwTypeError(execState, scope, makeString("Could not load module '", specifier, "' synchronously.")));
     }
 
-    return JSValue::encode(jsUndefined());
+    globalObject->_requireCache.add(referrer, WTF::HashMap<WTF::String, JSC::Strong<JSModuleRecord>>()).iterator->value.set(specifier, JSC::Strong<JSModuleRecord>(vm, record));
+
+    return JSValue::encode(moduleRecordExports(execState, globalObject, record));
 }
 
 static void putValueInScopeAndSymbolTable(VM& vm, JSModuleRecord* moduleRecord, const Identifier& identifier, JSValue value) {
@@ -459,28 +413,30 @@ JSValue GlobalObject::moduleLoaderEvaluate(JSGlobalObject* globalObject, ExecSta
     GlobalObject* self = jsCast<GlobalObject*>(globalObject);
     VM& vm = execState->vm();
 
+    // Microtasks queued by the module's own code are application work and must not be run by an enclosing require().
+    SetForScope<WTF::Deque<WTF::RefPtr<Microtask>>*> moduleLoaderMicrotasksScope(self->_moduleLoaderMicrotasks, nullptr);
+
     if (JSValue moduleFunction = moduleRecord->getDirect(vm, self->_commonJSModuleFunctionIdentifier)) {
-        NSURL* moduleUrl = [NSURL fileURLWithPath:(NSString*)keyValue.toWTFString(execState).createCFString().get()];
-        Identifier exportsIdentifier = Identifier::fromString(&vm, "exports");
+        WTF::String filename = keyValue.toWTFString(execState);
+        JSString* filenameValue = jsString(&vm, filename);
 
         JSObject* module = constructEmptyObject(execState);
         jsCast<JSObject*>(moduleFunction)->putDirect(vm, vm.propertyNames->builtinNames().moduleEvaluationPrivateName(), module, PropertyAttribute::ReadOnly | PropertyAttribute::DontDelete | PropertyAttribute::DontEnum);
-        module->putDirect(vm, Identifier::fromString(&vm, "id"), jsString(&vm, moduleUrl.path));
-        module->putDirect(vm, Identifier::fromString(&vm, "filename"), jsString(&vm, moduleUrl.path));
+        module->putDirect(vm, self->_commonJSIdIdentifier, filenameValue);
+        module->putDirect(vm, self->_commonJSFilenameIdentifier, filenameValue);
 
         JSObject* exports = constructEmptyObject(execState);
-        module->putDirect(vm, exportsIdentifier, exports);
+        module->putDirect(vm, self->_commonJSExportsIdentifier, exports);
 
-        JSFunction* require = JSFunction::create(vm, globalObject, 1, "require"_s, commonJSRequire);
-        require->putDirect(vm, vm.propertyNames->sourceURL, keyValue, PropertyAttribute::ReadOnly | PropertyAttribute::DontDelete | PropertyAttribute::DontEnum);
-        module->putDirect(vm, Identifier::fromString(&vm, "require"), require);
+        JSFunction* require = self->createCommonJSRequire(vm, keyValue);
+        module->putDirect(vm, self->_commonJSRequireIdentifier, require);
 
         MarkedArgumentBuffer args;
         args.append(require);
         args.append(module);
         args.append(exports);
-        args.append(jsString(&vm, moduleUrl.path.stringByDeletingLastPathComponent));
-        args.append(jsString(&vm, moduleUrl.path));
+        args.append(jsString(&vm, parentPath(filename)));
+        args.append(filenameValue);
 
         CallData callData;
         CallType callType = JSC::getCallData(vm, moduleFunction, callData);
@@ -494,7 +450,7 @@ JSValue GlobalObject::moduleLoaderEvaluate(JSGlobalObject* globalObject, ExecSta
             return exception.get();
         }
 
-        putValueInScopeAndSymbolTable(vm, moduleRecord, vm.propertyNames->builtinNames().starDefaultPrivateName(), module->getDirect(vm, exportsIdentifier));
+        putValueInScopeAndSymbolTable(vm, moduleRecord, vm.propertyNames->builtinNames().starDefaultPrivateName(), module->getDirect(vm, self->_commonJSExportsIdentifier));
         return result;
     } else if (JSValue json = moduleRecord->getDirect(vm, vm.propertyNames->JSON)) {
         putValueInScopeAndSymbolTable(vm, moduleRecord, vm.propertyNames->builtinNames().starDefaultPrivateName(), json);
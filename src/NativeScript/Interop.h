@@ -9,6 +9,7 @@
 #ifndef __NativeScript__Interop__
 #define __NativeScript__Interop__
 
+#include "InteropJSType.h"
 #include "Metadata.h"
 #include <string>
 
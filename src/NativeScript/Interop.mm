@@ -21,6 +21,7 @@
 #include "ObjCBlockType.h"
 #include "ObjCBlockTypeConstructor.h"
 #include "ObjCConstructorBase.h"
+#include "ObjCConstructorDerived.h"
 #include "ObjCConstructorNative.h"
 #include "ObjCProtocolWrapper.h"
 #include "ObjCTypes.h"
@@ -46,76 +47,113 @@ namespace NativeScript {
 using namespace JSC;
 
 void* tryHandleofValue(VM& vm, const JSValue& value, bool* hasHandle) {
-    void* handle;
+    if (!value.isCell()) {
+        *hasHandle = value.isNull();
+        return nullptr;
+    }
 
-    if (ObjCWrapperObject* wrapper = jsDynamicCast<ObjCWrapperObject*>(vm, value)) {
-        *hasHandle = true;
-        handle = static_cast<void*>(wrapper->wrappedObject());
-    } else if (ObjCConstructorBase* constructor = jsDynamicCast<ObjCConstructorBase*>(vm, value)) {
-        *hasHandle = true;
-        handle = static_cast<void*>(constructor->klass());
-    } else if (ObjCProtocolWrapper* protocolWrapper = jsDynamicCast<ObjCProtocolWrapper*>(vm, value)) {
-        *hasHandle = true;
-        handle = static_cast<void*>(protocolWrapper->protocol());
-    } else if (CFunctionWrapper* functionWrapper = jsDynamicCast<CFunctionWrapper*>(vm, value)) {
+    JSCell* cell = value.asCell();
+    switch (static_cast<uint8_t>(cell->type())) {
+    case ObjCWrapperObjectType:
         *hasHandle = true;
-        handle = functionWrapper->functionPointer();
-    } else if (ObjCBlockWrapper* blockWrapper = jsDynamicCast<ObjCBlockWrapper*>(vm, value)) {
+        return static_cast<void*>(jsCast<ObjCWrapperObject*>(cell)->wrappedObject());
+    case ObjCProtocolWrapperType:
         *hasHandle = true;
-        handle = static_cast<void*>(static_cast<ObjCBlockCall*>(blockWrapper->onlyFuncInContainer())->block());
-    } else if (RecordInstance* recordInstance = jsDynamicCast<RecordInstance*>(vm, value)) {
+        return static_cast<void*>(jsCast<ObjCProtocolWrapper*>(cell)->protocol());
+    case RecordInstanceType:
         *hasHandle = true;
-        handle = recordInstance->data();
-    } else if (PointerInstance* pointer = jsDynamicCast<PointerInstance*>(vm, value)) {
+        return jsCast<RecordInstance*>(cell)->data();
+    case PointerInstanceType:
         *hasHandle = true;
-        handle = pointer->data();
-    } else if (ReferenceInstance* referenceInstance = jsDynamicCast<ReferenceInstance*>(vm, value)) {
-        *hasHandle = referenceInstance->data() != nullptr;
-        handle = referenceInstance->data();
-    } else if (IndexedRefInstance* indexedRefInstance = jsDynamicCast<IndexedRefInstance*>(vm, value)) {
-        *hasHandle = indexedRefInstance->data() != nullptr;
-        handle = indexedRefInstance->data();
-    } else if (FunctionReferenceInstance* functionReferenceInstance = jsDynamicCast<FunctionReferenceInstance*>(vm, value)) {
-        *hasHandle = functionReferenceInstance->functionPointer() != nullptr;
-        handle = const_cast<void*>(functionReferenceInstance->functionPointer());
-    } else if (JSArrayBuffer* arrayBuffer = jsDynamicCast<JSArrayBuffer*>(vm, value)) {
+        return jsCast<PointerInstance*>(cell)->data();
+    case ReferenceInstanceType: {
+        void* handle = jsCast<ReferenceInstance*>(cell)->data();
+        *hasHandle = handle != nullptr;
+        return handle;
+    }
+    case IndexedRefInstanceType: {
+        void* handle = jsCast<IndexedRefInstance*>(cell)->data();
+        *hasHandle = handle != nullptr;
+        return handle;
+    }
+    case InternalFunctionType: {
+        const ClassInfo* classInfo = cell->classInfo(vm);
+        if (classInfo == ObjCConstructorNative::info() || classInfo == ObjCConstructorDerived::info()) {
+            *hasHandle = true;
+            return static_cast<void*>(jsCast<ObjCConstructorBase*>(cell)->klass());
+        } else if (classInfo == CFunctionWrapper::info()) {
+            *hasHandle = true;
+            return jsCast<CFunctionWrapper*>(cell)->functionPointer();
+        } else if (classInfo == ObjCBlockWrapper::info()) {
+            *hasHandle = true;
+            return static_cast<void*>(static_cast<ObjCBlockCall*>(jsCast<ObjCBlockWrapper*>(cell)->onlyFuncInContainer())->block());
+        } else if (classInfo == FunctionReferenceInstance::info()) {
+            void* handle = const_cast<void*>(jsCast<FunctionReferenceInstance*>(cell)->functionPointer());
+            *hasHandle = handle != nullptr;
+            return handle;
+        }
+        break;
+    }
+    case ArrayBufferType:
         *hasHandle = true;
-        handle = arrayBuffer->impl()->data();
-    } else if (JSArrayBufferView* arrayBufferView = jsDynamicCast<JSArrayBufferView*>(vm, value)) {
+        return jsCast<JSArrayBuffer*>(cell)->impl()->data();
+    case Int8ArrayType:
+    case Uint8ArrayType:
+    case Uint8ClampedArrayType:
+    case Int16ArrayType:
+    case Uint16ArrayType:
+    case Int32ArrayType:
+    case Uint32ArrayType:
+    case Float32ArrayType:
+    case Float64ArrayType:
+    case DataViewType: {
+        JSArrayBufferView* arrayBufferView = jsCast<JSArrayBufferView*>(cell);
         *hasHandle = true;
         if (arrayBufferView->hasArrayBuffer()) {
-            handle = arrayBufferView->possiblySharedBuffer()->data();
-        } else {
-            handle = arrayBufferView->vector();
+            return arrayBufferView->possiblySharedBuffer()->data();
         }
-    } else if (value.isNull()) {
-        *hasHandle = true;
-        handle = nullptr;
-    } else {
-        *hasHandle = false;
-        handle = nullptr;
+        return arrayBufferView->vector();
+    }
+    default:
+        break;
     }
 
-    return handle;
+    *hasHandle = false;
+    return nullptr;
 }
 
 size_t sizeofValue(VM& vm, const JSC::JSValue& value) {
-    size_t size;
-
-    if (value.inherits(vm, ObjCWrapperObject::info()) || value.inherits(vm, ObjCConstructorBase::info()) || value.inherits(vm, ObjCProtocolWrapper::info()) || value.inherits(vm, CFunctionWrapper::info()) || value.inherits(vm, ObjCBlockWrapper::info()) || value.inherits(vm, ObjCBlockType::info()) || value.inherits(vm, PointerConstructor::info()) || value.inherits(vm, PointerInstance::info()) || value.inherits(vm, ReferenceConstructor::info()) || value.inherits(vm, ReferenceInstance::info()) || value.inherits(vm, FunctionReferenceConstructor::info()) || value.inherits(vm, FunctionReferenceInstance::info())) {
-        size = sizeof(void*);
-    } else if (FFISimpleType* simpleType = jsDynamicCast<FFISimpleType*>(vm, value)) {
-        const ffi_type* ffiType = simpleType->ffiTypeMethodTable().ffiType;
-        size = ffiType->type == FFI_TYPE_VOID ? 0 : ffiType->size;
-    } else if (RecordConstructor* recordConstructor = jsDynamicCast<RecordConstructor*>(vm, value)) {
-        size = recordConstructor->ffiTypeMethodTable().ffiType->size;
-    } else if (RecordInstance* recordInstance = jsDynamicCast<RecordInstance*>(vm, value)) {
-        size = recordInstance->size();
-    } else {
-        size = 0;
+    if (!value.isCell()) {
+        return 0;
     }
 
-    return size;
+    JSCell* cell = value.asCell();
+    switch (static_cast<uint8_t>(cell->type())) {
+    case ObjCWrapperObjectType:
+    case ObjCProtocolWrapperType:
+    case ObjCBlockTypeType:
+    case PointerInstanceType:
+    case ReferenceInstanceType:
+        return sizeof(void*);
+    case FFISimpleTypeType: {
+        const ffi_type* ffiType = jsCast<FFISimpleType*>(cell)->ffiTypeMethodTable().ffiType;
+        return ffiType->type == FFI_TYPE_VOID ? 0 : ffiType->size;
+    }
+    case RecordInstanceType:
+        return jsCast<RecordInstance*>(cell)->size();
+    case InternalFunctionType: {
+        const ClassInfo* classInfo = cell->classInfo(vm);
+        if (classInfo == RecordConstructor::info()) {
+            return jsCast<RecordConstructor*>(cell)->ffiTypeMethodTable().ffiType->size;
+        }
+        if (classInfo == ObjCConstructorNative::info() || classInfo == ObjCConstructorDerived::info() || classInfo == CFunctionWrapper::info() || classInfo == ObjCBlockWrapper::info() || classInfo == PointerConstructor::info() || classInfo == ReferenceConstructor::info() || classInfo == FunctionReferenceConstructor::info() || classInfo == FunctionReferenceInstance::info()) {
+            return sizeof(void*);
+        }
+        return 0;
+    }
+    default:
+        return 0;
+    }
 }
 
 const char* getCompilerEncoding(VM& vm, JSCell* value) {
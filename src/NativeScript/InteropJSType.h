@@ -0,0 +1,41 @@
+//
+//  InteropJSType.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__InteropJSType__
+#define __NativeScript__InteropJSType__
+
+#include <JavaScriptCore/JSType.h>
+#include <JavaScriptCore/JSTypeInfo.h>
+#include <cstdint>
+
+namespace NativeScript {
+
+// JSTypes of the interop cells which marshalling dispatches on, following JSC's own types the way
+// WebCore's wrapper types do. The type is stored in the cell's structure, so telling these cells apart
+// is a single switch instead of a walk of their class hierarchies. None of these classes have subclasses.
+//
+// Cells derived from InternalFunction (constructors, function wrappers and function references) keep
+// InternalFunctionType, which JSC relies on, and are told apart by their ClassInfo.
+enum InteropJSType : uint8_t {
+    ObjCWrapperObjectType = JSC::LastJSCObjectType + 1,
+    AllocatedPlaceholderType,
+    ObjCSuperObjectType,
+    ObjCProtocolWrapperType,
+    ObjCBlockTypeType,
+    RecordInstanceType,
+    PointerInstanceType,
+    ReferenceInstanceType,
+    IndexedRefInstanceType,
+    FFISimpleTypeType,
+};
+
+inline JSC::TypeInfo interopTypeInfo(InteropJSType type, unsigned structureFlags) {
+    return JSC::TypeInfo(static_cast<JSC::JSType>(type), structureFlags);
+}
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__InteropJSType__) */
@@ -1,6 +1,7 @@
 #include "ClearChangedCellsFunctor.h"
 #include <JavaScriptCore/CodeBlock.h>
 #include <JavaScriptCore/ExecutableBase.h>
+#include <JavaScriptCore/FunctionExecutable.h>
 #include <JavaScriptCore/HeapInlines.h>
 #include <JavaScriptCore/JSModuleRecord.h>
 #include <JavaScriptCore/bytecode/FunctionCodeBlock.h>
@@ -10,10 +11,12 @@
 
 namespace NativeScript {
 
-ClearChangedCellsFunctor::ClearChangedCellsFunctor(JSC::VM& vm, WTF::String url, WTF::Vector<DiffChunk> diff)
+ClearChangedCellsFunctor::ClearChangedCellsFunctor(JSC::VM& vm, WTF::String url, WTF::Vector<DiffChunk> diff, WTF::StringView oldSource, WTF::StringView newSource)
     : m_vm(vm)
     , m_url(url)
-    , m_diff(diff) {
+    , m_diff(diff)
+    , m_oldSource(oldSource)
+    , m_newSource(newSource) {
 }
 
 JSC::IterationStatus ClearChangedCellsFunctor::operator()(JSC::HeapCell* cell, JSC::HeapCell::Kind kind) const {
@@ -23,43 +26,87 @@ JSC::IterationStatus ClearChangedCellsFunctor::operator()(JSC::HeapCell* cell, J
     return JSC::IterationStatus::Continue;
 }
 
+static int countLines(WTF::StringView source, int offset, int length) {
+    int lines = 0;
+    for (UChar character : source.substring(offset, length).codeUnits()) {
+        if (character == '\n') {
+            lines++;
+        }
+    }
+    return lines;
+}
+
+static int distanceFromLineStart(WTF::StringView source, int offset) {
+    size_t lineEnd = source.substring(0, offset).reverseFind('\n');
+    return lineEnd == notFound ? offset : offset - static_cast<int>(lineEnd) - 1;
+}
+
+static void clearLinkedCode(JSC::FunctionExecutable* executable) {
+    if (JSC::FunctionCodeBlock* functionCodeBlock = executable->codeBlockForCall()) {
+        functionCodeBlock->unlinkIncomingCalls();
+    }
+    executable->clearNumParametersForCall();
+    auto& subspace = JSC::VM::ScriptExecutableSpaceAndSet::clearableCodeSetFor(*executable->subspace());
+    executable->clearCode(subspace);
+}
+
 void ClearChangedCellsFunctor::visit(JSC::HeapCell* heapCell) const {
-    JSC::JSCell* cell = static_cast<JSC::JSCell*>(heapCell);
-    if (!cell->inherits(m_vm, JSC::JSFunction::info()))
+    // Executables rather than functions are visited, so that those of inner functions which have been
+    // linked by their parent's code but not instantiated yet are remapped as well. Executables which have
+    // not been linked yet are created from their UnlinkedFunctionExecutable, whose ranges are relative to
+    // the parent's and follow it.
+    JSC::FunctionExecutable* executable = JSC::jsDynamicCast<JSC::FunctionExecutable*>(m_vm, static_cast<JSC::JSCell*>(heapCell));
+    if (!executable || executable->isBuiltinFunction())
         return;
 
-    JSC::JSFunction* function = JSC::jsCast<JSC::JSFunction*>(cell);
-    if (function->executable()->isHostFunction() || function->isBuiltinFunction())
+    JSC::SourceCode* sourceCode = const_cast<JSC::SourceCode*>(&executable->source());
+    if (!sourceCode->provider() || sourceCode->provider()->url() != m_url)
         return;
 
-    JSC::SourceCode* sourceCode = const_cast<JSC::SourceCode*>(function->sourceCode());
-    if (sourceCode->provider()->url() == m_url) {
-        bool changed{ false };
-        for (DiffChunk diff : m_diff) {
-            if (diff.pos1 + diff.len1 <= sourceCode->startOffset()) {
-                changed = true;
-                sourceCode->setStartOffset(sourceCode->startOffset() + diff.len1);
-                sourceCode->setStartOffset(sourceCode->startOffset() - diff.len2);
-
-                sourceCode->setEndOffset(sourceCode->endOffset() + diff.len1);
-                sourceCode->setEndOffset(sourceCode->endOffset() - diff.len2);
-            } else if (diff.pos1 >= sourceCode->startOffset() && diff.pos1 <= sourceCode->endOffset()) {
-                changed = true;
-                sourceCode->setEndOffset(sourceCode->endOffset() + diff.len1);
-                sourceCode->setEndOffset(sourceCode->endOffset() - diff.len2);
-            }
+    // Chunks are ordered by position, pos2/len2 refer to the old source and pos1/len1 to the new one.
+    const int startOffset = sourceCode->startOffset();
+    const int endOffset = sourceCode->endOffset();
+    int startDelta = 0;
+    int endDelta = 0;
+    int lineDelta = 0;
+    bool changed = false;
+    for (const DiffChunk& diff : m_diff) {
+        if (diff.pos2 + diff.len2 <= startOffset) {
+            startDelta += diff.len1 - diff.len2;
+            endDelta += diff.len1 - diff.len2;
+            lineDelta += countLines(m_newSource, diff.pos1, diff.len1) - countLines(m_oldSource, diff.pos2, diff.len2);
+        } else if (diff.pos2 < endOffset) {
+            changed = true;
+            endDelta += diff.len1 - diff.len2;
+        } else {
+            break;
         }
+    }
 
-        if (changed) {
-            JSC::FunctionExecutable* executable = function->jsExecutable();
-            if (JSC::FunctionCodeBlock* functionCodeBlock = executable->codeBlockForCall()) {
-                functionCodeBlock->unlinkIncomingCalls();
-            }
-            executable->clearNumParametersForCall();
-            auto& subspace = JSC::VM::ScriptExecutableSpaceAndSet::clearableCodeSetFor(*executable->subspace());
-            executable->clearCode(subspace);
-            executable->unlinkedExecutable()->clearCode(m_vm);
+    const bool moved = startDelta != 0 || lineDelta != 0;
+    if (moved || endDelta != 0) {
+        const int startColumn = sourceCode->startColumn().oneBasedInt();
+        const int newStartColumn = startColumn
+                                   + distanceFromLineStart(m_newSource, startOffset + startDelta)
+                                   - distanceFromLineStart(m_oldSource, startOffset);
+        const bool isSingleLine = executable->lastLine() == sourceCode->firstLine().oneBasedInt();
+        *sourceCode = JSC::SourceCode(makeRef(*sourceCode->provider()), startOffset + startDelta, endOffset + endDelta, sourceCode->firstLine().oneBasedInt() + lineDelta, newStartColumn);
+
+        if (!changed) {
+            // The end of a function which has not changed only moves along with its start
+            unsigned endColumn = executable->endColumn() + (isSingleLine ? newStartColumn - startColumn : 0);
+            executable->recordParse(executable->features(), executable->hasCapturedVariables(), executable->lastLine() + lineDelta, endColumn);
         }
     }
+
+    if (changed) {
+        clearLinkedCode(executable);
+        executable->unlinkedExecutable()->clearCode(m_vm);
+    } else if (moved) {
+        // Bytecode and line numbers are relative to the start of the function, so its unlinked code
+        // is still valid and relinking it needs no parsing. Linked code caches the offset and column
+        // where the function started and cannot be moved, so every moved function is relinked.
+        clearLinkedCode(executable);
+    }
 }
 } // namespace NativeScript
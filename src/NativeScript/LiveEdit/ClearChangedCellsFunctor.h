@@ -3,15 +3,21 @@
 #include <JavaScriptCore/parser/Nodes.h>
 
 namespace NativeScript {
+// Visits the function executables of a script whose source has been replaced. Functions which
+// intersect a change lose their code. All others have their source range moved to where the
+// function is in the new source and keep their unlinked bytecode. Functions which start at the
+// same place keep their compiled code too, those which have moved are relinked on their next call.
 class ClearChangedCellsFunctor : public JSC::MarkedBlock::VoidFunctor {
 public:
-    ClearChangedCellsFunctor(JSC::VM& vm, WTF::String url, WTF::Vector<DiffChunk>);
+    ClearChangedCellsFunctor(JSC::VM& vm, WTF::String url, WTF::Vector<DiffChunk>, WTF::StringView oldSource, WTF::StringView newSource);
     JSC::IterationStatus operator()(JSC::HeapCell* cell, JSC::HeapCell::Kind) const;
 
 private:
     JSC::VM& m_vm;
     WTF::String m_url;
     WTF::Vector<DiffChunk> m_diff;
+    WTF::StringView m_oldSource;
+    WTF::StringView m_newSource;
     void visit(JSC::HeapCell*) const;
 };
 } // namespace NativeScript
@@ -4,6 +4,10 @@
 
 #include "TextualDifferencesHelper.h"
 #include <JavaScriptCore/ContentSearchUtilities.h>
+#include <wtf/text/StringHasher.h>
+#include <wtf/text/StringView.h>
+#include <algorithm>
+#include <climits>
 
 namespace NativeScript {
 const uint32_t kMaxUInt32 = 0xffffffff;
@@ -36,7 +40,61 @@ public:
 
     // Finds the difference between 2 arrays of elements.
     static void CalculateDifference(Input* input,
-                                    Output* result_writer);
+                                    Output* result_writer,
+                                    TextualDifferencesHelper::Algorithm algorithm);
+};
+
+// Merges a sequence of single equal elements and skipped runs into chunks.
+class ResultWriter {
+public:
+    explicit ResultWriter(Comparator::Output* chunk_writer)
+        : chunk_writer_(chunk_writer)
+        , pos1_(0)
+        , pos2_(0)
+        , pos1_begin_(-1)
+        , pos2_begin_(-1)
+        , has_open_chunk_(false) {
+    }
+    void eq() {
+        FlushChunk();
+        pos1_++;
+        pos2_++;
+    }
+    void skip1(int len1) {
+        StartChunk();
+        pos1_ += len1;
+    }
+    void skip2(int len2) {
+        StartChunk();
+        pos2_ += len2;
+    }
+    void close() {
+        FlushChunk();
+    }
+
+private:
+    Comparator::Output* chunk_writer_;
+    int pos1_;
+    int pos2_;
+    int pos1_begin_;
+    int pos2_begin_;
+    bool has_open_chunk_;
+
+    void StartChunk() {
+        if (!has_open_chunk_) {
+            pos1_begin_ = pos1_;
+            pos2_begin_ = pos2_;
+            has_open_chunk_ = true;
+        }
+    }
+
+    void FlushChunk() {
+        if (has_open_chunk_) {
+            chunk_writer_->AddChunk(pos1_begin_, pos2_begin_,
+                                    pos1_ - pos1_begin_, pos2_ - pos2_begin_);
+            has_open_chunk_ = false;
+        }
+    }
 };
 
 // A simple implementation of dynamic programming algorithm. It solves
@@ -182,58 +240,222 @@ private:
     static const int kDirectionSizeBits = 2;
     static const int kDirectionMask = (1 << kDirectionSizeBits) - 1;
     static const int kEmptyCellValue = ~0u << kDirectionSizeBits;
+};
 
-    class ResultWriter {
-    public:
-        explicit ResultWriter(Comparator::Output* chunk_writer)
-            : chunk_writer_(chunk_writer)
-            , pos1_(0)
-            , pos2_(0)
-            , pos1_begin_(-1)
-            , pos2_begin_(-1)
-            , has_open_chunk_(false) {
+// Finds the same difference as Differencer without its table of subproblems, for inputs where
+// the table would be too large.
+//
+// Differencer matches equal elements whenever it can and otherwise skips an element of the
+// second array unless skipping one of the first is strictly shorter. Of all minimal paths
+// through the grid its path is therefore the one furthest along the second array on every row,
+// so it leaves any row at the last cell where the shortest distances from the start and to the
+// end add up to the length of the difference. The path is bisected at its middle row until the
+// rest fits in a table (Hirschberg). Distances are computed only on the diagonals which a path
+// of the known length can reach, so the time is proportional to the length of the inputs times
+// the length of the difference and the memory to the latter.
+class LinearSpaceDifferencer {
+public:
+    explicit LinearSpaceDifferencer(Comparator::Input* input)
+        : input_(input)
+        , len1_(input->GetLength1())
+        , len2_(input->GetLength2()) {
+    }
+
+    void SaveResult(Comparator::Output* chunk_writer) {
+        ResultWriter writer(chunk_writer);
+
+        // Equal leading elements are always matched, they need not take space in the band.
+        int begin = 0;
+        while (begin < len1_ && begin < len2_ && input_->Equals(begin, begin)) {
+            writer.eq();
+            begin++;
         }
-        void eq() {
-            FlushChunk();
-            pos1_++;
-            pos2_++;
+
+        Subproblem problem = { begin, len1_, begin, len2_, 0 };
+        problem.length = ShortestLength(problem);
+        Diff(writer, problem);
+        writer.close();
+    }
+
+private:
+    // The part of the grid between two cells of the path and the length of the path between them.
+    struct Subproblem {
+        int begin1;
+        int end1;
+        int begin2;
+        int end2;
+        int length;
+
+        // Diagonals are numbered by how far along the second array a cell is compared to the
+        // first one, relative to the beginning. A path of the given length can only reach
+        // the diagonals within that many steps of both its start and its end.
+        int end_diagonal() const {
+            return (end2 - begin2) - (end1 - begin1);
         }
-        void skip1(int len1) {
-            StartChunk();
-            pos1_ += len1;
+        int min_diagonal() const {
+            return std::min(0, end_diagonal()) - (length - std::abs(end_diagonal())) / 2;
         }
-        void skip2(int len2) {
-            StartChunk();
-            pos2_ += len2;
+        int width() const {
+            return std::abs(end_diagonal()) + (length - std::abs(end_diagonal())) / 2 * 2 + 1;
         }
-        void close() {
-            FlushChunk();
+        int pos2(int pos1, int index) const {
+            return begin2 + (pos1 - begin1) + min_diagonal() + index;
         }
+    };
+
+    static const int kInfinity = INT_MAX / 2;
 
-    private:
-        Comparator::Output* chunk_writer_;
-        int pos1_;
-        int pos2_;
-        int pos1_begin_;
-        int pos2_begin_;
-        bool has_open_chunk_;
-
-        void StartChunk() {
-            if (!has_open_chunk_) {
-                pos1_begin_ = pos1_;
-                pos2_begin_ = pos2_;
-                has_open_chunk_ = true;
+    Comparator::Input* input_;
+    int len1_;
+    int len2_;
+
+    // Whether a path through the cell has to match its elements, the only move Differencer makes then.
+    bool MustMatch(int pos1, int pos2) {
+        return pos1 < len1_ && pos2 < len2_ && input_->Equals(pos1, pos2);
+    }
+
+    int ShortestLength(Subproblem problem) {
+        const int max_length = (problem.end1 - problem.begin1) + (problem.end2 - problem.begin2);
+        problem.length = std::min(max_length, std::max(std::abs(problem.end_diagonal()), 64));
+        WTF::Vector<int> distances;
+        while (true) {
+            DistancesFromStart(problem, problem.end1, distances);
+            int length = distances[problem.end_diagonal() - problem.min_diagonal()];
+            if (length <= problem.length) {
+                return length;
             }
+            problem.length = std::min(max_length, problem.length * 2);
         }
+    }
 
-        void FlushChunk() {
-            if (has_open_chunk_) {
-                chunk_writer_->AddChunk(pos1_begin_, pos2_begin_,
-                                        pos1_ - pos1_begin_, pos2_ - pos2_begin_);
-                has_open_chunk_ = false;
+    // Shortest distances from the beginning of the subproblem to the cells of row `last_pos1`
+    // within its band, indexed by diagonal.
+    void DistancesFromStart(const Subproblem& problem, int last_pos1, WTF::Vector<int>& current) {
+        const int width = problem.width();
+        WTF::Vector<int> previous(width, kInfinity);
+        WTF::Vector<char> must_match_previous(width, false);
+        WTF::Vector<char> must_match_current(width, false);
+        current.fill(kInfinity, width);
+
+        for (int pos1 = problem.begin1; pos1 <= last_pos1; pos1++) {
+            std::swap(previous, current);
+            std::swap(must_match_previous, must_match_current);
+            for (int index = 0; index < width; index++) {
+                const int pos2 = problem.pos2(pos1, index);
+                if (pos2 < problem.begin2 || pos2 > problem.end2) {
+                    current[index] = kInfinity;
+                    must_match_current[index] = false;
+                    continue;
+                }
+
+                int distance = kInfinity;
+                if (pos1 == problem.begin1 && pos2 == problem.begin2) {
+                    distance = 0;
+                }
+                if (index > 0 && !must_match_current[index - 1]) {
+                    distance = std::min(distance, current[index - 1] + 1);
+                }
+                if (pos1 > problem.begin1) {
+                    if (index + 1 < width && !must_match_previous[index + 1]) {
+                        distance = std::min(distance, previous[index + 1] + 1);
+                    }
+                    if (must_match_previous[index]) {
+                        distance = std::min(distance, previous[index]);
+                    }
+                }
+                current[index] = distance;
+                must_match_current[index] = MustMatch(pos1, pos2);
             }
         }
-    };
+    }
+
+    // Shortest distances from the cells of row `pos1` to the end of the subproblem, given those
+    // from the row below it. Both rows are indexed by diagonal.
+    void DistancesToEnd(const Subproblem& problem, int pos1, const int* next, int* current) {
+        const int width = problem.width();
+        for (int index = width - 1; index >= 0; index--) {
+            const int pos2 = problem.pos2(pos1, index);
+            int distance = kInfinity;
+            if (pos2 < problem.begin2 || pos2 > problem.end2) {
+                // Outside of the grid
+            } else if (pos1 == problem.end1 && pos2 == problem.end2) {
+                distance = 0;
+            } else if (MustMatch(pos1, pos2)) {
+                if (pos1 < problem.end1 && pos2 < problem.end2) {
+                    distance = next[index];
+                }
+            } else {
+                if (pos2 < problem.end2 && index + 1 < width) {
+                    distance = std::min(distance, current[index + 1] + 1);
+                }
+                if (pos1 < problem.end1 && index > 0) {
+                    distance = std::min(distance, next[index - 1] + 1);
+                }
+            }
+            current[index] = distance;
+        }
+    }
+
+    void Diff(ResultWriter& writer, const Subproblem& problem) {
+        const int rows = problem.end1 - problem.begin1;
+        if (rows <= 1 || static_cast<int64_t>(rows + 1) * problem.width() <= kMaxTableCells) {
+            Walk(writer, problem);
+            return;
+        }
+
+        const int mid_pos1 = problem.begin1 + rows / 2;
+        WTF::Vector<int> from_start;
+        DistancesFromStart(problem, mid_pos1, from_start);
+
+        WTF::Vector<int> to_end(problem.width(), kInfinity);
+        WTF::Vector<int> below(problem.width(), kInfinity);
+        for (int pos1 = problem.end1; pos1 >= mid_pos1; pos1--) {
+            std::swap(to_end, below);
+            DistancesToEnd(problem, pos1, below.data(), to_end.data());
+        }
+
+        int split_index = problem.width() - 1;
+        while (from_start[split_index] + to_end[split_index] != problem.length) {
+            split_index--;
+        }
+        const int split_pos2 = problem.pos2(mid_pos1, split_index);
+
+        Diff(writer, { problem.begin1, mid_pos1, problem.begin2, split_pos2, from_start[split_index] });
+        Diff(writer, { mid_pos1, problem.end1, split_pos2, problem.end2, to_end[split_index] });
+    }
+
+    // Follows Differencer's choices using the distances to the end of the whole subproblem.
+    void Walk(ResultWriter& writer, const Subproblem& problem) {
+        const int width = problem.width();
+        const int rows = problem.end1 - problem.begin1;
+        WTF::Vector<int> to_end((rows + 2) * width, kInfinity);
+        for (int pos1 = problem.end1; pos1 >= problem.begin1; pos1--) {
+            int* current = to_end.data() + (pos1 - problem.begin1) * width;
+            DistancesToEnd(problem, pos1, current + width, current);
+        }
+        auto distance = [&](int pos1, int pos2) {
+            return to_end[(pos1 - problem.begin1) * width + (pos2 - problem.pos2(pos1, 0))];
+        };
+
+        int pos1 = problem.begin1;
+        int pos2 = problem.begin2;
+        while (pos1 < problem.end1 || pos2 < problem.end2) {
+            if (pos1 < problem.end1 && pos2 < problem.end2 && MustMatch(pos1, pos2)) {
+                writer.eq();
+                pos1++;
+                pos2++;
+            } else if (pos2 < problem.end2 && pos2 + 1 <= problem.pos2(pos1, width - 1) && distance(pos1, pos2 + 1) + 1 == distance(pos1, pos2)) {
+                writer.skip2(1);
+                pos2++;
+            } else {
+                writer.skip1(1);
+                pos1++;
+            }
+        }
+    }
+
+    // Largest table of distances a subproblem is finished with.
+    static const int64_t kMaxTableCells = 1 << 20;
 };
 
 // Additional to Input interface. Lets switch Input range to subrange.
@@ -252,14 +474,31 @@ public:
     virtual void SetSubrange2(int offset, int len) = 0;
 };
 
+static unsigned HashCharacters(WTF::StringView characters) {
+    if (characters.is8Bit()) {
+        return WTF::StringHasher::computeHashAndMaskTop8Bits(characters.characters8(), characters.length());
+    }
+
+    return WTF::StringHasher::computeHashAndMaskTop8Bits(characters.characters16(), characters.length());
+}
+
 // Wraps raw n-elements line_ends array as a list of n+1 lines. The last line
-// never has terminating new line character.
+// never has terminating new line character. Every line is hashed once up front
+// so that most unequal lines are told apart without looking at their characters.
 class LineEndsWrapper {
 public:
-    explicit LineEndsWrapper(WTF::String string)
+    explicit LineEndsWrapper(const WTF::String& string)
         : ends_array_(Inspector::ContentSearchUtilities::lineEndings(string))
         , string_len_(string.length()) {
-        //        ends_array_ = std::move(Inspector::ContentSearchUtilities::lineEndings(string));
+        WTF::StringView view(string);
+        line_hashes_.reserveInitialCapacity(length());
+        for (int i = 0; i < length(); i++) {
+            line_hashes_.uncheckedAppend(HashCharacters(view.substring(GetLineStart(i), GetLineEnd(i) - GetLineStart(i))));
+        }
+    }
+
+    unsigned GetLineHash(int index) {
+        return line_hashes_[index];
     }
 
     int length() {
@@ -287,6 +526,7 @@ public:
 
 private:
     Vector<size_t> ends_array_;
+    Vector<unsigned> line_hashes_;
     int string_len_;
 
     int GetPosAfterNewLine(int index) {
@@ -294,20 +534,15 @@ private:
     }
 };
 
-static bool CompareSubstrings(WTF::String s1, int pos1,
-                              WTF::String s2, int pos2, int len) {
-    for (int i = 0; i < len; i++) {
-        if (s1.characterAt(i + pos1) != s2.characterAt(i + pos2)) {
-            return false;
-        }
-    }
-    return true;
+static bool CompareSubstrings(WTF::StringView s1, int pos1,
+                              WTF::StringView s2, int pos2, int len) {
+    return s1.substring(pos1, len) == s2.substring(pos2, len);
 }
 
 // Represents 2 strings as 2 arrays of lines.
 class LineArrayCompareInput : public SubrangableInput {
 public:
-    LineArrayCompareInput(WTF::String s1, WTF::String s2,
+    LineArrayCompareInput(WTF::StringView s1, WTF::StringView s2,
                           LineEndsWrapper& line_ends1, LineEndsWrapper& line_ends2)
         : s1_(s1)
         , s2_(s2)
@@ -328,6 +563,10 @@ public:
         index1 += subrange_offset1_;
         index2 += subrange_offset2_;
 
+        if (line_ends1_.GetLineHash(index1) != line_ends2_.GetLineHash(index2)) {
+            return false;
+        }
+
         int line_start1 = line_ends1_.GetLineStart(index1);
         int line_start2 = line_ends2_.GetLineStart(index2);
         int line_end1 = line_ends1_.GetLineEnd(index1);
@@ -350,8 +589,8 @@ public:
     }
 
 private:
-    WTF::String s1_;
-    WTF::String s2_;
+    WTF::StringView s1_;
+    WTF::StringView s2_;
     LineEndsWrapper& line_ends1_;
     LineEndsWrapper& line_ends2_;
     int subrange_offset1_;
@@ -390,8 +629,8 @@ private:
 //     Make array of tokens instead.
 class TokensCompareInput : public Comparator::Input {
 public:
-    TokensCompareInput(WTF::String s1, int offset1, int len1,
-                       WTF::String s2, int offset2, int len2)
+    TokensCompareInput(WTF::StringView s1, int offset1, int len1,
+                       WTF::StringView s2, int offset2, int len2)
         : s1_(s1)
         , offset1_(offset1)
         , len1_(len1)
@@ -406,14 +645,14 @@ public:
         return len2_;
     }
     bool Equals(int index1, int index2) {
-        return s1_.characterAt(offset1_ + index1) == s2_.characterAt(offset2_ + index2);
+        return s1_[offset1_ + index1] == s2_[offset2_ + index2];
     }
 
 private:
-    WTF::String s1_;
+    WTF::StringView s1_;
     int offset1_;
     int len1_;
-    WTF::String s2_;
+    WTF::StringView s2_;
     int offset2_;
     int len2_;
 };
@@ -439,8 +678,23 @@ private:
     int offset2_;
 };
 
+// Largest table of subproblems that Differencer is allowed to allocate (16 MB).
+static const int64_t kMaxDifferencerCells = 1 << 22;
+
 void Comparator::CalculateDifference(Comparator::Input* input,
-                                     Comparator::Output* result_writer) {
+                                     Comparator::Output* result_writer,
+                                     TextualDifferencesHelper::Algorithm algorithm) {
+    if (algorithm == TextualDifferencesHelper::Algorithm::Automatic) {
+        bool fits = static_cast<int64_t>(input->GetLength1()) * input->GetLength2() <= kMaxDifferencerCells;
+        algorithm = fits ? TextualDifferencesHelper::Algorithm::Table : TextualDifferencesHelper::Algorithm::LinearSpace;
+    }
+
+    if (algorithm == TextualDifferencesHelper::Algorithm::LinearSpace) {
+        LinearSpaceDifferencer differencer(input);
+        differencer.SaveResult(result_writer);
+        return;
+    }
+
     Differencer differencer(input);
     differencer.Initialize();
     differencer.FillTable();
@@ -453,14 +707,16 @@ class TokenizingLineArrayCompareOutput : public SubrangableOutput {
 public:
     TokenizingLineArrayCompareOutput(LineEndsWrapper& line_ends1,
                                      LineEndsWrapper& line_ends2,
-                                     WTF::String s1, WTF::String s2)
+                                     WTF::StringView s1, WTF::StringView s2,
+                                     TextualDifferencesHelper::Algorithm algorithm)
         : array_writer_()
         , line_ends1_(line_ends1)
         , line_ends2_(line_ends2)
         , s1_(s1)
         , s2_(s2)
         , subrange_offset1_(0)
-        , subrange_offset2_(0) {
+        , subrange_offset2_(0)
+        , algorithm_(algorithm) {
     }
 
     void AddChunk(int line_pos1, int line_pos2, int line_len1, int line_len2) {
@@ -480,7 +736,7 @@ public:
             TokensCompareOutput tokens_output(&array_writer_, char_pos1,
                                               char_pos2);
 
-            Comparator::CalculateDifference(&tokens_input, &tokens_output);
+            Comparator::CalculateDifference(&tokens_input, &tokens_output, algorithm_);
         } else {
             array_writer_.WriteChunk(char_pos1, char_pos2, char_len1, char_len2);
         }
@@ -502,10 +758,11 @@ private:
     CompareOutputArrayWriter array_writer_;
     LineEndsWrapper& line_ends1_;
     LineEndsWrapper& line_ends2_;
-    WTF::String s1_;
-    WTF::String s2_;
+    WTF::StringView s1_;
+    WTF::StringView s2_;
     int subrange_offset1_;
     int subrange_offset2_;
+    TextualDifferencesHelper::Algorithm algorithm_;
 };
 
 static int min(int a, int b) {
@@ -573,16 +830,16 @@ private:
     WTF::Vector<DiffChunk> m_chunks;
 };
 
-WTF::Vector<DiffChunk> TextualDifferencesHelper::CompareStrings(WTF::String s1, WTF::String s2) {
+WTF::Vector<DiffChunk> TextualDifferencesHelper::CompareStrings(const WTF::String& s1, const WTF::String& s2, Algorithm algorithm) {
     LineEndsWrapper line_ends1(s1);
     LineEndsWrapper line_ends2(s2);
 
     LineArrayCompareInput input(s1, s2, line_ends1, line_ends2);
-    TokenizingLineArrayCompareOutput output(line_ends1, line_ends2, s1, s2);
+    TokenizingLineArrayCompareOutput output(line_ends1, line_ends2, s1, s2, algorithm);
 
     NarrowDownInput(&input, &output);
 
-    Comparator::CalculateDifference(&input, &output);
+    Comparator::CalculateDifference(&input, &output, algorithm);
 
     auto result = output.GetResult();
     PosTranslator posTranslator(result);
@@ -15,6 +15,14 @@ struct DiffChunk {
 
 class TextualDifferencesHelper {
 public:
-    static WTF::Vector<DiffChunk> CompareStrings(WTF::String s1, WTF::String s2);
+    // Both algorithms find the same difference. The table of subproblems is used unless it would be
+    // too large, the others are there to compare them.
+    enum class Algorithm {
+        Automatic,
+        Table,
+        LinearSpace,
+    };
+
+    static WTF::Vector<DiffChunk> CompareStrings(const WTF::String& s1, const WTF::String& s2, Algorithm = Algorithm::Automatic);
 };
 } // namespace NativeScript
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define __NativeScript__FFISimpleType__
 
 #include "FFIType.h"
+#include "InteropJSType.h"
 
 namespace NativeScript {
 class FFISimpleType : public JSC::JSNonFinalObject {
@@ -25,7 +26,7 @@ public:
     DECLARE_INFO;
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(FFISimpleTypeType, StructureFlags), info());
     }
 
     const FFITypeMethodTable& ffiTypeMethodTable() const {
@@ -9,6 +9,8 @@
 #ifndef __NativeScript__PointerInstance__
 #define __NativeScript__PointerInstance__
 
+#include "InteropJSType.h"
+
 namespace NativeScript {
 
 /**
@@ -30,7 +32,7 @@ public:
     }
 
     static JSC::Structure* createStructure(JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(globalObject->vm(), globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(globalObject->vm(), globalObject, prototype, interopTypeInfo(PointerInstanceType, StructureFlags), info());
     }
 
     void* data() const {
@@ -9,6 +9,7 @@
 #ifndef __NativeScript__RecordInstance__
 #define __NativeScript__RecordInstance__
 
+#include "InteropJSType.h"
 #include "PointerInstance.h"
 
 namespace NativeScript {
@@ -26,7 +27,7 @@ public:
     DECLARE_INFO;
 
     static JSC::Structure* createStructure(JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(globalObject->vm(), globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(globalObject->vm(), globalObject, prototype, interopTypeInfo(RecordInstanceType, StructureFlags), info());
     }
 
     void* data() const {
@@ -10,6 +10,7 @@
 #define __NativeScript__IndexedRefInstance__
 
 #include "FFIType.h"
+#include "InteropJSType.h"
 #include "PointerInstance.h"
 
 namespace NativeScript {
@@ -33,7 +34,7 @@ public:
     }
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(IndexedRefInstanceType, StructureFlags), info());
     }
 
     void createBackingStorage(JSC::VM&, GlobalObject*, JSC::ExecState*, JSC::JSCell* innerType);
@@ -58,6 +58,13 @@ inline UInt8 getMinorVersion(UInt8 encodedVersion) {
     return encodedVersion & 0b111;
 }
 
+/**
+ * \brief Whether an entity introduced in \p introducedIn can be used on \p systemVersion, both encoded with \c encodeVersion.
+ */
+inline bool isIntroducedBy(UInt8 introducedIn, UInt8 systemVersion) {
+    return introducedIn == 0 || introducedIn <= systemVersion;
+}
+
 // Bit indices in flags section
 enum MetaFlags {
     HasName = 7,
@@ -339,6 +346,9 @@ public:
         const ModuleTable* mt = this->topLevelModulesTable();
         return offset(mt, mt->sizeInBytes());
     }
+
+    // Methods, property accessors included, of all classes and protocols. Walks the whole global table.
+    size_t methodsCount() const;
 };
 
 template <typename T>
@@ -676,9 +686,7 @@ public:
         return this->flag(MetaFlags::MethodOwnsReturnedCocoaObject);
     }
 
-    SEL selector() const {
-        return sel_registerName(this->selectorAsString());
-    }
+    SEL selector() const;
 
     // just a more convenient way to get the selector of method
     const char* selectorAsString() const {
@@ -744,6 +752,12 @@ struct BaseClassMeta : Meta {
     PtrTo<Array<String>> protocols;
     int16_t initializersStartIndex;
 
+    // Resolved metas of the protocols directly adopted by this class or protocol
+    const std::vector<const ProtocolMeta*>& protocolMetas() const;
+
+    // All adopted protocols, including the inherited ones, each listed once in depth-first order
+    const std::vector<const ProtocolMeta*>& protocolsClosure() const;
+
     const MemberMeta* member(const char* identifier, size_t length, MemberType type, bool includeProtocols = true, bool onlyIfAvailable = true) const;
 
     const MethodMeta* member(const char* identifier, size_t length, MemberType type, size_t paramsCount, bool includeProtocols = true, bool onlyIfAvailable = true) const;
@@ -877,6 +891,9 @@ struct BaseClassMeta : Meta {
     std::vector<const MethodMeta*> initializers(std::vector<const MethodMeta*>& container, Class klass) const;
 
     std::vector<const MethodMeta*> initializersWithProtocols(std::vector<const MethodMeta*>& container, Class klass) const;
+
+private:
+    void collectProtocolMembers(const char* identifier, size_t length, MemberType type, bool onlyIfAvailable, MembersCollection& result) const;
 };
 
 struct ProtocolMeta : BaseClassMeta {
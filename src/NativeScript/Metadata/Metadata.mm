@@ -7,6 +7,7 @@
 //
 
 #include "Metadata.h"
+#include "SelectorCache.h"
 #include "SymbolLoader.h"
 #include <UIKit/UIKit.h>
 #include <sys/stat.h>
@@ -17,40 +18,18 @@ using namespace std;
 
 /**
  * \brief Gets the system version of the current device.
+ *
+ * The version is read and parsed once per process, every later call returns the stored value.
  */
 static UInt8 getSystemVersion() {
     static UInt8 iosVersion;
-    if (iosVersion != 0) {
-        return iosVersion;
-    }
-
-    NSString* version = [[UIDevice currentDevice] systemVersion];
-    NSArray* versionTokens = [version componentsSeparatedByCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"."]];
-    UInt8 majorVersion = (UInt8)[versionTokens[0] intValue];
-    UInt8 minorVersion = (UInt8)[versionTokens[1] intValue];
-
-    return encodeVersion(majorVersion, minorVersion);
-}
-std::unordered_map<std::string, MembersCollection> getMetasByJSNames(MembersCollection members) {
-    std::unordered_map<std::string, MembersCollection> result;
-    for (auto member : members) {
-        result[member->jsName()].add(member);
-    }
-    return result;
-}
-
-static int compareIdentifiers(const char* nullTerminated, const char* notNullTerminated, size_t length) {
-    int result = strncmp(nullTerminated, notNullTerminated, length);
-    return (result == 0) ? strlen(nullTerminated) - length : result;
-}
-
-const InterfaceMeta* GlobalTable::findInterfaceMeta(WTF::StringImpl* identifier) const {
-    return this->findInterfaceMeta(reinterpret_cast<const char*>(identifier->utf8().data()), identifier->length(), identifier->hash());
-}
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+      NSOperatingSystemVersion version = [[NSProcessInfo processInfo] operatingSystemVersion];
+      iosVersion = encodeVersion((UInt8)version.majorVersion, (UInt8)version.minorVersion);
+    });
 
-const InterfaceMeta* GlobalTable::findInterfaceMeta(const char* identifierString) const {
-    unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(identifierString));
-    return this->findInterfaceMeta(identifierString, strlen(identifierString), hash);
+    return iosVersion;
 }
 
 const InterfaceMeta* GlobalTable::findInterfaceMeta(const char* identifierString, size_t length, unsigned hash) const {
@@ -80,57 +59,23 @@ const InterfaceMeta* GlobalTable::findInterfaceMeta(const char* identifierString
     }
 }
 
-const ProtocolMeta* GlobalTable::findProtocol(WTF::StringImpl* identifier) const {
-    return this->findProtocol(reinterpret_cast<const char*>(identifier->utf8().data()), identifier->length(), identifier->hash());
-}
-
-const ProtocolMeta* GlobalTable::findProtocol(const char* identifierString) const {
-    unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(identifierString));
-    return this->findProtocol(identifierString, strlen(identifierString), hash);
-}
-
-const ProtocolMeta* GlobalTable::findProtocol(const char* identifierString, size_t length, unsigned hash) const {
-    // Do not check for availability when returning a protocol. Apple regularly create new protocols and move
-    // existing interface members there (e.g. iOS 12.0 introduced the UIFocusItemScrollableContainer protocol
-    // in UIKit which contained members that have existed in UIScrollView since iOS 2.0)
-
-    auto meta = this->findMeta(identifierString, length, hash, /*onlyIfAvailable*/ false);
-    ASSERT(!meta || meta->type() == ProtocolType);
-    return static_cast<const ProtocolMeta*>(meta);
+// Meta
+bool Meta::isAvailable() const {
+    return isIntroducedBy(this->introducedIn(), getSystemVersion());
 }
 
-const Meta* GlobalTable::findMeta(WTF::StringImpl* identifier, bool onlyIfAvailable) const {
-    return this->findMeta(reinterpret_cast<const char*>(identifier->utf8().data()), identifier->length(), identifier->hash(), onlyIfAvailable);
-}
+// MethodMeta class
 
-const Meta* GlobalTable::findMeta(const char* identifierString, bool onlyIfAvailable) const {
-    unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(identifierString));
-    return this->findMeta(identifierString, strlen(identifierString), hash, onlyIfAvailable);
+static size_t methodsCount() {
+    return MetaFile::instance()->methodsCount();
 }
 
-const Meta* GlobalTable::findMeta(const char* identifierString, size_t length, unsigned hash, bool onlyIfAvailable) const {
-    int bucketIndex = hash % buckets.count;
-    if (this->buckets[bucketIndex].isNull()) {
-        return nullptr;
-    }
-    const ArrayOfPtrTo<Meta>& bucketContent = buckets[bucketIndex].value();
-    for (ArrayOfPtrTo<Meta>::iterator it = bucketContent.begin(); it != bucketContent.end(); it++) {
-        const Meta* meta = (*it).valuePtr();
-        if (compareIdentifiers(meta->jsName(), identifierString, length) == 0) {
-            return onlyIfAvailable ? (meta->isAvailable() ? meta : nullptr) : meta;
-        }
-    }
-    return nullptr;
-}
+static SelectorCache<SEL> selectorCache(methodsCount);
 
-// Meta
-bool Meta::isAvailable() const {
-    UInt8 introducedIn = this->introducedIn();
-    UInt8 systemVersion = getSystemVersion();
-    return introducedIn == 0 || introducedIn <= systemVersion;
+SEL MethodMeta::selector() const {
+    return selectorCache.selector(this, [this] { return sel_registerName(this->selectorAsString()); });
 }
 
-// MethodMeta class
 bool MethodMeta::isImplementedInClass(Class klass, bool isStatic) const {
     // class can be null for Protocol prototypes, treat all members in a protocol as implemented
     if (klass == nullptr) {
@@ -165,125 +110,18 @@ bool MethodMeta::isImplementedInClass(Class klass, bool isStatic) const {
     }
 }
 
-// BaseClassMeta
-const MemberMeta* BaseClassMeta::member(const char* identifier, size_t length, MemberType type, bool includeProtocols, bool onlyIfAvailable) const {
-
-    MembersCollection members = this->members(identifier, length, type, includeProtocols, onlyIfAvailable);
-
-    // It's expected to receive only one occurence when member is used. If more than one results can
-    // be found consider (1) using BaseClassMeta::members to process all of them; or (2) fixing metadata
-    // generator to disambiguate and remove the redundant one(s); or (3) modify this method so that it doesn't arbitrary
-    // choose one and drop the other(s) but deterministically decides which one has to be returned.
-    ASSERT(members.size() <= 1);
-
-    return members.size() > 0 ? *members.begin() : nullptr;
-}
-
-void collectInheritanceChainMembers(const char* identifier, size_t length, MemberType type, bool onlyIfAvailable, const BaseClassMeta* derivedClass, std::function<void(const MemberMeta*)> collectMember) {
-
-    const ArrayOfPtrTo<MemberMeta>* members = nullptr;
-    // Scan method overloads (methods with different selectors and number of arguments which have the same jsName)
-    // in base classes. Properties cannot be overridden like that so there's no need to traverse the hierarchy.
-    bool shouldScanForOverrides = true;
-    switch (type) {
-    case MemberType::InstanceMethod:
-        members = &derivedClass->instanceMethods->castTo<PtrTo<MemberMeta>>();
-        break;
-    case MemberType::StaticMethod:
-        members = &derivedClass->staticMethods->castTo<PtrTo<MemberMeta>>();
-        break;
-    case MemberType::InstanceProperty:
-        shouldScanForOverrides = false;
-        members = &derivedClass->instanceProps->castTo<PtrTo<MemberMeta>>();
-        break;
-    case MemberType::StaticProperty:
-        shouldScanForOverrides = false;
-        members = &derivedClass->staticProps->castTo<PtrTo<MemberMeta>>();
-        break;
-    }
-
-    int resultIndex = -1;
-    resultIndex = members->binarySearchLeftmost([&](const PtrTo<MemberMeta>& member) { return compareIdentifiers(member->jsName(), identifier, length); });
-
-    if (resultIndex >= 0) {
-        for (const MemberMeta* m = (*members)[resultIndex].valuePtr();
-             resultIndex < members->count && (strncmp(m->jsName(), identifier, length) == 0 && strlen(m->jsName()) == length);
-             m = (*members)[++resultIndex].valuePtr()) {
-            if (m->isAvailable() || !onlyIfAvailable) {
-                collectMember(m);
-            }
-        }
-
-        if (shouldScanForOverrides && derivedClass->type() == MetaType::Interface) {
-            const BaseClassMeta* superClass = static_cast<const InterfaceMeta*>(derivedClass)->baseMeta();
-            if (superClass) {
-                collectInheritanceChainMembers(identifier, length, type, onlyIfAvailable, superClass, collectMember);
-            }
-        }
-    }
-}
-
-const MembersCollection BaseClassMeta::members(const char* identifier, size_t length, MemberType type, bool includeProtocols, bool onlyIfAvailable) const {
-
-    MembersCollection result;
-
-    if (type == MemberType::InstanceMethod || type == MemberType::StaticMethod) {
-
-        // We need to return base class members as well. Otherwise,
-        // if an overloaded method is overriden by a derived class
-        // the FunctionWrapper's *functionsContainer* will contain
-        // overriden members metas only.
-        std::map<int, const MemberMeta*> membersMap;
-        collectInheritanceChainMembers(identifier, length, type, onlyIfAvailable, this, [&](const MemberMeta* member) {
-            const MethodMeta* method = static_cast<const MethodMeta*>(member);
-            membersMap.emplace(method->encodings()->count, member);
-        });
-        for (std::map<int, const MemberMeta*>::iterator it = membersMap.begin(); it != membersMap.end(); ++it) {
-            result.add(it->second);
-        }
-
-    } else { // member is a property
-        collectInheritanceChainMembers(identifier, length, type, onlyIfAvailable, this, [&](const MemberMeta* member) {
-            result.add(member);
-        });
-    }
-
-    if (result.size() > 0) {
-        return result;
-    }
-
-    // search in protocols
-    if (includeProtocols) {
-        for (Array<String>::iterator it = protocols->begin(); it != protocols->end(); ++it) {
-            const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
-            if (protocolMeta != nullptr) {
-                const MembersCollection members = protocolMeta->members(identifier, length, type, onlyIfAvailable);
-                if (members.size() > 0) {
-                    result.add(members.begin(), members.end());
-                }
-            }
-        }
-    }
-
-    return result;
-}
-
 std::vector<const PropertyMeta*> BaseClassMeta::instancePropertiesWithProtocols(std::vector<const PropertyMeta*>& container, Class klass) const {
     this->instanceProperties(container, klass);
-    for (Array<String>::iterator it = protocols->begin(); it != protocols->end(); ++it) {
-        const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
-        if (protocolMeta != nullptr)
-            protocolMeta->instancePropertiesWithProtocols(container, klass);
+    for (const ProtocolMeta* protocolMeta : this->protocolMetas()) {
+        protocolMeta->instancePropertiesWithProtocols(container, klass);
     }
     return container;
 }
 
 std::vector<const PropertyMeta*> BaseClassMeta::staticPropertiesWithProtocols(std::vector<const PropertyMeta*>& container, Class klass) const {
     this->staticProperties(container, klass);
-    for (Array<String>::iterator it = protocols->begin(); it != protocols->end(); ++it) {
-        const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
-        if (protocolMeta != nullptr)
-            protocolMeta->staticPropertiesWithProtocols(container, klass);
+    for (const ProtocolMeta* protocolMeta : this->protocolMetas()) {
+        protocolMeta->staticPropertiesWithProtocols(container, klass);
     }
     return container;
 }
@@ -308,64 +146,9 @@ vector<const MethodMeta*> BaseClassMeta::initializers(vector<const MethodMeta*>&
 
 vector<const MethodMeta*> BaseClassMeta::initializersWithProtocols(vector<const MethodMeta*>& container, Class klass) const {
     this->initializers(container, klass);
-    for (Array<String>::iterator it = this->protocols->begin(); it != this->protocols->end(); it++) {
-        const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
-        if (protocolMeta != nullptr)
-            protocolMeta->initializersWithProtocols(container, klass);
+    for (const ProtocolMeta* protocolMeta : this->protocolMetas()) {
+        protocolMeta->initializersWithProtocols(container, klass);
     }
     return container;
 }
-
-const Meta* GlobalTable::iterator::getCurrent() {
-    return this->_globalTable->buckets[_topLevelIndex].value()[_bucketIndex].valuePtr();
-}
-
-GlobalTable::iterator& GlobalTable::iterator::operator++() {
-    this->_bucketIndex++;
-    this->findNext();
-    return *this;
-}
-
-const Meta* GlobalTable::iterator::operator*() {
-    return this->getCurrent();
-}
-
-bool GlobalTable::iterator::operator==(const iterator& other) const {
-    return _globalTable == other._globalTable && _topLevelIndex == other._topLevelIndex && _bucketIndex == other._bucketIndex;
-}
-
-bool GlobalTable::iterator::operator!=(const iterator& other) const {
-    return !(*this == other);
-}
-
-void GlobalTable::iterator::findNext() {
-    if (this->_topLevelIndex == this->_globalTable->buckets.count) {
-        return;
-    }
-
-    do {
-        if (!this->_globalTable->buckets[_topLevelIndex].isNull()) {
-            int bucketLength = this->_globalTable->buckets[_topLevelIndex].value().count;
-            while (this->_bucketIndex < bucketLength) {
-                if (this->getCurrent() != nullptr) {
-                    return;
-                }
-                this->_bucketIndex++;
-            }
-        }
-        this->_bucketIndex = 0;
-        this->_topLevelIndex++;
-    } while (this->_topLevelIndex < this->_globalTable->buckets.count);
-}
-
-static MetaFile* metaFileInstance(nullptr);
-
-MetaFile* MetaFile::instance() {
-    return metaFileInstance;
-}
-
-MetaFile* MetaFile::setInstance(void* metadataPtr) {
-    metaFileInstance = reinterpret_cast<MetaFile*>(metadataPtr);
-    return metaFileInstance;
-}
 }
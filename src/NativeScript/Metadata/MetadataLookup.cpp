@@ -0,0 +1,339 @@
+//
+//  MetadataLookup.cpp
+//  NativeScript
+//
+//  Created by Ivan Buhov on 8/1/14.
+//  Copyright (c) 2014 Telerik. All rights reserved.
+//
+
+#include "Metadata.h"
+#include <atomic>
+#include <map>
+
+// Lookups in the metadata file which depend only on its layout. Everything which needs the
+// Objective-C runtime or the OS version is in Metadata.mm.
+namespace Metadata {
+
+std::unordered_map<std::string, MembersCollection> getMetasByJSNames(MembersCollection members) {
+    std::unordered_map<std::string, MembersCollection> result;
+    for (auto member : members) {
+        result[member->jsName()].add(member);
+    }
+    return result;
+}
+
+static int compareIdentifiers(const char* nullTerminated, const char* notNullTerminated, size_t length) {
+    int result = strncmp(nullTerminated, notNullTerminated, length);
+    return (result == 0) ? strlen(nullTerminated) - length : result;
+}
+
+const InterfaceMeta* GlobalTable::findInterfaceMeta(WTF::StringImpl* identifier) const {
+    return this->findInterfaceMeta(reinterpret_cast<const char*>(identifier->utf8().data()), identifier->length(), identifier->hash());
+}
+
+const InterfaceMeta* GlobalTable::findInterfaceMeta(const char* identifierString) const {
+    unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(identifierString));
+    return this->findInterfaceMeta(identifierString, strlen(identifierString), hash);
+}
+
+const ProtocolMeta* GlobalTable::findProtocol(WTF::StringImpl* identifier) const {
+    return this->findProtocol(reinterpret_cast<const char*>(identifier->utf8().data()), identifier->length(), identifier->hash());
+}
+
+const ProtocolMeta* GlobalTable::findProtocol(const char* identifierString) const {
+    unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(identifierString));
+    return this->findProtocol(identifierString, strlen(identifierString), hash);
+}
+
+const ProtocolMeta* GlobalTable::findProtocol(const char* identifierString, size_t length, unsigned hash) const {
+    // Do not check for availability when returning a protocol. Apple regularly create new protocols and move
+    // existing interface members there (e.g. iOS 12.0 introduced the UIFocusItemScrollableContainer protocol
+    // in UIKit which contained members that have existed in UIScrollView since iOS 2.0)
+
+    auto meta = this->findMeta(identifierString, length, hash, /*onlyIfAvailable*/ false);
+    ASSERT(!meta || meta->type() == ProtocolType);
+    return static_cast<const ProtocolMeta*>(meta);
+}
+
+const Meta* GlobalTable::findMeta(WTF::StringImpl* identifier, bool onlyIfAvailable) const {
+    return this->findMeta(reinterpret_cast<const char*>(identifier->utf8().data()), identifier->length(), identifier->hash(), onlyIfAvailable);
+}
+
+const Meta* GlobalTable::findMeta(const char* identifierString, bool onlyIfAvailable) const {
+    unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(identifierString));
+    return this->findMeta(identifierString, strlen(identifierString), hash, onlyIfAvailable);
+}
+
+const Meta* GlobalTable::findMeta(const char* identifierString, size_t length, unsigned hash, bool onlyIfAvailable) const {
+    int bucketIndex = hash % buckets.count;
+    if (this->buckets[bucketIndex].isNull()) {
+        return nullptr;
+    }
+    const ArrayOfPtrTo<Meta>& bucketContent = buckets[bucketIndex].value();
+    for (ArrayOfPtrTo<Meta>::iterator it = bucketContent.begin(); it != bucketContent.end(); it++) {
+        const Meta* meta = (*it).valuePtr();
+        if (compareIdentifiers(meta->jsName(), identifierString, length) == 0) {
+            return onlyIfAvailable ? (meta->isAvailable() ? meta : nullptr) : meta;
+        }
+    }
+    return nullptr;
+}
+
+// BaseClassMeta
+const MemberMeta* BaseClassMeta::member(const char* identifier, size_t length, MemberType type, bool includeProtocols, bool onlyIfAvailable) const {
+
+    MembersCollection members = this->members(identifier, length, type, includeProtocols, onlyIfAvailable);
+
+    // It's expected to receive only one occurence when member is used. If more than one results can
+    // be found consider (1) using BaseClassMeta::members to process all of them; or (2) fixing metadata
+    // generator to disambiguate and remove the redundant one(s); or (3) modify this method so that it doesn't arbitrary
+    // choose one and drop the other(s) but deterministically decides which one has to be returned.
+    ASSERT(members.size() <= 1);
+
+    return members.size() > 0 ? *members.begin() : nullptr;
+}
+
+void collectInheritanceChainMembers(const char* identifier, size_t length, MemberType type, bool onlyIfAvailable, const BaseClassMeta* derivedClass, std::function<void(const MemberMeta*)> collectMember) {
+
+    const ArrayOfPtrTo<MemberMeta>* members = nullptr;
+    // Scan method overloads (methods with different selectors and number of arguments which have the same jsName)
+    // in base classes. Properties cannot be overridden like that so there's no need to traverse the hierarchy.
+    bool shouldScanForOverrides = true;
+    switch (type) {
+    case MemberType::InstanceMethod:
+        members = &derivedClass->instanceMethods->castTo<PtrTo<MemberMeta>>();
+        break;
+    case MemberType::StaticMethod:
+        members = &derivedClass->staticMethods->castTo<PtrTo<MemberMeta>>();
+        break;
+    case MemberType::InstanceProperty:
+        shouldScanForOverrides = false;
+        members = &derivedClass->instanceProps->castTo<PtrTo<MemberMeta>>();
+        break;
+    case MemberType::StaticProperty:
+        shouldScanForOverrides = false;
+        members = &derivedClass->staticProps->castTo<PtrTo<MemberMeta>>();
+        break;
+    }
+
+    int resultIndex = -1;
+    resultIndex = members->binarySearchLeftmost([&](const PtrTo<MemberMeta>& member) { return compareIdentifiers(member->jsName(), identifier, length); });
+
+    if (resultIndex >= 0) {
+        for (const MemberMeta* m = (*members)[resultIndex].valuePtr();
+             resultIndex < members->count && (strncmp(m->jsName(), identifier, length) == 0 && strlen(m->jsName()) == length);
+             m = (*members)[++resultIndex].valuePtr()) {
+            if (m->isAvailable() || !onlyIfAvailable) {
+                collectMember(m);
+            }
+        }
+
+        if (shouldScanForOverrides && derivedClass->type() == MetaType::Interface) {
+            const BaseClassMeta* superClass = static_cast<const InterfaceMeta*>(derivedClass)->baseMeta();
+            if (superClass) {
+                collectInheritanceChainMembers(identifier, length, type, onlyIfAvailable, superClass, collectMember);
+            }
+        }
+    }
+}
+
+const MembersCollection BaseClassMeta::members(const char* identifier, size_t length, MemberType type, bool includeProtocols, bool onlyIfAvailable) const {
+
+    MembersCollection result;
+
+    if (type == MemberType::InstanceMethod || type == MemberType::StaticMethod) {
+
+        // We need to return base class members as well. Otherwise,
+        // if an overloaded method is overriden by a derived class
+        // the FunctionWrapper's *functionsContainer* will contain
+        // overriden members metas only.
+        std::map<int, const MemberMeta*> membersMap;
+        collectInheritanceChainMembers(identifier, length, type, onlyIfAvailable, this, [&](const MemberMeta* member) {
+            const MethodMeta* method = static_cast<const MethodMeta*>(member);
+            membersMap.emplace(method->encodings()->count, member);
+        });
+        for (std::map<int, const MemberMeta*>::iterator it = membersMap.begin(); it != membersMap.end(); ++it) {
+            result.add(it->second);
+        }
+
+    } else { // member is a property
+        collectInheritanceChainMembers(identifier, length, type, onlyIfAvailable, this, [&](const MemberMeta* member) {
+            result.add(member);
+        });
+    }
+
+    if (result.size() > 0) {
+        return result;
+    }
+
+    // search in protocols
+    if (includeProtocols) {
+        this->collectProtocolMembers(identifier, length, type, onlyIfAvailable, result);
+    }
+
+    return result;
+}
+
+/// Protocol conformance of a class or protocol, resolved once and shared between all runtimes.
+/// Metadata is immutable, so an entry never changes after it has been published.
+struct ProtocolsCacheEntry {
+    const BaseClassMeta* meta;
+    ProtocolsCacheEntry* next;
+    std::vector<const ProtocolMeta*> protocols;
+    std::vector<const ProtocolMeta*> closure;
+};
+
+static void collectProtocolsClosure(const BaseClassMeta* meta, std::vector<const ProtocolMeta*>& closure) {
+    for (Array<String>::iterator it = meta->protocols->begin(); it != meta->protocols->end(); ++it) {
+        const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
+        if (protocolMeta != nullptr && std::find(closure.begin(), closure.end(), protocolMeta) == closure.end()) {
+            closure.push_back(protocolMeta);
+            collectProtocolsClosure(protocolMeta, closure);
+        }
+    }
+}
+
+static std::unique_ptr<ProtocolsCacheEntry> createProtocolsCacheEntry(const BaseClassMeta* meta) {
+    auto entry = std::make_unique<ProtocolsCacheEntry>();
+    entry->meta = meta;
+    for (Array<String>::iterator it = meta->protocols->begin(); it != meta->protocols->end(); ++it) {
+        if (const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr())) {
+            entry->protocols.push_back(protocolMeta);
+        }
+    }
+
+    collectProtocolsClosure(meta, entry->closure);
+
+    return entry;
+}
+
+static ProtocolsCacheEntry* findProtocolsCacheEntry(ProtocolsCacheEntry* entry, const BaseClassMeta* meta) {
+    while (entry != nullptr && entry->meta != meta) {
+        entry = entry->next;
+    }
+    return entry;
+}
+
+// Insert-only hash table with a fixed number of buckets, each a list of entries pushed to its head
+// with a compare-and-swap. Lookups of published entries take no lock.
+static const size_t protocolsCacheBucketsCountLog2 = 12;
+static std::atomic<ProtocolsCacheEntry*> protocolsCacheBuckets[1 << protocolsCacheBucketsCountLog2];
+
+static const ProtocolsCacheEntry& protocolsCacheEntry(const BaseClassMeta* meta) {
+    // Metas are packed in the metadata file, so mix all bits of the address into the bucket index
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(meta)) * 0x9E3779B97F4A7C15ull;
+    std::atomic<ProtocolsCacheEntry*>& bucket = protocolsCacheBuckets[hash >> (64 - protocolsCacheBucketsCountLog2)];
+
+    ProtocolsCacheEntry* head = bucket.load(std::memory_order_acquire);
+    if (ProtocolsCacheEntry* entry = findProtocolsCacheEntry(head, meta)) {
+        return *entry;
+    }
+
+    // Threads which miss the same meta at the same time each build an entry and only the first
+    // one to be published is kept
+    std::unique_ptr<ProtocolsCacheEntry> entry = createProtocolsCacheEntry(meta);
+    while (true) {
+        entry->next = head;
+        if (bucket.compare_exchange_weak(head, entry.get(), std::memory_order_release, std::memory_order_acquire)) {
+            return *entry.release();
+        }
+
+        if (ProtocolsCacheEntry* published = findProtocolsCacheEntry(head, meta)) {
+            return *published;
+        }
+    }
+}
+
+const std::vector<const ProtocolMeta*>& BaseClassMeta::protocolMetas() const {
+    return protocolsCacheEntry(this).protocols;
+}
+
+const std::vector<const ProtocolMeta*>& BaseClassMeta::protocolsClosure() const {
+    return protocolsCacheEntry(this).closure;
+}
+
+void BaseClassMeta::collectProtocolMembers(const char* identifier, size_t length, MemberType type, bool onlyIfAvailable, MembersCollection& result) const {
+    // Each directly adopted protocol is searched the way the class itself is, so a protocol only
+    // contributes its inherited protocols' members when it declares none with this name
+    for (const ProtocolMeta* protocolMeta : protocolsCacheEntry(this).protocols) {
+        const MembersCollection members = protocolMeta->members(identifier, length, type, true, onlyIfAvailable);
+        if (members.size() > 0) {
+            result.add(members.begin(), members.end());
+        }
+    }
+}
+
+
+const Meta* GlobalTable::iterator::getCurrent() {
+    return this->_globalTable->buckets[_topLevelIndex].value()[_bucketIndex].valuePtr();
+}
+
+GlobalTable::iterator& GlobalTable::iterator::operator++() {
+    this->_bucketIndex++;
+    this->findNext();
+    return *this;
+}
+
+const Meta* GlobalTable::iterator::operator*() {
+    return this->getCurrent();
+}
+
+bool GlobalTable::iterator::operator==(const iterator& other) const {
+    return _globalTable == other._globalTable && _topLevelIndex == other._topLevelIndex && _bucketIndex == other._bucketIndex;
+}
+
+bool GlobalTable::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
+void GlobalTable::iterator::findNext() {
+    if (this->_topLevelIndex == this->_globalTable->buckets.count) {
+        return;
+    }
+
+    do {
+        if (!this->_globalTable->buckets[_topLevelIndex].isNull()) {
+            int bucketLength = this->_globalTable->buckets[_topLevelIndex].value().count;
+            while (this->_bucketIndex < bucketLength) {
+                if (this->getCurrent() != nullptr) {
+                    return;
+                }
+                this->_bucketIndex++;
+            }
+        }
+        this->_bucketIndex = 0;
+        this->_topLevelIndex++;
+    } while (this->_topLevelIndex < this->_globalTable->buckets.count);
+}
+
+static size_t accessorsCount(const ArrayOfPtrTo<PropertyMeta>& properties) {
+    size_t count = 0;
+    for (ArrayOfPtrTo<PropertyMeta>::iterator it = properties.begin(); it != properties.end(); ++it) {
+        count += (*it)->hasGetter() + (*it)->hasSetter();
+    }
+    return count;
+}
+
+size_t MetaFile::methodsCount() const {
+    size_t count = 0;
+    for (const Meta* meta : *this->globalTable()) {
+        if (meta->type() == MetaType::Interface || meta->type() == MetaType::ProtocolType) {
+            const BaseClassMeta* classMeta = static_cast<const BaseClassMeta*>(meta);
+            count += classMeta->instanceMethods->count + classMeta->staticMethods->count;
+            count += accessorsCount(classMeta->instanceProps.value()) + accessorsCount(classMeta->staticProps.value());
+        }
+    }
+    return count;
+}
+
+static MetaFile* metaFileInstance(nullptr);
+
+MetaFile* MetaFile::instance() {
+    return metaFileInstance;
+}
+
+MetaFile* MetaFile::setInstance(void* metadataPtr) {
+    metaFileInstance = reinterpret_cast<MetaFile*>(metadataPtr);
+    return metaFileInstance;
+}
+}
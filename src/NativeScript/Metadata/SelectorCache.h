@@ -0,0 +1,132 @@
+//
+//  SelectorCache.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__SelectorCache__
+#define __NativeScript__SelectorCache__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Metadata {
+struct MethodMeta;
+
+/**
+ * \brief An insert-only open addressing table from \c MethodMeta to its registered selector.
+ *
+ * The slots are allocated on first use, twice as many as the methods the metadata declares, so that
+ * probe sequences stay short however large the metadata is. Lookups are lock-free. A slot is claimed
+ * with a compare-and-swap on its key and published by storing the selector, so readers which observe
+ * a claimed slot without a selector simply register it themselves. When the probe sequence is exhausted
+ * the selector is registered without being cached.
+ *
+ * The constructor is constexpr, so a static cache is initialized before any other static code runs.
+ */
+template <typename Selector>
+class SelectorCache {
+public:
+    /// Counts the methods whose selectors can be looked up, called once the cache is first used.
+    typedef size_t (*MethodsCounter)();
+
+    constexpr explicit SelectorCache(MethodsCounter methodsCount)
+        : _methodsCount(methodsCount)
+        , _table(nullptr) {
+    }
+
+    ~SelectorCache() {
+        delete this->_table.load(std::memory_order_acquire);
+    }
+
+    SelectorCache(const SelectorCache&) = delete;
+    SelectorCache& operator=(const SelectorCache&) = delete;
+
+    template <typename Register>
+    Selector selector(const MethodMeta* method, const Register& registerSelector) {
+        Table& table = this->table();
+        size_t hash = (reinterpret_cast<uintptr_t>(method) >> 2) * 0x9E3779B97F4A7C15ull;
+        for (size_t probe = 0; probe < maxProbes; probe++) {
+            Slot& slot = table.slots[(hash + probe) & (table.capacity - 1)];
+
+            const MethodMeta* slotMethod = slot.method.load(std::memory_order_acquire);
+            if (slotMethod == nullptr) {
+                if (slot.method.compare_exchange_strong(slotMethod, method, std::memory_order_acq_rel)) {
+                    Selector selector = registerSelector();
+                    slot.selector.store(selector, std::memory_order_release);
+                    return selector;
+                }
+            }
+
+            if (slotMethod == method) {
+                if (Selector selector = slot.selector.load(std::memory_order_acquire)) {
+                    return selector;
+                }
+                break;
+            }
+        }
+
+        return registerSelector();
+    }
+
+    /// The number of slots, a power of two. Allocates them if the cache has not been used yet.
+    size_t capacity() {
+        return this->table().capacity;
+    }
+
+    static size_t capacityForMethods(size_t methodsCount) {
+        size_t capacity = minCapacity;
+        while (capacity < methodsCount * 2) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    static const size_t minCapacity = 1 << 6;
+    static const size_t maxProbes = 16;
+
+private:
+    struct Slot {
+        std::atomic<const MethodMeta*> method;
+        std::atomic<Selector> selector;
+    };
+
+    struct Table {
+        explicit Table(size_t capacity)
+            : capacity(capacity)
+            , slots(new Slot[capacity]()) {
+        }
+
+        ~Table() {
+            delete[] this->slots;
+        }
+
+        const size_t capacity;
+        Slot* const slots;
+    };
+
+    Table& table() {
+        Table* table = this->_table.load(std::memory_order_acquire);
+        if (table) {
+            return *table;
+        }
+
+        // Threads which use the cache for the first time at once each allocate a table and only the
+        // first one to be published is kept
+        Table* newTable = new Table(capacityForMethods(this->_methodsCount()));
+        if (this->_table.compare_exchange_strong(table, newTable, std::memory_order_acq_rel)) {
+            return *newTable;
+        }
+
+        delete newTable;
+        return *table;
+    }
+
+    const MethodsCounter _methodsCount;
+    std::atomic<Table*> _table;
+};
+} // namespace Metadata
+
+#endif /* defined(__NativeScript__SelectorCache__) */
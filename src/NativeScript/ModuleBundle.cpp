@@ -0,0 +1,163 @@
+//
+//  ModuleBundle.cpp
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "ModuleBundle.h"
+#include <fcntl.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/text/StringHash.h>
+
+namespace NativeScript {
+
+static const char bundleMagic[4] = { 'T', 'N', 'S', 'M' };
+static const size_t headerSize = sizeof(bundleMagic) + 2 * sizeof(uint32_t);
+
+const ModuleBundle* ModuleBundle::forApplicationPath(const WTF::String& applicationPath) {
+    // Every runtime in the process, including workers, shares a single mapping.
+    static std::mutex bundlesMutex;
+    static WTF::NeverDestroyed<WTF::HashMap<WTF::String, ModuleBundle*>> bundles;
+
+    std::lock_guard<std::mutex> lock(bundlesMutex);
+    auto it = bundles.get().find(applicationPath);
+    if (it != bundles.get().end()) {
+        return it->value;
+    }
+
+    ModuleBundle* bundle = map(applicationPath);
+    bundles.get().set(applicationPath, bundle);
+    return bundle;
+}
+
+ModuleBundle* ModuleBundle::map(const WTF::String& applicationPath) {
+    WTF::CString bundlePath = makeString(applicationPath, "/app.tnsmodules").utf8();
+
+    int fd = open(bundlePath.data(), O_RDONLY);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct stat statbuf;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &statbuf) == 0 && static_cast<size_t>(statbuf.st_size) >= headerSize) {
+        data = mmap(nullptr, statbuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        WTF::dataLogF("NativeScript could not map module bundle %s\n", bundlePath.data());
+        return nullptr;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t size = statbuf.st_size;
+
+    uint32_t bundleVersion;
+    uint32_t count;
+    memcpy(&bundleVersion, bytes + sizeof(bundleMagic), sizeof(uint32_t));
+    memcpy(&count, bytes + sizeof(bundleMagic) + sizeof(uint32_t), sizeof(uint32_t));
+
+    bool valid = memcmp(bytes, bundleMagic, sizeof(bundleMagic)) == 0
+                 && bundleVersion == version
+                 && count <= (size - headerSize) / sizeof(Entry);
+
+    const Entry* entries = static_cast<const Entry*>(static_cast<const void*>(bytes + headerSize));
+    for (uint32_t i = 0; valid && i < count; i++) {
+        const Entry& entry = entries[i];
+        valid = static_cast<uint64_t>(entry.pathOffset) + entry.pathLength <= size
+                && static_cast<uint64_t>(entry.contentOffset) + entry.contentLength <= size;
+    }
+
+    if (!valid) {
+        WTF::dataLogF("NativeScript ignored malformed module bundle %s\n", bundlePath.data());
+        munmap(data, size);
+        return nullptr;
+    }
+
+    return new ModuleBundle(makeString(applicationPath, '/'), bytes, count);
+}
+
+ModuleBundle::ModuleBundle(const WTF::String& root, const uint8_t* data, uint32_t count)
+    : _root(root)
+    , _data(data)
+    , _entries(static_cast<const Entry*>(static_cast<const void*>(data + headerSize)))
+    , _count(count) {
+}
+
+bool ModuleBundle::relativePath(const WTF::String& absolutePath, WTF::CString& outPath) const {
+    if (!absolutePath.startsWith(this->_root)) {
+        return false;
+    }
+
+    outPath = absolutePath.substring(this->_root.length()).utf8();
+    return true;
+}
+
+int ModuleBundle::compare(const Entry& entry, const char* path, size_t length) const {
+    int result = memcmp(this->_data + entry.pathOffset, path, std::min<size_t>(entry.pathLength, length));
+    if (result != 0) {
+        return result;
+    }
+
+    return entry.pathLength < length ? -1 : (entry.pathLength > length ? 1 : 0);
+}
+
+const ModuleBundle::Entry* ModuleBundle::lowerBound(const char* path, size_t length) const {
+    const Entry* first = this->_entries;
+    size_t count = this->_count;
+    while (count > 0) {
+        size_t step = count / 2;
+        const Entry* middle = first + step;
+        if (this->compare(*middle, path, length) < 0) {
+            first = middle + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+bool ModuleBundle::containsFile(const WTF::String& absolutePath) const {
+    const char* data;
+    size_t length;
+    return this->contents(absolutePath, data, length);
+}
+
+bool ModuleBundle::containsDirectory(const WTF::String& absolutePath) const {
+    WTF::CString path;
+    if (!this->relativePath(makeString(absolutePath, '/'), path)) {
+        return false;
+    }
+
+    // Directories are implicit, one exists if any entry's path starts with "<directory>/".
+    const Entry* entry = this->lowerBound(path.data(), path.length());
+    return entry != this->_entries + this->_count
+           && entry->pathLength > path.length()
+           && memcmp(this->_data + entry->pathOffset, path.data(), path.length()) == 0;
+}
+
+bool ModuleBundle::contents(const WTF::String& absolutePath, const char*& data, size_t& length) const {
+    WTF::CString path;
+    if (!this->relativePath(absolutePath, path)) {
+        return false;
+    }
+
+    const Entry* entry = this->lowerBound(path.data(), path.length());
+    if (entry == this->_entries + this->_count || this->compare(*entry, path.data(), path.length()) != 0) {
+        return false;
+    }
+
+    data = reinterpret_cast<const char*>(this->_data + entry->contentOffset);
+    length = entry->contentLength;
+    return true;
+}
+} // namespace NativeScript
@@ -0,0 +1,58 @@
+//
+//  ModuleBundle.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__ModuleBundle__
+#define __NativeScript__ModuleBundle__
+
+#include <wtf/text/CString.h>
+#include <wtf/text/WTFString.h>
+
+namespace NativeScript {
+
+/// A read-only archive of application sources produced by build/scripts/pack-modules.py.
+/// The archive is memory mapped once per process and is never unmapped, so the contents
+/// it returns stay valid for the lifetime of the process and can be used without copying.
+///
+/// Layout, all integers are little-endian uint32:
+///     header:  'T' 'N' 'S' 'M', version, entry count
+///     entries: path offset, path length, content offset, content length (sorted by path bytes)
+///     data:    UTF-8 paths relative to the application path and the module sources
+class ModuleBundle {
+public:
+    static const uint32_t version = 1;
+
+    /// Returns the bundle at <applicationPath>/app.tnsmodules, or nullptr if there is none or it is malformed.
+    static const ModuleBundle* forApplicationPath(const WTF::String& applicationPath);
+
+    bool containsFile(const WTF::String& absolutePath) const;
+    bool containsDirectory(const WTF::String& absolutePath) const;
+    bool contents(const WTF::String& absolutePath, const char*& data, size_t& length) const;
+
+private:
+    struct Entry {
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint32_t contentOffset;
+        uint32_t contentLength;
+    };
+
+    ModuleBundle(const WTF::String& root, const uint8_t* data, uint32_t count);
+
+    static ModuleBundle* map(const WTF::String& applicationPath);
+
+    bool relativePath(const WTF::String& absolutePath, WTF::CString& outPath) const;
+    const Entry* lowerBound(const char* path, size_t length) const;
+    int compare(const Entry&, const char* path, size_t length) const;
+
+    WTF::String _root;
+    const uint8_t* _data;
+    const Entry* _entries;
+    uint32_t _count;
+};
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__ModuleBundle__) */
@@ -0,0 +1,202 @@
+//
+//  ModulePathResolver.cpp
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "ModulePathResolver.h"
+#include "ModuleBundle.h"
+#include <wtf/text/StringBuilder.h>
+
+namespace NativeScript {
+
+WTF::String normalizePath(WTF::StringView path) {
+    Vector<WTF::StringView, 16> stack;
+    for (WTF::StringView component : path.split('/')) {
+        if (component == "..") {
+            if (!stack.isEmpty()) {
+                stack.removeLast();
+            }
+        } else if (component != ".") {
+            stack.append(component);
+        }
+    }
+
+    StringBuilder builder;
+    builder.reserveCapacity(path.length());
+    for (size_t i = 0; i < stack.size(); ++i) {
+        if (i > 0 || path.startsWith('/')) {
+            builder.append('/');
+        }
+        builder.append(stack[i]);
+    }
+    if (builder.isEmpty() && path.startsWith('/')) {
+        builder.append('/');
+    }
+    return builder.toString();
+}
+
+WTF::String joinPath(const WTF::String& directory, WTF::StringView component) {
+    return normalizePath(makeString(directory, '/', component));
+}
+
+WTF::String parentPath(const WTF::String& path) {
+    size_t lastSeparatorPosition = path.reverseFind('/');
+    if (lastSeparatorPosition == notFound) {
+        return emptyString();
+    }
+
+    return path.left(lastSeparatorPosition ? lastSeparatorPosition : 1);
+}
+
+mode_t statModulePath(const ModuleBundle* bundle, const WTF::String& path, mode_t mode) {
+    if (bundle) {
+        if ((mode & S_IFREG) && bundle->containsFile(path)) {
+            return S_IFREG;
+        }
+        if ((mode & S_IFDIR) && bundle->containsDirectory(path)) {
+            return S_IFDIR;
+        }
+    }
+
+    struct stat statbuf;
+    if (stat(path.utf8().data(), &statbuf) == 0) {
+        return (statbuf.st_mode & S_IFMT) & mode;
+    }
+
+    return 0;
+}
+
+bool resolveAbsolutePath(const ModuleBundle* bundle, const WTF::String& absolutePath, ModulePathCache& cache, const PackageMainReader& readPackageMain, WTF::String& resolved) {
+    auto cached = cache.find(absolutePath);
+    if (cached != cache.end()) {
+        resolved = cached->value;
+        return true;
+    }
+    // LOAD_AS_FILE(X)
+    // 1. If X is a file, load X as JavaScript text.  STOP
+    // 2. If X.js is a file, load X.js as JavaScript text.  STOP
+    // 3. If X.json is a file, parse X.json to a JavaScript Object.  STOP
+
+    mode_t absolutePathStat = statModulePath(bundle, absolutePath, S_IFDIR | S_IFREG);
+    if (absolutePathStat & S_IFREG) {
+        cache.set(absolutePath, absolutePath);
+        resolved = absolutePath;
+        return true;
+    }
+
+    WTF::String candidatePath = makeString(absolutePath, ".js");
+    if (statModulePath(bundle, candidatePath, S_IFREG)) {
+        cache.set(absolutePath, candidatePath);
+        resolved = candidatePath;
+        return true;
+    }
+
+    candidatePath = makeString(absolutePath, ".json");
+    if (statModulePath(bundle, candidatePath, S_IFREG)) {
+        cache.set(absolutePath, candidatePath);
+        resolved = candidatePath;
+        return true;
+    }
+
+    if (absolutePathStat & S_IFDIR) {
+        //LOAD_AS_DIRECTORY(X)
+        // 1. If X/package.json is a file,
+        //    a. Parse X/package.json, and look for "main" field.
+        //    b. let M = X + (json main field)
+        //    c. LOAD_AS_FILE(M)
+        //    d. LOAD_INDEX(M)
+        // 2. LOAD_INDEX(X)
+
+        // LOAD_INDEX(X)
+        // 1. If X/index.js is a file, load X/index.js as JavaScript text.  STOP
+        // 2. If X/index.json is a file, parse X/index.json to a JavaScript object. STOP
+
+        // pass index to LOAD_AS_FILE if no package.json is found to cover both .js and .json cases
+        // (as a side effect there'll be an additional case 0. If X/index is a file, load it as JS text
+        // which is not present in the specification but shouldn't do any harm)
+        WTF::String mainName = "index"_s;
+        WTF::String packageJsonPath = makeString(absolutePath, "/package.json");
+        if (statModulePath(bundle, packageJsonPath, S_IFREG) && !readPackageMain(packageJsonPath, mainName)) {
+            return false;
+        }
+
+        if (!resolveAbsolutePath(bundle, joinPath(absolutePath, mainName), cache, readPackageMain, resolved)) {
+            return false;
+        }
+
+        cache.set(absolutePath, resolved);
+        return true;
+    }
+
+    resolved = WTF::String();
+    return true;
+}
+
+bool resolveModuleSpecifier(const ModuleBundle* bundle, const WTF::String& applicationPath, const WTF::String& specifier, const WTF::String& referrer, ModulePathCache& cache, const PackageMainReader& readPackageMain, WTF::String& resolved, WTF::String& computedPath) {
+    computedPath = normalizePath(specifier);
+    UChar pathChar = specifier.isEmpty() ? 0 : specifier[0];
+
+    bool isModuleRequire = false;
+
+    if (pathChar != '/') {
+        WTF::String basePath;
+        StringView relativePath = specifier;
+        if (pathChar == '.') {
+            basePath = referrer.isNull() ? makeString(applicationPath, "/app") : parentPath(referrer);
+        } else if (pathChar == '~') {
+            basePath = makeString(applicationPath, "/app");
+            relativePath = relativePath.substring(2);
+        } else {
+            basePath = makeString(applicationPath, "/app/tns_modules/tns-core-modules");
+            isModuleRequire = true;
+        }
+        computedPath = joinPath(basePath, relativePath);
+    }
+
+    if (!resolveAbsolutePath(bundle, computedPath, cache, readPackageMain, resolved)) {
+        return false;
+    }
+
+    // From https://nodejs.org/api/modules.html:
+    //    require(X) from module at path Y
+    //    1. If X is a core module,
+    //        a. return the core module
+    //        b. STOP
+    //    2. If X begins with '/'
+    //        a. set Y to be the filesystem root
+    //    3. If X begins with './' or '/' or '../'
+    //        a. LOAD_AS_FILE(Y + X)
+    //        b. LOAD_AS_DIRECTORY(Y + X)
+    //    4. LOAD_NODE_MODULES(X, dirname(Y))
+    //    5. THROW "not found"
+    if (!isModuleRequire) {
+        return true;
+    }
+
+    if (resolved.isNull() && !referrer.isNull()) {
+        WTF::String currentSearchPath = parentPath(referrer);
+        do {
+            WTF::String currentNodeModulesPath = makeString(currentSearchPath, "/node_modules");
+            if (statModulePath(bundle, currentNodeModulesPath, S_IFDIR)) {
+                if (!resolveAbsolutePath(bundle, joinPath(currentNodeModulesPath, specifier), cache, readPackageMain, resolved)) {
+                    return false;
+                }
+
+                if (!resolved.isNull()) {
+                    return true;
+                }
+            }
+            currentSearchPath = parentPath(currentSearchPath);
+        } while (currentSearchPath.length() > applicationPath.length());
+    }
+
+    if (resolved.isNull()) {
+        computedPath = joinPath(makeString(applicationPath, "/app/tns_modules"), specifier);
+        return resolveAbsolutePath(bundle, computedPath, cache, readPackageMain, resolved);
+    }
+
+    return true;
+}
+} // namespace NativeScript
@@ -0,0 +1,49 @@
+//
+//  ModulePathResolver.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__ModulePathResolver__
+#define __NativeScript__ModulePathResolver__
+
+#include <functional>
+#include <sys/stat.h>
+#include <wtf/HashMap.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace NativeScript {
+
+class ModuleBundle;
+
+typedef WTF::HashMap<WTF::String, WTF::String, WTF::ASCIICaseInsensitiveHash> ModulePathCache;
+
+/// Reads the "main" field of the package.json at a path and leaves `main` as is when there is none.
+/// Returns false when the file could not be read or parsed. Parsing JSON is left to the platform.
+typedef std::function<bool(const WTF::String& packageJsonPath, WTF::String& main)> PackageMainReader;
+
+// Collapses empty, "." and ".." components. Unlike -[NSString stringByStandardizingPath] it never touches the file system.
+WTF::String normalizePath(WTF::StringView path);
+
+WTF::String joinPath(const WTF::String& directory, WTF::StringView component);
+
+WTF::String parentPath(const WTF::String& path);
+
+// Which of the kinds in `mode` (S_IFREG and S_IFDIR) the entry at `path` is, the module bundle takes precedence over loose files
+mode_t statModulePath(const ModuleBundle*, const WTF::String& path, mode_t mode);
+
+// LOAD_AS_FILE and LOAD_AS_DIRECTORY of the Node.js module resolution. `resolved` is a null string when there is no such module.
+// Returns false, without caching anything, when a package.json on the way could not be read.
+bool resolveAbsolutePath(const ModuleBundle*, const WTF::String& absolutePath, ModulePathCache&, const PackageMainReader&, WTF::String& resolved);
+
+// Resolves a require() or import specifier from the module at `referrer`, a null string for the application's entry point.
+// "./" and "../" are relative to the referrer, "~/" to <applicationPath>/app and other names are looked up in
+// tns-core-modules, the node_modules directories from the referrer up to the application path and then tns_modules.
+// `computedPath` is the last absolute path tried, for reporting a module which is not found, in which case `resolved` is a null string.
+// Returns false when a package.json on the way could not be read.
+bool resolveModuleSpecifier(const ModuleBundle*, const WTF::String& applicationPath, const WTF::String& specifier, const WTF::String& referrer, ModulePathCache&, const PackageMainReader&, WTF::String& resolved, WTF::String& computedPath);
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__ModulePathResolver__) */
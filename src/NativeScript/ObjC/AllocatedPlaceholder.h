@@ -9,6 +9,8 @@
 #ifndef __NativeScript__AllocatedPlaceholder__
 #define __NativeScript__AllocatedPlaceholder__
 
+#include "InteropJSType.h"
+
 namespace NativeScript {
 class AllocatedPlaceholder : public JSC::JSDestructibleObject {
 public:
@@ -23,7 +25,7 @@ public:
     DECLARE_INFO;
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(AllocatedPlaceholderType, StructureFlags), info());
     }
 
     id wrappedObject() const {
@@ -41,6 +41,8 @@ public:
         return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::InternalFunctionType, StructureFlags), info());
     }
 
+    id block() const;
+
 private:
     ObjCBlockWrapper(JSC::VM& vm, JSC::Structure* structure)
         : Base(vm, structure) {
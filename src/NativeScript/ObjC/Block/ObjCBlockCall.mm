@@ -24,15 +24,18 @@ const ClassInfo ObjCBlockWrapper::s_info = { "ObjCBlockWrapper", &Base::s_info,
 void ObjCBlockWrapper::finishCreation(VM& vm, id block, ObjCBlockType* blockType) {
     Base::finishCreation(vm, WTF::emptyString());
 
-    auto parameterTypes = blockType->parameterTypes(vm);
-    Base::initializeFunctionWrapper(vm, parameterTypes.size());
     std::unique_ptr<ObjCBlockCall> call(new ObjCBlockCall(this));
-    call->initializeFFI(vm, { &preInvocation, nullptr }, blockType->returnType(), parameterTypes, 1);
+    Base::initializeFunctionWrapper(vm, blockType->parameterTypeCells().size());
+    call->initializeFFI(vm, { &preInvocation, nullptr }, blockType->returnType(), blockType->parameterTypeCells(), blockType->preparedCall(vm));
     call->_block = adoptNS(Block_copy(block));
 
     this->_functionsContainer.push_back(std::move(call));
 }
 
+id ObjCBlockWrapper::block() const {
+    return static_cast<ObjCBlockCall*>(this->onlyFuncInContainer())->block();
+}
+
 void ObjCBlockWrapper::preInvocation(FFICall* callee, ExecState*, FFICall::Invocation& invocation) {
     ObjCBlockCall* call = static_cast<ObjCBlockCall*>(callee);
 
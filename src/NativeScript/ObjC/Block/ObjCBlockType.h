@@ -9,9 +9,13 @@
 #ifndef __NativeScript__ObjCBlockType__
 #define __NativeScript__ObjCBlockType__
 
+#include "FFICall.h"
 #include "FFIType.h"
+#include "InteropJSType.h"
 
 namespace NativeScript {
+class ObjCBlockWrapper;
+
 class ObjCBlockType : public JSC::JSDestructibleObject {
 public:
     typedef JSC::JSDestructibleObject Base;
@@ -25,7 +29,7 @@ public:
     DECLARE_INFO;
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(ObjCBlockTypeType, StructureFlags), info());
     }
 
     const FFITypeMethodTable& ffiTypeMethodTable() const {
@@ -44,9 +48,18 @@ public:
         return result;
     }
 
+    const WTF::Vector<JSC::WriteBarrier<JSC::JSCell>>& parameterTypeCells() const {
+        return this->_parameterTypes;
+    }
+
+    // The signature, stack layout and argument writes of calls to blocks of this type, which all wrappers
+    // share. Prepared when the first block is read.
+    const FFICall::PreparedCall& preparedCall(JSC::VM&);
+
 private:
     ObjCBlockType(JSC::VM& vm, JSC::Structure* structure)
-        : Base(vm, structure) {
+        : Base(vm, structure)
+        , _wrappers(vm) {
     }
 
     static void destroy(JSC::JSCell* cell) {
@@ -72,6 +85,11 @@ private:
     WTF::Vector<JSC::WriteBarrier<JSCell>> _parameterTypes;
 
     FFITypeMethodTable _ffiTypeMethodTable;
+
+    // Native blocks of this type which are already wrapped, so that reading the same block again is just a lookup
+    JSC::WeakGCMap<id, ObjCBlockWrapper> _wrappers;
+
+    std::shared_ptr<const FFICall::PreparedCall> _preparedCall;
 };
 } // namespace NativeScript
 
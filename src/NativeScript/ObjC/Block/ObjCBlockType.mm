@@ -105,7 +105,27 @@ JSValue ObjCBlockType::read(ExecState* execState, const void* buffer, JSCell* se
         return objCBlockCallback;
     }
 
-    return ObjCBlockWrapper::create(execState->vm(), globalObject->objCBlockWrapperStructure(), block, blockType).get();
+    if (ObjCBlockWrapper* wrapper = blockType->_wrappers.get(block)) {
+        return wrapper;
+    }
+
+    auto wrapper = ObjCBlockWrapper::create(execState->vm(), globalObject->objCBlockWrapperStructure(), block, blockType);
+
+    // Stack blocks are copied to the heap by the wrapper, so their address can be reused by another block
+    // while the wrapper is alive. Only heap and global blocks, which Block_copy returns as is, are cached.
+    if (wrapper->block() == block) {
+        blockType->_wrappers.set(block, wrapper.get());
+    }
+
+    return wrapper.get();
+}
+
+const FFICall::PreparedCall& ObjCBlockType::preparedCall(VM& vm) {
+    if (!this->_preparedCall) {
+        // The block itself is passed as the first argument
+        this->_preparedCall = FFICall::prepare(vm, this->_returnType.get(), this->parameterTypes(vm), 1);
+    }
+    return *this->_preparedCall;
 }
 
 void ObjCBlockType::write(ExecState* execState, const JSValue& value, void* buffer, JSCell* self) {
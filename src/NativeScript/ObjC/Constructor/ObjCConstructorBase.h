@@ -40,6 +40,11 @@ public:
         return this->_ffiTypeMethodTable;
     }
 
+    // Whether values are written with toObject rather than wrapped in a collection adapter
+    bool writesWithToObject() const {
+        return this->_ffiTypeMethodTable.write == &write;
+    }
+
     static WTF::String className(const JSObject* object, JSC::VM&);
 
     const WTF::Vector<JSC::WriteBarrier<ObjCConstructorWrapper>>& initializers(JSC::VM&, GlobalObject*);
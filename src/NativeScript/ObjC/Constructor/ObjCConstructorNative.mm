@@ -104,11 +104,8 @@ void ObjCConstructorNative::getOwnPropertyNames(JSObject* object, ExecState* exe
             }
         }
 
-        for (Array<Metadata::String>::iterator it = baseClassMeta->protocols->begin(); it != baseClassMeta->protocols->end(); it++) {
-            const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
-            if (protocolMeta != nullptr) {
-                baseClassMetaStack.push_back(protocolMeta);
-            }
+        for (const ProtocolMeta* protocolMeta : baseClassMeta->protocolMetas()) {
+            baseClassMetaStack.push_back(protocolMeta);
         }
     }
 
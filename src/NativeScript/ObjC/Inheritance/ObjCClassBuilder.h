@@ -47,6 +47,12 @@ public:
 
     ObjCConstructorDerived* build(JSC::ExecState*);
 
+    // Like build, but leaves the alloc/retain/release overrides out. The caller must invoke
+    // attachDerivedMachinery before the class receives its first message (e.g. from +initialize).
+    ObjCConstructorDerived* buildDeferred(JSC::ExecState*);
+
+    void attachDerivedMachinery(JSC::ExecState*);
+
     Class klass();
 
 private:
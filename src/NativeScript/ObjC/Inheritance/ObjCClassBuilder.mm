@@ -469,16 +469,26 @@ void ObjCClassBuilder::addStaticMethods(ExecState* execState, JSObject* staticMe
 }
 
 ObjCConstructorDerived* ObjCClassBuilder::build(ExecState* execState) {
-    Class klass = this->klass();
+    this->buildDeferred(execState);
+    this->attachDerivedMachinery(execState);
+
+    return this->_constructor.get();
+}
 
+ObjCConstructorDerived* ObjCClassBuilder::buildDeferred(ExecState* execState) {
     GlobalObject* globalObject = jsCast<GlobalObject*>(execState->lexicalGlobalObject());
 
-    globalObject->_objCConstructors.insert({ klass, Strong<ObjCConstructorBase>(execState->vm(), this->_constructor.get()) });
-    attachDerivedMachinery(globalObject, klass, this->_baseConstructor->get(execState, globalObject->vm().propertyNames->prototype));
+    globalObject->_objCConstructors.insert({ this->klass(), Strong<ObjCConstructorBase>(execState->vm(), this->_constructor.get()) });
 
     return this->_constructor.get();
 }
 
+void ObjCClassBuilder::attachDerivedMachinery(ExecState* execState) {
+    GlobalObject* globalObject = jsCast<GlobalObject*>(execState->lexicalGlobalObject());
+
+    NativeScript::attachDerivedMachinery(globalObject, this->klass(), this->_baseConstructor->get(execState, globalObject->vm().propertyNames->prototype));
+}
+
 Class ObjCClassBuilder::klass() {
     return this->_constructor->klass();
 }
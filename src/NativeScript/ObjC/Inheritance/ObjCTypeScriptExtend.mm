@@ -27,24 +27,27 @@ static EncodedJSValue callOriginalExtends(ExecState* execState) {
 }
 
 static bool isPlainTypeScriptConstructor(JSFunction* typeScriptConstructor) {
-    WTF::CString sourceUTF8 = typeScriptConstructor->sourceCode()->view().toString().simplifyWhiteSpace().utf8();
-
-    NSArray* regularExpressions = @[
-        @"^\\(\\)\\s?\\{\\s?\\}$",
-        @"^\\(\\)\\s?\\{\\s?\\w+\\.apply\\(this,\\s?arguments\\);?\\s?\\}$",
-        @"^\\(\\)\\s?\\{\\s?\\w+\\.apply\\(this,\\s?arguments\\)\\s?||\\s?this;?\\s?\\}$"
-    ];
-
-    NSUInteger index = [regularExpressions indexOfObjectPassingTest:^BOOL(id obj, NSUInteger idx, BOOL* stop) {
-      NSRegularExpression* regularExpression = [NSRegularExpression regularExpressionWithPattern:obj
-                                                                                         options:0
-                                                                                           error:nil];
-      return [regularExpression numberOfMatchesInString:@(sourceUTF8.data())
-                                                options:0
-                                                  range:NSMakeRange(0, sourceUTF8.length())]
-             > 0;
-    }];
-    return index != NSNotFound;
+    // Compiled once per process, every TypeScript class extending a native one is matched against these
+    static NSArray<NSRegularExpression*>* regularExpressions;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+      regularExpressions = [@[
+          [NSRegularExpression regularExpressionWithPattern:@"^\\(\\)\\s?\\{\\s?\\}$" options:0 error:nil],
+          [NSRegularExpression regularExpressionWithPattern:@"^\\(\\)\\s?\\{\\s?\\w+\\.apply\\(this,\\s?arguments\\);?\\s?\\}$" options:0 error:nil],
+          [NSRegularExpression regularExpressionWithPattern:@"^\\(\\)\\s?\\{\\s?\\w+\\.apply\\(this,\\s?arguments\\)\\s?||\\s?this;?\\s?\\}$" options:0 error:nil]
+      ] retain];
+    });
+
+    NSString* source = typeScriptConstructor->sourceCode()->view().toString().simplifyWhiteSpace();
+    NSRange range = NSMakeRange(0, source.length);
+
+    for (NSRegularExpression* regularExpression in regularExpressions) {
+        if ([regularExpression numberOfMatchesInString:source options:0 range:range] > 0) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 EncodedJSValue ObjCTypeScriptExtendFunction(ExecState* execState) {
@@ -70,7 +73,7 @@ EncodedJSValue ObjCTypeScriptExtendFunction(ExecState* execState) {
         return JSValue::encode(jsUndefined());
     }
 
-    ObjCConstructorDerived* derivedConstructor = classBuilder->build(execState);
+    ObjCConstructorDerived* derivedConstructor = classBuilder->buildDeferred(execState);
     if (throwScope.exception()) {
         return JSValue::encode(jsUndefined());
     }
@@ -111,8 +114,9 @@ EncodedJSValue ObjCTypeScriptExtendFunction(ExecState* execState) {
     __block Class derivedClass = derivedConstructor->klass();
 
     /// Here we define the static initializer our new inherited native class.
-    /// This new initializer conforms to the provided protocols if any and also
-    /// handles the ObjCExposedMethods logic.
+    /// This new initializer attaches the derived class machinery, conforms to the provided
+    /// protocols if any and also handles the ObjCExposedMethods logic. None of this work is
+    /// done for classes that never receive a message, e.g. ones defined but not yet instantiated.
     IMP newInitialize = imp_implementationWithBlock(^(id self) {
       if (self != [derivedClass self]) {
           return;
@@ -122,6 +126,8 @@ EncodedJSValue ObjCTypeScriptExtendFunction(ExecState* execState) {
 
       ExecState* globalExec = globalObject->globalExec();
 
+      classBuilder->attachDerivedMachinery(globalExec);
+
       JSObject* instanceMethods = jsCast<JSObject*>(derivedConstructor->get(globalExec, globalExec->vm().propertyNames->prototype));
       JSValue implementedProtocols = derivedConstructor->get(globalExec, Identifier::fromString(globalExec, "ObjCProtocols"));
       JSValue exposedMethods = derivedConstructor->get(globalExec, Identifier::fromString(globalExec, "ObjCExposedMethods"));
@@ -9,6 +9,8 @@
 #ifndef __NativeScript__ObjCProtocolObject__
 #define __NativeScript__ObjCProtocolObject__
 
+#include "InteropJSType.h"
+
 namespace Metadata {
 struct ProtocolMeta;
 }
@@ -31,7 +33,7 @@ public:
     }
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(ObjCProtocolWrapperType, StructureFlags), info());
     }
 
     static WTF::String className(const JSObject* object, JSC::VM&);
@@ -206,10 +206,8 @@ void ObjCPrototype::getOwnPropertyNames(JSObject* object, ExecState* execState,
                 propertyNames.add(Identifier::fromString(execState, (*it)->jsName()));
         }
 
-        for (Metadata::Array<Metadata::String>::iterator it = baseClassMeta->protocols->begin(); it != baseClassMeta->protocols->end(); it++) {
-            const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr());
-            if (protocolMeta != nullptr)
-                baseClassMetaStack.push_back(protocolMeta);
+        for (const ProtocolMeta* protocolMeta : baseClassMeta->protocolMetas()) {
+            baseClassMetaStack.push_back(protocolMeta);
         }
     }
 
@@ -9,6 +9,8 @@
 #ifndef NativeScript_ObjCSuperObject_h
 #define NativeScript_ObjCSuperObject_h
 
+#include "InteropJSType.h"
+
 namespace NativeScript {
 class ObjCWrapperObject;
 
@@ -25,7 +27,7 @@ public:
     DECLARE_INFO;
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(ObjCSuperObjectType, StructureFlags), info());
     }
 
     ObjCWrapperObject* wrapperObject() const {
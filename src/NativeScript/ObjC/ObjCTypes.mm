@@ -33,77 +33,85 @@ namespace NativeScript {
 
 id toObject(ExecState* execState, const JSValue& value) {
     VM& vm = execState->vm();
-    if (value.inherits(vm, ObjCWrapperObject::info())) {
-        return jsCast<ObjCWrapperObject*>(value.asCell())->wrappedObject();
-    }
-
-    if (value.inherits(vm, ObjCConstructorBase::info())) {
-        return jsCast<ObjCConstructorBase*>(value.asCell())->klass();
-    }
-
-    if (value.inherits(vm, AllocatedPlaceholder::info())) {
-        return jsCast<AllocatedPlaceholder*>(value.asCell())->wrappedObject();
-    }
-
-    if (value.isUndefinedOrNull()) {
-        return nil;
-    }
-
-    if (value.isInt32()) {
-        return @(value.asInt32());
-    }
-
-    if (value.isUInt32()) {
-        return @(value.asUInt32());
-    }
-
-    if (value.isDouble()) {
-        return @(value.asDouble());
-    }
-
-    if (value.isBoolean()) {
-        return @((BOOL)value.asBoolean());
-    }
-
-    if (value.isString()) {
-        return [[static_cast<NSString*>(jsCast<JSString*>(value)->value(execState)) copy] autorelease];
-    }
-
-    if (JSArray* array = jsDynamicCast<JSArray*>(vm, value)) {
-        return [[[TNSArrayAdapter alloc] initWithJSObject:array
-                                                execState:execState->lexicalGlobalObject()->globalExec()] autorelease];
-    }
 
-    if (value.inherits(vm, ObjCSuperObject::info())) {
-        return jsCast<ObjCSuperObject*>(value.asCell())->wrapperObject()->wrappedObject();
-    }
+    if (!value.isCell()) {
+        if (value.isUndefinedOrNull()) {
+            return nil;
+        }
 
-    if (value.inherits(vm, DateInstance::info())) {
-        return [NSDate dateWithTimeIntervalSince1970:(value.toNumber(execState) / 1000)];
-    }
+        if (value.isInt32()) {
+            return @(value.asInt32());
+        }
 
-    if (value.inherits(vm, JSArrayBuffer::info()) || value.inherits(vm, JSArrayBufferView::info())) {
-        return [[[TNSDataAdapter alloc] initWithJSObject:asObject(value)
-                                               execState:execState->lexicalGlobalObject()->globalExec()] autorelease];
-    }
+        if (value.isUInt32()) {
+            return @(value.asUInt32());
+        }
 
-    bool hasHandle;
-    void* handle = tryHandleofValue(vm, value, &hasHandle);
-    if (hasHandle) {
-        return static_cast<id>(handle);
-    }
+        if (value.isDouble()) {
+            return @(value.asDouble());
+        }
 
-    if (value.isCell()) {
-        JSCell* wrapper = value.asCell();
-        const ClassInfo* wrapperInfo = wrapper->classInfo(vm);
-        if (wrapperInfo == StringObject::info() || wrapperInfo == NumberObject::info() || wrapperInfo == BooleanObject::info()) {
-            return toObject(execState, jsCast<JSWrapperObject*>(value)->internalValue());
+        if (value.isBoolean()) {
+            return @((BOOL)value.asBoolean());
+        }
+    } else {
+        JSCell* cell = value.asCell();
+        switch (static_cast<uint8_t>(cell->type())) {
+        case StringType:
+            return [[static_cast<NSString*>(jsCast<JSString*>(cell)->value(execState)) copy] autorelease];
+        case ObjCWrapperObjectType:
+            return jsCast<ObjCWrapperObject*>(cell)->wrappedObject();
+        case AllocatedPlaceholderType:
+            return jsCast<AllocatedPlaceholder*>(cell)->wrappedObject();
+        case ObjCSuperObjectType:
+            return jsCast<ObjCSuperObject*>(cell)->wrapperObject()->wrappedObject();
+        case ArrayType:
+        case DerivedArrayType:
+            return [[[TNSArrayAdapter alloc] initWithJSObject:asObject(cell)
+                                                    execState:execState->lexicalGlobalObject()->globalExec()] autorelease];
+        case ArrayBufferType:
+        case Int8ArrayType:
+        case Uint8ArrayType:
+        case Uint8ClampedArrayType:
+        case Int16ArrayType:
+        case Uint16ArrayType:
+        case Int32ArrayType:
+        case Uint32ArrayType:
+        case Float32ArrayType:
+        case Float64ArrayType:
+        case DataViewType:
+            return [[[TNSDataAdapter alloc] initWithJSObject:asObject(cell)
+                                                   execState:execState->lexicalGlobalObject()->globalExec()] autorelease];
+        case InternalFunctionType:
+        case ObjCProtocolWrapperType:
+        case RecordInstanceType:
+        case PointerInstanceType:
+        case ReferenceInstanceType:
+        case IndexedRefInstanceType: {
+            bool hasHandle;
+            void* handle = tryHandleofValue(vm, value, &hasHandle);
+            if (hasHandle) {
+                return static_cast<id>(handle);
+            }
+            break;
+        }
+        default: {
+            const ClassInfo* classInfo = cell->classInfo(vm);
+            if (classInfo == DateInstance::info()) {
+                return [NSDate dateWithTimeIntervalSince1970:(value.toNumber(execState) / 1000)];
+            }
+
+            if (classInfo == StringObject::info() || classInfo == NumberObject::info() || classInfo == BooleanObject::info()) {
+                return toObject(execState, jsCast<JSWrapperObject*>(cell)->internalValue());
+            }
+            break;
+        }
         }
-    }
 
-    if (JSObject* object = jsDynamicCast<JSObject*>(vm, value)) {
-        return [[[TNSDictionaryAdapter alloc] initWithJSObject:object
-                                                     execState:execState->lexicalGlobalObject()->globalExec()] autorelease];
+        if (cell->isObject()) {
+            return [[[TNSDictionaryAdapter alloc] initWithJSObject:asObject(cell)
+                                                         execState:execState->lexicalGlobalObject()->globalExec()] autorelease];
+        }
     }
 
     auto scope = DECLARE_THROW_SCOPE(vm);
@@ -9,6 +9,7 @@
 #ifndef __NativeScript__ObjCWrapperObject__
 #define __NativeScript__ObjCWrapperObject__
 
+#include "InteropJSType.h"
 #include <JavaScriptCore/JSObject.h>
 #include <wtf/RetainPtr.h>
 
@@ -26,7 +27,7 @@ public:
     DECLARE_INFO;
 
     static JSC::Structure* createStructure(JSC::VM& vm, JSC::JSGlobalObject* globalObject, JSC::JSValue prototype) {
-        return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
+        return JSC::Structure::create(vm, globalObject, prototype, interopTypeInfo(ObjCWrapperObjectType, StructureFlags), info());
     }
 
     id wrappedObject() const {
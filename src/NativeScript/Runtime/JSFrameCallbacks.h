@@ -0,0 +1,82 @@
+//
+//  JSFrameCallbacks.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__JSFrameCallbacks__
+#define __NativeScript__JSFrameCallbacks__
+
+#include <JavaScriptCore/JSCJSValue.h>
+#include <JavaScriptCore/Strong.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/RetainPtr.h>
+#include <wtf/Vector.h>
+
+@class CADisplayLink;
+@class NSRunLoop;
+@class NSString;
+@class TNSFrameCallbacksTarget;
+
+namespace NativeScript {
+class GlobalObject;
+
+/// requestAnimationFrame/cancelAnimationFrame for a GlobalObject.
+///
+/// A single CADisplayLink, paused while there are no requests, is scheduled in the run loops of the runtime.
+/// It is created on the first request, so runtimes which never request a frame never create one.
+/// On every frame all callbacks requested before the frame are invoked inside one VM entry with the same
+/// timestamp, and the microtask queue is drained once after the last of them.
+class JSFrameCallbacks {
+    WTF_MAKE_NONCOPYABLE(JSFrameCallbacks);
+    WTF_MAKE_FAST_ALLOCATED;
+
+public:
+    explicit JSFrameCallbacks(GlobalObject*);
+
+    ~JSFrameCallbacks();
+
+    void scheduleInRunLoop(NSRunLoop*, NSString* mode);
+
+    void removeFromRunLoop(NSRunLoop*, NSString* mode);
+
+    // __requestAnimationFrame(callback), the callback is invoked with the frame timestamp in milliseconds
+    static JSC::EncodedJSValue JSC_HOST_CALL requestAnimationFrame(JSC::ExecState*);
+
+    // __cancelAnimationFrame(id)
+    static JSC::EncodedJSValue JSC_HOST_CALL cancelAnimationFrame(JSC::ExecState*);
+
+    void dispatchFrame(double timestamp);
+
+private:
+    struct FrameCallback {
+        unsigned id;
+        JSC::Strong<JSC::Unknown> function;
+    };
+
+    struct RunLoopMode {
+        WTF::RetainPtr<NSRunLoop> runLoop;
+        WTF::RetainPtr<NSString> mode;
+    };
+
+    static bool cancel(WTF::Vector<FrameCallback>&, unsigned id);
+
+    CADisplayLink* displayLink();
+
+    GlobalObject* _globalObject;
+    WTF::RetainPtr<TNSFrameCallbacksTarget> _target;
+    WTF::RetainPtr<CADisplayLink> _displayLink;
+    // Where the display link is added once it is created
+    WTF::Vector<RunLoopMode> _runLoopModes;
+    unsigned _lastId;
+    bool _isDispatching;
+
+    WTF::Vector<FrameCallback> _callbacks;
+    // The callbacks of the frame being dispatched, callbacks requested meanwhile go to the next frame
+    WTF::Vector<FrameCallback> _dispatchedCallbacks;
+};
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__JSFrameCallbacks__) */
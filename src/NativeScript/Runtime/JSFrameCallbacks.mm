@@ -0,0 +1,167 @@
+//
+//  JSFrameCallbacks.mm
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "JSFrameCallbacks.h"
+#include "JSErrors.h"
+#import <QuartzCore/CADisplayLink.h>
+#include <wtf/SetForScope.h>
+
+using namespace JSC;
+using namespace NativeScript;
+
+// CADisplayLink retains its target, so the target refers back to the callbacks weakly.
+// It is detached when the callbacks are destroyed, in case a frame is delivered afterwards.
+@interface TNSFrameCallbacksTarget : NSObject
+- (instancetype)initWithFrameCallbacks:(JSFrameCallbacks*)frameCallbacks;
+- (void)detach;
+- (void)onFrame:(CADisplayLink*)displayLink;
+@end
+
+@implementation TNSFrameCallbacksTarget {
+    JSFrameCallbacks* _frameCallbacks;
+}
+
+- (instancetype)initWithFrameCallbacks:(JSFrameCallbacks*)frameCallbacks {
+    if (self = [super init]) {
+        self->_frameCallbacks = frameCallbacks;
+    }
+
+    return self;
+}
+
+- (void)detach {
+    self->_frameCallbacks = nullptr;
+}
+
+- (void)onFrame:(CADisplayLink*)displayLink {
+    if (self->_frameCallbacks) {
+        self->_frameCallbacks->dispatchFrame(displayLink.timestamp * 1000);
+    }
+}
+
+@end
+
+namespace NativeScript {
+
+JSFrameCallbacks::JSFrameCallbacks(GlobalObject* globalObject)
+    : _globalObject(globalObject)
+    , _lastId(0)
+    , _isDispatching(false) {
+}
+
+JSFrameCallbacks::~JSFrameCallbacks() {
+    [this->_target.get() detach];
+    [this->_displayLink.get() invalidate];
+}
+
+CADisplayLink* JSFrameCallbacks::displayLink() {
+    if (!this->_displayLink) {
+        this->_target = adoptNS([[TNSFrameCallbacksTarget alloc] initWithFrameCallbacks:this]);
+        this->_displayLink = [CADisplayLink displayLinkWithTarget:this->_target.get() selector:@selector(onFrame:)];
+        for (const RunLoopMode& runLoopMode : this->_runLoopModes) {
+            [this->_displayLink.get() addToRunLoop:runLoopMode.runLoop.get() forMode:runLoopMode.mode.get()];
+        }
+    }
+
+    return this->_displayLink.get();
+}
+
+void JSFrameCallbacks::scheduleInRunLoop(NSRunLoop* runLoop, NSString* mode) {
+    this->_runLoopModes.append({ runLoop, mode });
+    [this->_displayLink.get() addToRunLoop:runLoop forMode:mode];
+}
+
+void JSFrameCallbacks::removeFromRunLoop(NSRunLoop* runLoop, NSString* mode) {
+    this->_runLoopModes.removeFirstMatching([&](const RunLoopMode& runLoopMode) {
+        return runLoopMode.runLoop.get() == runLoop && [runLoopMode.mode.get() isEqualToString:mode];
+    });
+    [this->_displayLink.get() removeFromRunLoop:runLoop forMode:mode];
+}
+
+EncodedJSValue JSC_HOST_CALL JSFrameCallbacks::requestAnimationFrame(ExecState* execState) {
+    VM& vm = execState->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    JSValue function = execState->argument(0);
+    CallData callData;
+    if (getCallData(vm, function, callData) == CallType::None) {
+        return throwVMTypeError(execState, scope, "Frame callback is not a function."_s);
+    }
+
+    JSFrameCallbacks& frameCallbacks = jsCast<GlobalObject*>(execState->lexicalGlobalObject())->frameCallbacks();
+    unsigned id = ++frameCallbacks._lastId;
+    frameCallbacks._callbacks.append({ id, Strong<Unknown>(vm, function) });
+    frameCallbacks.displayLink().paused = NO;
+
+    return JSValue::encode(jsNumber(id));
+}
+
+EncodedJSValue JSC_HOST_CALL JSFrameCallbacks::cancelAnimationFrame(ExecState* execState) {
+    JSValue idValue = execState->argument(0);
+    if (!idValue.isUInt32()) {
+        return JSValue::encode(jsUndefined());
+    }
+
+    // A callback cancelled by an earlier callback of the same frame must not be invoked either
+    JSFrameCallbacks& frameCallbacks = jsCast<GlobalObject*>(execState->lexicalGlobalObject())->frameCallbacks();
+    if (!cancel(frameCallbacks._callbacks, idValue.asUInt32())) {
+        cancel(frameCallbacks._dispatchedCallbacks, idValue.asUInt32());
+    }
+
+    return JSValue::encode(jsUndefined());
+}
+
+bool JSFrameCallbacks::cancel(WTF::Vector<FrameCallback>& callbacks, unsigned id) {
+    for (FrameCallback& callback : callbacks) {
+        if (callback.id == id) {
+            callback.function.clear();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JSFrameCallbacks::dispatchFrame(double timestamp) {
+    // A callback may spin a nested run loop, frames are skipped until it returns
+    if (this->_isDispatching) {
+        return;
+    }
+
+    SetForScope<bool> isDispatching(this->_isDispatching, true);
+    this->_dispatchedCallbacks.swap(this->_callbacks);
+
+    VM& vm = this->_globalObject->vm();
+    JSLockHolder lock(vm);
+    ExecState* execState = this->_globalObject->globalExec();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    MarkedArgumentBuffer arguments;
+    arguments.append(jsNumber(timestamp));
+
+    for (size_t i = 0; i < this->_dispatchedCallbacks.size(); i++) {
+        JSValue function = this->_dispatchedCallbacks[i].function.get();
+        if (!function) {
+            continue;
+        }
+
+        CallData callData;
+        CallType callType = getCallData(vm, function, callData);
+        call(execState, function, callType, callData, jsUndefined(), arguments);
+        reportErrorIfAny(execState, scope);
+    }
+
+    this->_dispatchedCallbacks.clear();
+
+    this->_globalObject->drainMicrotasks();
+    reportErrorIfAny(execState, scope);
+
+    if (this->_callbacks.isEmpty()) {
+        this->_displayLink.get().paused = YES;
+    }
+}
+} // namespace NativeScript
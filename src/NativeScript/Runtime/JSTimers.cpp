@@ -0,0 +1,162 @@
+//
+//  JSTimers.cpp
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "JSTimers.h"
+#include "JSErrors.h"
+
+namespace NativeScript {
+using namespace JSC;
+
+static const CFTimeInterval distantFuture = std::numeric_limits<CFTimeInterval>::max();
+
+// Keeps setInterval(callback, 0) from firing on every run loop iteration
+static const CFTimeInterval minimumRepeatInterval = 0.001;
+
+JSTimers::JSTimers(GlobalObject* globalObject)
+    : _globalObject(globalObject)
+    , _runLoopTimerFireDate(distantFuture)
+    , _runLoopModesCount(0) {
+    // The run loop timer is never invalidated by firing, it is only rescheduled to the next pending timer
+    CFRunLoopTimerContext context = { 0, this, nullptr, nullptr, nullptr };
+    this->_runLoopTimer = adoptCF(CFRunLoopTimerCreate(kCFAllocatorDefault, distantFuture, distantFuture, 0, 0, &runLoopTimerFired, &context));
+}
+
+JSTimers::~JSTimers() {
+    CFRunLoopTimerInvalidate(this->_runLoopTimer.get());
+}
+
+void JSTimers::scheduleInRunLoop(CFRunLoopRef runLoop, CFStringRef mode) {
+    if (this->_runLoop && this->_runLoop.get() != runLoop) {
+        ASSERT_NOT_REACHED();
+        return;
+    }
+
+    if (CFRunLoopContainsTimer(runLoop, this->_runLoopTimer.get(), mode)) {
+        return;
+    }
+
+    CFRunLoopAddTimer(runLoop, this->_runLoopTimer.get(), mode);
+    this->_runLoop = runLoop;
+    this->_runLoopModesCount++;
+}
+
+void JSTimers::removeFromRunLoop(CFRunLoopRef runLoop, CFStringRef mode) {
+    if (this->_runLoop.get() != runLoop || !CFRunLoopContainsTimer(runLoop, this->_runLoopTimer.get(), mode)) {
+        return;
+    }
+
+    CFRunLoopRemoveTimer(runLoop, this->_runLoopTimer.get(), mode);
+    if (--this->_runLoopModesCount == 0) {
+        this->_runLoop = nullptr;
+    }
+}
+
+EncodedJSValue JSC_HOST_CALL JSTimers::setTimeout(ExecState* execState) {
+    return schedule(execState, false);
+}
+
+EncodedJSValue JSC_HOST_CALL JSTimers::setInterval(ExecState* execState) {
+    return schedule(execState, true);
+}
+
+EncodedJSValue JSC_HOST_CALL JSTimers::clearTimer(ExecState* execState) {
+    JSValue idValue = execState->argument(0);
+    if (!idValue.isNumber()) {
+        return JSValue::encode(jsUndefined());
+    }
+
+    double id = idValue.asNumber();
+    if (id != static_cast<TimerQueue::TimerId>(id)) {
+        return JSValue::encode(jsUndefined());
+    }
+
+    JSTimers& timers = jsCast<GlobalObject*>(execState->lexicalGlobalObject())->timers();
+    if (timers._queue.cancel(static_cast<TimerQueue::TimerId>(id))) {
+        timers._callbacks.erase(static_cast<TimerQueue::TimerId>(id));
+    }
+
+    // The run loop timer is left as is, waking up once with nothing to do is cheaper than rescheduling it
+    return JSValue::encode(jsUndefined());
+}
+
+EncodedJSValue JSTimers::schedule(ExecState* execState, bool repeats) {
+    VM& vm = execState->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    JSValue function = execState->argument(0);
+    CallData callData;
+    if (getCallData(vm, function, callData) == CallType::None) {
+        return throwVMTypeError(execState, scope, "Timer callback is not a function."_s);
+    }
+
+    double milliseconds = execState->argument(1).toNumber(execState);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    CFTimeInterval delay = milliseconds > 0 ? milliseconds / 1000 : 0;
+
+    TimerCallback callback;
+    callback.function.set(vm, function);
+    for (size_t i = 2; i < execState->argumentCount(); i++) {
+        callback.arguments.append(Strong<Unknown>(vm, execState->uncheckedArgument(i)));
+    }
+
+    JSTimers& timers = jsCast<GlobalObject*>(execState->lexicalGlobalObject())->timers();
+    CFAbsoluteTime fireDate = CFAbsoluteTimeGetCurrent() + delay;
+    TimerQueue::TimerId id = timers._queue.schedule(fireDate, repeats ? std::max(delay, minimumRepeatInterval) : 0);
+    timers._callbacks.emplace(id, WTFMove(callback));
+
+    if (fireDate < timers._runLoopTimerFireDate) {
+        timers._runLoopTimerFireDate = fireDate;
+        CFRunLoopTimerSetNextFireDate(timers._runLoopTimer.get(), fireDate);
+    }
+
+    return JSValue::encode(jsNumber(id));
+}
+
+void JSTimers::runLoopTimerFired(CFRunLoopTimerRef, void* info) {
+    static_cast<JSTimers*>(info)->fireExpiredTimers();
+}
+
+void JSTimers::fireExpiredTimers() {
+    VM& vm = this->_globalObject->vm();
+    JSLockHolder lock(vm);
+    ExecState* execState = this->_globalObject->globalExec();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    this->_queue.beginBatch(CFAbsoluteTimeGetCurrent());
+
+    TimerQueue::TimerId id;
+    while (this->_queue.takeExpired(id)) {
+        auto it = this->_callbacks.find(id);
+        ASSERT(it != this->_callbacks.end());
+
+        // The callback may clear its own timer, so copy out what is needed for the call
+        // before a fired one-shot timer is forgotten.
+        JSValue function = it->second.function.get();
+        MarkedArgumentBuffer arguments;
+        for (const Strong<Unknown>& argument : it->second.arguments) {
+            arguments.append(argument.get());
+        }
+
+        if (!this->_queue.contains(id)) {
+            this->_callbacks.erase(it);
+        }
+
+        CallData callData;
+        CallType callType = getCallData(vm, function, callData);
+        call(execState, function, callType, callData, jsUndefined(), arguments);
+        reportErrorIfAny(execState, scope);
+    }
+
+    this->updateRunLoopTimer();
+}
+
+void JSTimers::updateRunLoopTimer() {
+    double nextFireTime = this->_queue.nextFireTime();
+    this->_runLoopTimerFireDate = std::isinf(nextFireTime) ? distantFuture : nextFireTime;
+    CFRunLoopTimerSetNextFireDate(this->_runLoopTimer.get(), this->_runLoopTimerFireDate);
+}
+} // namespace NativeScript
@@ -0,0 +1,79 @@
+//
+//  JSTimers.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__JSTimers__
+#define __NativeScript__JSTimers__
+
+#include "TimerQueue.h"
+#include <CoreFoundation/CoreFoundation.h>
+#include <JavaScriptCore/JSCJSValue.h>
+#include <JavaScriptCore/Strong.h>
+#include <unordered_map>
+#include <wtf/FastMalloc.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/RetainPtr.h>
+#include <wtf/Vector.h>
+
+namespace NativeScript {
+class GlobalObject;
+
+/// Native setTimeout/setInterval for a GlobalObject.
+///
+/// All timers of a global object share a single CFRunLoopTimer, which is scheduled in the run loops of the
+/// runtime together with its microtask source and is always set to fire at the earliest pending timer.
+/// When it fires, every expired timer is run inside a single JSLockHolder scope.
+///
+/// A CFRunLoopTimer can be added to a single run loop only (in any number of its modes), so the timers of a
+/// runtime fire on the first run loop it is scheduled in and scheduling it in another one is ignored.
+class JSTimers {
+    WTF_MAKE_NONCOPYABLE(JSTimers);
+    WTF_MAKE_FAST_ALLOCATED;
+
+public:
+    explicit JSTimers(GlobalObject*);
+
+    ~JSTimers();
+
+    void scheduleInRunLoop(CFRunLoopRef, CFStringRef mode);
+
+    void removeFromRunLoop(CFRunLoopRef, CFStringRef mode);
+
+    // __setTimeout(callback, milliseconds, ...arguments)
+    static JSC::EncodedJSValue JSC_HOST_CALL setTimeout(JSC::ExecState*);
+
+    // __setInterval(callback, milliseconds, ...arguments)
+    static JSC::EncodedJSValue JSC_HOST_CALL setInterval(JSC::ExecState*);
+
+    // __clearTimeout(id) and __clearInterval(id)
+    static JSC::EncodedJSValue JSC_HOST_CALL clearTimer(JSC::ExecState*);
+
+private:
+    struct TimerCallback {
+        JSC::Strong<JSC::Unknown> function;
+        WTF::Vector<JSC::Strong<JSC::Unknown>> arguments;
+    };
+
+    static JSC::EncodedJSValue schedule(JSC::ExecState*, bool repeats);
+
+    static void runLoopTimerFired(CFRunLoopTimerRef, void* info);
+
+    void fireExpiredTimers();
+
+    void updateRunLoopTimer();
+
+    GlobalObject* _globalObject;
+    TimerQueue _queue;
+    std::unordered_map<TimerQueue::TimerId, TimerCallback> _callbacks;
+    WTF::RetainPtr<CFRunLoopTimerRef> _runLoopTimer;
+    // The run loop the timer is added to and in how many of its modes
+    WTF::RetainPtr<CFRunLoopRef> _runLoop;
+    unsigned _runLoopModesCount;
+    CFAbsoluteTime _runLoopTimerFireDate;
+};
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__JSTimers__) */
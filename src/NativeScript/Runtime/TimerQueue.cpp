@@ -0,0 +1,120 @@
+//
+//  TimerQueue.cpp
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "TimerQueue.h"
+#include <algorithm>
+#include <functional>
+
+namespace NativeScript {
+
+TimerQueue::TimerId TimerQueue::schedule(double fireTime, double interval) {
+    // Ids are handed out to JavaScript, skip 0 and ids which are still in use after a wrap around
+    do {
+        this->_lastId++;
+    } while (this->_lastId == 0 || this->contains(this->_lastId));
+
+    TimerId id = this->_lastId;
+    Timer& timer = this->_timers[id];
+    timer.interval = std::max(interval, 0.0);
+    this->push(fireTime, id, timer);
+
+    return id;
+}
+
+bool TimerQueue::cancel(TimerId id) {
+    // The heap entry becomes stale and is dropped when it surfaces
+    if (!this->_timers.erase(id)) {
+        return false;
+    }
+
+    this->compactIfNeeded();
+    return true;
+}
+
+double TimerQueue::nextFireTime() {
+    this->endBatch();
+    this->popStaleEntries();
+    return this->_heap.empty() ? std::numeric_limits<double>::infinity() : this->_heap.front().fireTime;
+}
+
+void TimerQueue::beginBatch(double now) {
+    this->endBatch();
+    this->_isInBatch = true;
+    this->_batchTime = now;
+}
+
+bool TimerQueue::takeExpired(TimerId& id) {
+    if (!this->_isInBatch) {
+        return false;
+    }
+
+    this->popStaleEntries();
+    if (this->_heap.empty() || this->_heap.front().fireTime > this->_batchTime) {
+        this->endBatch();
+        return false;
+    }
+
+    id = this->_heap.front().id;
+    std::pop_heap(this->_heap.begin(), this->_heap.end(), std::greater<HeapEntry>());
+    this->_heap.pop_back();
+
+    auto it = this->_timers.find(id);
+    if (it->second.interval > 0) {
+        this->push(this->_batchTime + it->second.interval, id, it->second);
+    } else {
+        this->_timers.erase(it);
+    }
+
+    return true;
+}
+
+bool TimerQueue::isLive(const HeapEntry& entry) const {
+    auto it = this->_timers.find(entry.id);
+    return it != this->_timers.end() && it->second.sequence == entry.sequence;
+}
+
+void TimerQueue::push(double fireTime, TimerId id, Timer& timer) {
+    timer.sequence = this->_nextSequence++;
+    if (this->_isInBatch) {
+        this->_scheduledInBatch.push_back({ fireTime, timer.sequence, id });
+        return;
+    }
+
+    this->_heap.push_back({ fireTime, timer.sequence, id });
+    std::push_heap(this->_heap.begin(), this->_heap.end(), std::greater<HeapEntry>());
+}
+
+void TimerQueue::endBatch() {
+    this->_isInBatch = false;
+    for (const HeapEntry& entry : this->_scheduledInBatch) {
+        this->_heap.push_back(entry);
+        std::push_heap(this->_heap.begin(), this->_heap.end(), std::greater<HeapEntry>());
+    }
+    this->_scheduledInBatch.clear();
+}
+
+void TimerQueue::popStaleEntries() {
+    while (!this->_heap.empty() && !this->isLive(this->_heap.front())) {
+        std::pop_heap(this->_heap.begin(), this->_heap.end(), std::greater<HeapEntry>());
+        this->_heap.pop_back();
+    }
+}
+
+void TimerQueue::compactIfNeeded() {
+    // Cancelled timers deep in the heap would otherwise accumulate when timers are
+    // routinely cleared before they fire, e.g. debouncing.
+    if (this->_heap.size() < 64 || this->_heap.size() < 2 * this->_timers.size()) {
+        return;
+    }
+
+    this->_heap.erase(std::remove_if(this->_heap.begin(), this->_heap.end(), [this](const HeapEntry& entry) {
+                          return !this->isLive(entry);
+                      }),
+                      this->_heap.end());
+    std::make_heap(this->_heap.begin(), this->_heap.end(), std::greater<HeapEntry>());
+}
+} // namespace NativeScript
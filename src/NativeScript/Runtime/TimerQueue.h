@@ -0,0 +1,102 @@
+//
+//  TimerQueue.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__TimerQueue__
+#define __NativeScript__TimerQueue__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace NativeScript {
+
+/// Bookkeeping for setTimeout/setInterval style timers, independent of any run loop or JavaScript engine.
+///
+/// Pending timers are kept in a binary min-heap ordered by fire time and then by scheduling order, so timers
+/// due at the same time fire in the order they were scheduled. Cancelled timers are dropped lazily when they
+/// reach the top of the heap, which keeps both schedule() and cancel() at O(log n) and O(1) respectively.
+///
+/// Expired timers are consumed in batches:
+///
+///     queue.beginBatch(now);
+///     while (queue.takeExpired(id)) { ... run the callback of `id` ... }
+///
+/// Timers scheduled while a batch is being consumed never fire in the same batch, even if they are already due.
+/// Times are plain doubles in whatever unit the owner uses.
+class TimerQueue {
+public:
+    typedef uint32_t TimerId;
+
+    /// Schedules a timer to fire at `fireTime`. A positive `interval` makes it fire repeatedly every `interval`
+    /// after each expiration until it is cancelled. Returns an id greater than 0.
+    TimerId schedule(double fireTime, double interval = 0);
+
+    /// Returns false if there is no such pending timer, e.g. a one-shot timer which has already fired.
+    bool cancel(TimerId);
+
+    bool contains(TimerId id) const {
+        return this->_timers.find(id) != this->_timers.end();
+    }
+
+    size_t size() const {
+        return this->_timers.size();
+    }
+
+    bool isEmpty() const {
+        return this->_timers.empty();
+    }
+
+    /// Returns the fire time of the earliest pending timer, or infinity if there are none.
+    double nextFireTime();
+
+    void beginBatch(double now);
+
+    /// Takes the next timer of the current batch. Repeating timers are rescheduled relative to the batch time.
+    /// Returns false and ends the batch when there are no more expired timers.
+    bool takeExpired(TimerId& id);
+
+private:
+    // Inspects the heap and wraps the ids around in tests/Benchmarks
+    friend class TimerQueueTests;
+
+    struct Timer {
+        double interval;
+        uint64_t sequence;
+    };
+
+    struct HeapEntry {
+        double fireTime;
+        uint64_t sequence;
+        TimerId id;
+
+        bool operator>(const HeapEntry& other) const {
+            return fireTime > other.fireTime || (fireTime == other.fireTime && sequence > other.sequence);
+        }
+    };
+
+    bool isLive(const HeapEntry&) const;
+    void push(double fireTime, TimerId, Timer&);
+    void endBatch();
+    void popStaleEntries();
+    void compactIfNeeded();
+
+    std::unordered_map<TimerId, Timer> _timers;
+    std::vector<HeapEntry> _heap;
+
+    TimerId _lastId = 0;
+    uint64_t _nextSequence = 0;
+
+    bool _isInBatch = false;
+    double _batchTime = 0;
+    // Timers (re)scheduled during a batch, kept out of the heap until the batch ends
+    std::vector<HeapEntry> _scheduledInBatch;
+};
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__TimerQueue__) */
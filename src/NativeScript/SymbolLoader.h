@@ -9,11 +9,7 @@
 #ifndef __NativeScript__SymbolLoader__
 #define __NativeScript__SymbolLoader__
 
-#include <map>
-
-namespace Metadata {
-struct ModuleMeta;
-}
+#include "SymbolResolverCache.h"
 
 namespace NativeScript {
 class SymbolResolver;
@@ -26,10 +22,13 @@ public:
     void* loadDataSymbol(const Metadata::ModuleMeta*, const char* symbolName);
     bool ensureModule(const Metadata::ModuleMeta*);
 
+    SymbolLoader();
+
 private:
     SymbolResolver* resolveModule(const Metadata::ModuleMeta*);
+    static std::unique_ptr<SymbolResolver> createResolver(const Metadata::ModuleMeta*);
 
-    std::map<const Metadata::ModuleMeta*, std::unique_ptr<SymbolResolver>> _cache;
+    SymbolResolverCache<SymbolResolver> _resolvers;
 };
 } // namespace NativeScript
 
@@ -57,6 +57,11 @@ public:
         : _libraryHandle(libraryHandle) {
     }
 
+    // Only resolvers which lost a race to be cached are ever destroyed
+    virtual ~DlSymbolResolver() override {
+        dlclose(this->_libraryHandle);
+    }
+
     virtual void* loadFunctionSymbol(const char* symbolName) override {
         return dlsym(this->_libraryHandle, symbolName);
     }
@@ -78,16 +83,18 @@ SymbolLoader& SymbolLoader::instance() {
     return loader;
 }
 
+SymbolLoader::SymbolLoader() {
+}
+
 SymbolResolver* SymbolLoader::resolveModule(const Metadata::ModuleMeta* module) {
     if (!module) {
         return nullptr;
     }
 
-    auto it = this->_cache.find(module);
-    if (it != this->_cache.end()) {
-        return it->second.get();
-    }
+    return this->_resolvers.resolve(module, [module]() { return createResolver(module); });
+}
 
+std::unique_ptr<SymbolResolver> SymbolLoader::createResolver(const Metadata::ModuleMeta* module) {
     tns::instrumentation::Frame frame;
 
     std::unique_ptr<SymbolResolver> resolver;
@@ -133,7 +140,7 @@ SymbolResolver* SymbolLoader::resolveModule(const Metadata::ModuleMeta* module)
         frame.log([@"resolveModule: " stringByAppendingString:[NSString stringWithUTF8String:module->getName()]].UTF8String);
     }
 
-    return this->_cache.emplace(module, std::move(resolver)).first->second.get();
+    return resolver;
 }
 
 void* SymbolLoader::loadFunctionSymbol(const Metadata::ModuleMeta* module, const char* symbolName) {
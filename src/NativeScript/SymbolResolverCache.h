@@ -0,0 +1,95 @@
+//
+//  SymbolResolverCache.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__SymbolResolverCache__
+#define __NativeScript__SymbolResolverCache__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Metadata {
+struct ModuleMeta;
+}
+
+namespace NativeScript {
+
+/// The resolvers of the modules which have been loaded, shared by the main and worker runtimes.
+///
+/// An insert-only hash table with a fixed number of buckets, each a list of entries pushed to its head with
+/// a compare-and-swap. Lookups never lock and entries live as long as the cache, so memory grows with the
+/// number of modules only. Modules without a resolver are cached as well.
+template <typename Resolver>
+class SymbolResolverCache {
+public:
+    SymbolResolverCache()
+        : _buckets() {
+    }
+
+    ~SymbolResolverCache() {
+        for (std::atomic<Entry*>& bucket : this->_buckets) {
+            for (Entry* entry = bucket.load(std::memory_order_relaxed); entry != nullptr;) {
+                delete std::exchange(entry, entry->next);
+            }
+        }
+    }
+
+    SymbolResolverCache(const SymbolResolverCache&) = delete;
+    SymbolResolverCache& operator=(const SymbolResolverCache&) = delete;
+
+    /// Returns the resolver of \p module, creating it with \p create on first use.
+    ///
+    /// \p create runs without any lock held as it may load a library. Threads which resolve the same module
+    /// at the same time may each create a resolver, only the first one to be published is kept.
+    template <typename Create>
+    Resolver* resolve(const Metadata::ModuleMeta* module, const Create& create) {
+        std::atomic<Entry*>& bucket = this->bucket(module);
+        Entry* head = bucket.load(std::memory_order_acquire);
+        if (Entry* entry = find(head, module)) {
+            return entry->resolver.get();
+        }
+
+        std::unique_ptr<Entry> entry(new Entry{ module, create(), nullptr });
+        while (true) {
+            entry->next = head;
+            if (bucket.compare_exchange_weak(head, entry.get(), std::memory_order_release, std::memory_order_acquire)) {
+                return entry.release()->resolver.get();
+            }
+
+            if (Entry* published = find(head, module)) {
+                return published->resolver.get();
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        const Metadata::ModuleMeta* module;
+        std::unique_ptr<Resolver> resolver;
+        Entry* next;
+    };
+
+    static const size_t bucketsCountLog2 = 8;
+
+    std::atomic<Entry*>& bucket(const Metadata::ModuleMeta* module) {
+        uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(module)) * 0x9E3779B97F4A7C15ull;
+        return this->_buckets[hash >> (64 - bucketsCountLog2)];
+    }
+
+    static Entry* find(Entry* entry, const Metadata::ModuleMeta* module) {
+        while (entry != nullptr && entry->module != module) {
+            entry = entry->next;
+        }
+        return entry;
+    }
+
+    std::atomic<Entry*> _buckets[1 << bucketsCountLog2];
+};
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__SymbolResolverCache__) */
@@ -12,4 +12,7 @@
 
 - (NSString*)getCurrentStack;
 
+/// Estimated JS heap bytes held by the interop wrappers of each materialized class, keyed by class name.
+- (NSDictionary<NSString*, NSNumber*>*)interopHeapUsage;
+
 @end
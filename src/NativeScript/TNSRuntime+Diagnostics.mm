@@ -40,4 +40,14 @@ using namespace NativeScript;
     return [NSString stringWithUTF8String:output.str().c_str()];
 }
 
+- (NSDictionary<NSString*, NSNumber*>*)interopHeapUsage {
+    JSLockHolder lock(*self->_vm);
+
+    NSMutableDictionary<NSString*, NSNumber*>* usage = [NSMutableDictionary dictionary];
+    for (const auto& entry : self->_globalObject->interopHeapUsage()) {
+        usage[@(class_getName(entry.first))] = @(entry.second);
+    }
+    return usage;
+}
+
 @end
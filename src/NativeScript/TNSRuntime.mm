@@ -14,6 +14,7 @@
 #include <JavaScriptCore/JSInternalPromise.h>
 #include <JavaScriptCore/JSModuleLoader.h>
 #include <JavaScriptCore/JSNativeStdFunction.h>
+#include <JavaScriptCore/SimpleTypedArrayController.h>
 #include <JavaScriptCore/inspector/JSGlobalObjectInspectorController.h>
 #include <iostream>
 
@@ -23,12 +24,15 @@
 
 #include "JSClientData.h"
 #include "JSErrors.h"
+#include "JSFrameCallbacks.h"
+#include "JSTimers.h"
 #include "ManualInstrumentation.h"
 #include "Metadata/Metadata.h"
 #include "ObjCTypes.h"
 #import "TNSRuntime+Private.h"
 #import "TNSRuntime.h"
 #include "Workers/JSWorkerGlobalObject.h"
+#include "Workers/WorkerMessage.h"
 
 #include <mach/mach_host.h>
 
@@ -46,6 +50,15 @@ JSInternalPromise* loadAndEvaluateModule(ExecState* exec, const String& moduleNa
     return globalObject->moduleLoader()->loadAndEvaluateModule(exec, moduleNameJsValue, referrerJsValue, initiator);
 }
 
+// Atomics.wait blocks the calling thread, so like in browsers it is allowed only on worker threads
+// and not on the main thread, whose run loop drives the UI.
+class RuntimeTypedArrayController : public SimpleTypedArrayController {
+public:
+    bool isAtomicsWaitAllowedOnCurrentThread() override {
+        return !isMainThread();
+    }
+};
+
 @interface TNSRuntime ()
 
 @property(nonatomic, retain) NSDictionary* appPackageJsonData;
@@ -66,6 +79,8 @@ JSInternalPromise* loadAndEvaluateModule(ExecState* exec, const String& moduleNa
 
 + (NSString*)readStringFromPackageJsonIos: (NSDictionary*)packageJson withKey: (NSString*)key;
 
++ (BOOL)readBoolFromPackageJsonIos: (NSDictionary*)packageJson withKey: (NSString*)key;
+
 + (NSDictionary*)readAppPackageJson:(NSString*)applicationPath;
 
 @end
@@ -109,6 +124,8 @@ static NSPointerArray* _runtimes;
         initializeThreading();
         
         JSC::Options::useJIT() = false;
+        // Workers and the main runtime can share memory through SharedArrayBuffers posted to each other
+        JSC::Options::useSharedArrayBuffer() = true;
         NSDictionary* packageJson = [TNSRuntime readAppPackageJson:[NSBundle mainBundle].bundlePath];
         NSString *jscFlags = [TNSRuntime readStringFromPackageJsonIos:packageJson withKey:@"jscFlags"];
         if (jscFlags != nil) {
@@ -131,6 +148,7 @@ static NSPointerArray* _runtimes;
     TNSPERF();
     if (self = [super init]) {
         self->_vm = VM::create(SmallHeap);
+        self->_vm->m_typedArrayController = adoptRef(new RuntimeTypedArrayController());
         self->thread = &WTF::Thread::current();
         self->_applicationPath = [[applicationPath stringByStandardizingPath] retain];
         self->_objectMap = std::make_unique<JSC::WeakGCMap<id, JSC::JSObject>>(*self->_vm);
@@ -148,6 +166,7 @@ static NSPointerArray* _runtimes;
 
         JSLockHolder lock(*self->_vm);
         self->_globalObject = [self createGlobalObjectInstance];
+        self->_globalObject->setWeaklyHoldsClassConstructors([TNSRuntime readBoolFromPackageJsonIos:[self appPackageJson] withKey:@"weakClassConstructors"]);
 
         {
             WTF::LockHolder lock(_runtimesLock);
@@ -167,6 +186,8 @@ static NSPointerArray* _runtimes;
     CFRunLoopRef cfRunLoop = runLoop.getCFRunLoop;
     CFRunLoopAddSource(cfRunLoop, self->_globalObject->microtaskRunLoopSource(), (CFStringRef)mode);
     CFRunLoopAddObserver(cfRunLoop, self->_globalObject->runLoopBeforeWaitingObserver(), (CFStringRef)mode);
+    self->_globalObject->timers().scheduleInRunLoop(cfRunLoop, (CFStringRef)mode);
+    self->_globalObject->frameCallbacks().scheduleInRunLoop(runLoop, mode);
     self->_globalObject->microtaskRunLoops().push_back(WTF::retainPtr(cfRunLoop));
 }
 
@@ -174,6 +195,8 @@ static NSPointerArray* _runtimes;
     CFRunLoopRef cfRunLoop = runLoop.getCFRunLoop;
     CFRunLoopRemoveSource(cfRunLoop, self->_globalObject->microtaskRunLoopSource(), (CFStringRef)mode);
     CFRunLoopRemoveObserver(cfRunLoop, self->_globalObject->runLoopBeforeWaitingObserver(), (CFStringRef)mode);
+    self->_globalObject->timers().removeFromRunLoop(cfRunLoop, (CFStringRef)mode);
+    self->_globalObject->frameCallbacks().removeFromRunLoop(runLoop, mode);
     self->_globalObject->microtaskRunLoops().remove(WTF::retainPtr(cfRunLoop));
 }
 
@@ -187,6 +210,7 @@ static NSPointerArray* _runtimes;
     JSLockHolder lock(self->_vm.get());
     self->_vm->heap.collectAsync(CollectionScope::Full);
     self->_vm->heap.releaseDelayedReleasedObjects();
+    WorkerMessage::releasePooledBuffers();
 }
 #endif
 
@@ -224,13 +248,26 @@ static NSPointerArray* _runtimes;
 }
 
 + (NSDictionary*)readAppPackageJson:(NSString*)applicationPath {
+    // The parsed settings are immutable, so the main runtime and all worker runtimes share them
+    static WTF::Lock packageJsonsLock;
+    static NSMutableDictionary* packageJsons = [NSMutableDictionary new];
+
+    WTF::LockHolder lock(packageJsonsLock);
+    applicationPath = [applicationPath stringByStandardizingPath];
+    if (NSDictionary* res = packageJsons[applicationPath]) {
+        return res;
+    }
+
     NSString* packageJsonPath = [applicationPath stringByAppendingPathComponent:@"app/package.json"];
     NSData* data = [NSData dataWithContentsOfFile:packageJsonPath];
-    NSDictionary *res = @{};
+    NSDictionary* res = nil;
     if (data) {
         NSError* error = nil;
-        res = [[NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error] retain];
+        res = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
     }
+
+    res = [res isKindOfClass:[NSDictionary class]] ? res : @{};
+    packageJsons[applicationPath] = res;
     return res;
 }
 
@@ -307,6 +344,23 @@ static NSPointerArray* _runtimes;
     return res;
 }
 
++ (BOOL)readBoolFromPackageJsonIos:(NSDictionary*)packageJson withKey: (NSString*)key {
+    BOOL res = NO;
+    if (packageJson) {
+        if (NSDictionary* ios = packageJson[@"ios"]) {
+            if (id value = ios[key]) {
+                if ([value respondsToSelector:@selector(boolValue)]) {
+                    res = [value boolValue];
+                } else {
+                    NSLog(@"\"%@\" setting from package.json cannot be converted to bool: %@", key, value);
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
 double getSystemFreeMemoryRatio() {
     mach_port_t host_port = mach_host_self();
     ;
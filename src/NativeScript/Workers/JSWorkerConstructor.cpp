@@ -14,12 +14,71 @@
 namespace NativeScript {
 using namespace JSC;
 
+static size_t readMessageQueueLimit(ExecState* exec, JSObject* options, const char* name) {
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    JSValue value = options->get(exec, Identifier::fromString(&vm, name));
+    RETURN_IF_EXCEPTION(scope, 0);
+    if (value.isUndefined())
+        return 0;
+
+    double limit = value.toNumber(exec);
+    RETURN_IF_EXCEPTION(scope, 0);
+    if (!(limit >= 0)) {
+        throwVMError(exec, scope, createRangeError(exec, makeString("The ", name, " option must be a non-negative number.")));
+        return 0;
+    }
+
+    return limit < static_cast<double>(std::numeric_limits<size_t>::max()) ? static_cast<size_t>(limit) : std::numeric_limits<size_t>::max();
+}
+
+// Reads { maxBufferedAmount, maxBufferedMessages, bufferOverflow: "drop" | "reject" | "block" }
+static WorkerMessageQueueLimits readMessageQueueLimits(ExecState* exec, JSValue optionsValue) {
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    WorkerMessageQueueLimits limits;
+    if (optionsValue.isUndefinedOrNull())
+        return limits;
+
+    if (!optionsValue.isObject()) {
+        throwVMError(exec, scope, createError(exec, "The second argument must be an object, null or undefined."_s));
+        return limits;
+    }
+
+    JSObject* options = asObject(optionsValue);
+    limits.maxBytes = readMessageQueueLimit(exec, options, "maxBufferedAmount");
+    RETURN_IF_EXCEPTION(scope, limits);
+    limits.maxMessages = readMessageQueueLimit(exec, options, "maxBufferedMessages");
+    RETURN_IF_EXCEPTION(scope, limits);
+
+    JSValue overflowPolicy = options->get(exec, Identifier::fromString(&vm, "bufferOverflow"));
+    RETURN_IF_EXCEPTION(scope, limits);
+    if (overflowPolicy.isUndefined())
+        return limits;
+
+    String overflowPolicyName = overflowPolicy.toWTFString(exec);
+    RETURN_IF_EXCEPTION(scope, limits);
+    if (overflowPolicyName == "drop") {
+        limits.overflowPolicy = WorkerMessageQueueLimits::OverflowPolicy::Drop;
+    } else if (overflowPolicyName == "reject") {
+        limits.overflowPolicy = WorkerMessageQueueLimits::OverflowPolicy::Reject;
+    } else if (overflowPolicyName == "block") {
+        limits.overflowPolicy = WorkerMessageQueueLimits::OverflowPolicy::Block;
+    } else {
+        throwVMError(exec, scope, createRangeError(exec, "The bufferOverflow option must be \"drop\", \"reject\" or \"block\"."_s));
+    }
+
+    return limits;
+}
+
 EncodedJSValue JSC_HOST_CALL JSWorkerConstructor::constructJSWorker(ExecState* exec) {
     auto scope = DECLARE_THROW_SCOPE(exec->vm());
     if (exec->argumentCount() < 1)
         return throwVMError(exec, scope, createNotEnoughArgumentsError(exec));
 
-    if (exec->argumentCount() > 1)
+    if (exec->argumentCount() > 2)
         return throwVMError(exec, scope, createError(exec, "Too much arguments passed."));
 
     if (!exec->argument(0).isString())
@@ -29,6 +88,9 @@ EncodedJSValue JSC_HOST_CALL JSWorkerConstructor::constructJSWorker(ExecState* e
     if (scope.exception())
         return JSValue::encode(JSValue());
 
+    WorkerMessageQueueLimits messageQueueLimits = readMessageQueueLimits(exec, exec->argument(1));
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+
     GlobalObject* globalObject = jsCast<GlobalObject*>(exec->lexicalGlobalObject());
     WTF::String applicationPath = globalObject->applicationPath();
 
@@ -42,7 +104,7 @@ EncodedJSValue JSC_HOST_CALL JSWorkerConstructor::constructJSWorker(ExecState* e
     WTF::String referrer = applicationPath;
     referrer.append(relativeFilePath);
 
-    auto worker = JSWorkerInstance::create(exec->vm(), globalObject->workerInstanceStructure(), applicationPath, entryModule, referrer);
+    auto worker = JSWorkerInstance::create(exec->vm(), globalObject->workerInstanceStructure(), applicationPath, entryModule, referrer, messageQueueLimits);
     return JSValue::encode(worker.get());
 }
 
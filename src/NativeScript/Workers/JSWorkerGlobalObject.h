@@ -22,10 +22,13 @@ public:
         return JSC::Structure::create(vm, 0, prototype, JSC::TypeInfo(JSC::GlobalObjectType, JSWorkerGlobalObject::StructureFlags), JSWorkerGlobalObject::info());
     }
 
-    void postMessage(JSC::ExecState* exec, JSC::JSValue message, JSC::JSArray* transferList);
+    // Returns a promise when the message queue limits of the worker reject overflowing messages, undefined otherwise
+    JSC::JSValue postMessage(JSC::ExecState* exec, JSC::JSValue message, JSC::JSArray* transferList);
 
     void onmessage(JSC::ExecState* exec, JSC::JSValue message);
 
+    void onmessageerror(JSC::ExecState* exec, JSC::JSValue error);
+
     void close();
 
     void uncaughtErrorReported(const WTF::String& message = "", const WTF::String& filename = "", int lineNumber = 0, int colNumber = 0);
@@ -50,7 +53,10 @@ private:
         static_cast<JSWorkerGlobalObject*>(cell)->~JSWorkerGlobalObject();
     }
 
+    void dispatchMessageEvent(JSC::ExecState* exec, const JSC::Identifier& handlerIdentifier, JSC::JSValue data);
+
     JSC::Identifier _onmessageIdentifier;
+    JSC::Identifier _onmessageerrorIdentifier;
 
     std::shared_ptr<WorkerMessagingProxy> _workerMessagingProxy = nullptr;
 };
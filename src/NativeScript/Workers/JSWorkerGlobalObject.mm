@@ -4,7 +4,6 @@
 
 #include "JSClientData.h"
 #include <JavaScriptCore/runtime/JSJob.h>
-#include <JavaScriptCore/runtime/JSONObject.h>
 
 using namespace JSC;
 
@@ -33,8 +32,12 @@ static EncodedJSValue JSC_HOST_CALL jsWorkerGlobalObjectPostMessage(ExecState* e
         }
     }
 
-    globalObject->postMessage(exec, message, transferList);
-    return JSValue::encode(jsUndefined());
+    return JSValue::encode(globalObject->postMessage(exec, message, transferList));
+}
+
+static EncodedJSValue JSC_HOST_CALL jsWorkerGlobalObjectBufferedAmount(ExecState* execState) {
+    JSWorkerGlobalObject* globalObject = jsCast<JSWorkerGlobalObject*>(execState->lexicalGlobalObject());
+    return JSValue::encode(jsNumber(globalObject->workerMessagingProxy()->workerBufferedAmount()));
 }
 
 const ClassInfo JSWorkerGlobalObject::s_info = { "NativeScriptWorkerGlobal", &Base::s_info, nullptr, nullptr, CREATE_METHOD_TABLE(JSWorkerGlobalObject) };
@@ -43,25 +46,40 @@ void JSWorkerGlobalObject::finishCreation(VM& vm, WTF::String applicationPath) {
     Base::finishCreation(vm, applicationPath);
 
     _onmessageIdentifier = Identifier::fromString(&vm, "onmessage");
+    _onmessageerrorIdentifier = Identifier::fromString(&vm, "onmessageerror");
 
     auto& builtinNames = static_cast<JSVMClientData*>(vm.clientData)->builtinNames();
 
     this->putDirect(vm, Identifier::fromString(&vm, "self"), this->globalExec()->globalThisValue(), PropertyAttribute::DontEnum | PropertyAttribute::ReadOnly | PropertyAttribute::DontDelete);
     this->putDirectNativeFunction(vm, this, builtinNames.closePublicName(), 0, jsWorkerGlobalObjectClose, NoIntrinsic, PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly);
     this->putDirectNativeFunction(vm, this, builtinNames.postMessagePublicName(), 2, jsWorkerGlobalObjectPostMessage, NoIntrinsic, PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly);
+
+    PropertyDescriptor bufferedAmountDescriptor;
+    bufferedAmountDescriptor.setGetter(JSFunction::create(vm, this, 0, "bufferedAmount"_s, jsWorkerGlobalObjectBufferedAmount));
+    bufferedAmountDescriptor.setConfigurable(false);
+    Base::defineOwnProperty(this, this->globalExec(), Identifier::fromString(&vm, "bufferedAmount"), bufferedAmountDescriptor, false);
 }
 
-void JSWorkerGlobalObject::postMessage(JSC::ExecState* exec, JSC::JSValue message, JSC::JSArray* transferList) {
+JSValue JSWorkerGlobalObject::postMessage(JSC::ExecState* exec, JSC::JSValue message, JSC::JSArray* transferList) {
     UNUSED_PARAM(transferList);
     auto scope = DECLARE_THROW_SCOPE(exec->vm());
-    String strMessage = JSONStringify(exec, message, 0);
+    std::shared_ptr<WorkerMessage> serializedMessage = WorkerMessage::serialize(exec, message);
     if (scope.exception())
-        return;
-    _workerMessagingProxy->workerPostMessageToParent(strMessage);
+        return JSValue();
+    bool isPosted = _workerMessagingProxy->workerPostMessageToParent(WTFMove(serializedMessage));
+    return postMessageResult(exec, _workerMessagingProxy->messageQueueLimits(), isPosted, "The message queue of the parent is full."_s);
 }
 
 void JSWorkerGlobalObject::onmessage(ExecState* exec, JSValue message) {
-    JSValue onMessageCallback = this->get(exec, _onmessageIdentifier);
+    dispatchMessageEvent(exec, _onmessageIdentifier, message);
+}
+
+void JSWorkerGlobalObject::onmessageerror(ExecState* exec, JSValue error) {
+    dispatchMessageEvent(exec, _onmessageerrorIdentifier, error);
+}
+
+void JSWorkerGlobalObject::dispatchMessageEvent(ExecState* exec, const Identifier& handlerIdentifier, JSValue data) {
+    JSValue onMessageCallback = this->get(exec, handlerIdentifier);
 
     CallData callData;
     CallType callType = JSC::getCallData(exec->vm(), onMessageCallback, callData);
@@ -71,7 +89,7 @@ void JSWorkerGlobalObject::onmessage(ExecState* exec, JSValue message) {
     JSGlobalObject* globalObject = exec->lexicalGlobalObject();
     Structure* emptyObjectStructure = exec->vm().structureCache.emptyObjectStructureForPrototype(globalObject, globalObject->objectPrototype(), JSFinalObject::defaultInlineCapacity());
     JSFinalObject* onMessageEvent = JSFinalObject::create(exec, emptyObjectStructure);
-    onMessageEvent->putDirect(exec->vm(), Identifier::fromString(&exec->vm(), "data"), message);
+    onMessageEvent->putDirect(exec->vm(), Identifier::fromString(&exec->vm(), "data"), data);
 
     MarkedArgumentBuffer onMessageArguments;
     onMessageArguments.append(onMessageEvent);
@@ -9,6 +9,8 @@
 #ifndef __NativeScript__JSWorkerInstance__
 #define __NativeScript__JSWorkerInstance__
 
+#include "WorkerMessage.h"
+
 namespace NativeScript {
 class WorkerMessagingProxy;
 
@@ -18,9 +20,9 @@ public:
 
     DECLARE_INFO;
 
-    static JSC::Strong<JSWorkerInstance> create(JSC::VM& vm, JSC::Structure* structure, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String referrer) {
+    static JSC::Strong<JSWorkerInstance> create(JSC::VM& vm, JSC::Structure* structure, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String referrer, const WorkerMessageQueueLimits& messageQueueLimits) {
         JSC::Strong<JSWorkerInstance> object(vm, new (NotNull, JSC::allocateCell<JSWorkerInstance>(vm.heap)) JSWorkerInstance(vm, structure));
-        object->finishCreation(vm, applicationPath, entryModuleId, referrer);
+        object->finishCreation(vm, applicationPath, entryModuleId, referrer, messageQueueLimits);
         return object;
     }
 
@@ -28,10 +30,16 @@ public:
         return JSC::Structure::create(vm, globalObject, prototype, JSC::TypeInfo(JSC::ObjectType, StructureFlags), info());
     }
 
-    void postMessage(JSC::ExecState* exec, JSC::JSValue message, JSC::JSArray* transferList);
+    // Returns a promise when the message queue limits of the worker reject overflowing messages, undefined otherwise
+    JSC::JSValue postMessage(JSC::ExecState* exec, JSC::JSValue message, JSC::JSArray* transferList);
 
     void onmessage(JSC::ExecState* exec, JSC::JSValue message);
 
+    void onmessageerror(JSC::ExecState* exec, JSC::JSValue error);
+
+    // The size in bytes of the messages posted to the worker which it has not taken yet
+    size_t bufferedAmount();
+
     void onerror(JSC::ExecState* exec, JSObject* error);
 
     void terminate();
@@ -45,7 +53,9 @@ private:
         : Base(vm, structure) {
     }
 
-    void finishCreation(JSC::VM& vm, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String referer);
+    void finishCreation(JSC::VM& vm, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String referer, const WorkerMessageQueueLimits& messageQueueLimits);
+
+    void dispatchMessageEvent(JSC::ExecState* exec, const JSC::Identifier& handlerIdentifier, JSC::JSValue data);
 
     WTF::String _applicationPath;
     WTF::String _entryModuleId;
@@ -53,6 +63,7 @@ private:
     std::shared_ptr<WorkerMessagingProxy> _workerMessagingProxy;
 
     JSC::Identifier _onmessageIdentifier;
+    JSC::Identifier _onmessageerrorIdentifier;
     JSC::Identifier _onerrorIdentifier;
 };
 } // namespace NativeScript
@@ -9,24 +9,36 @@
 #include "JSWorkerInstance.h"
 #include "JSErrors.h"
 #include "WorkerMessagingProxy.h"
-#include <JavaScriptCore/JSONObject.h>
 
 namespace NativeScript {
 using namespace JSC;
 
 const ClassInfo JSWorkerInstance::s_info = { "Worker", &Base::s_info, nullptr, nullptr, CREATE_METHOD_TABLE(JSWorkerInstance) };
 
-void JSWorkerInstance::postMessage(ExecState* exec, JSValue message, JSArray* transferList) {
+JSValue JSWorkerInstance::postMessage(ExecState* exec, JSValue message, JSArray* transferList) {
     UNUSED_PARAM(transferList);
     auto scope = DECLARE_THROW_SCOPE(exec->vm());
-    String strMessage = JSONStringify(exec, message, 0);
+    std::shared_ptr<WorkerMessage> serializedMessage = WorkerMessage::serialize(exec, message);
     if (scope.exception())
-        return;
-    _workerMessagingProxy->parentPostMessageToWorkerThread(strMessage);
+        return JSValue();
+    bool isPosted = _workerMessagingProxy->parentPostMessageToWorkerThread(WTFMove(serializedMessage));
+    return postMessageResult(exec, _workerMessagingProxy->messageQueueLimits(), isPosted, "The message queue of the worker is full."_s);
 }
 
 void JSWorkerInstance::onmessage(JSC::ExecState* exec, JSC::JSValue message) {
-    JSValue onMessageCallback = this->get(exec, _onmessageIdentifier);
+    dispatchMessageEvent(exec, _onmessageIdentifier, message);
+}
+
+void JSWorkerInstance::onmessageerror(JSC::ExecState* exec, JSC::JSValue error) {
+    dispatchMessageEvent(exec, _onmessageerrorIdentifier, error);
+}
+
+size_t JSWorkerInstance::bufferedAmount() {
+    return _workerMessagingProxy->parentBufferedAmount();
+}
+
+void JSWorkerInstance::dispatchMessageEvent(JSC::ExecState* exec, const JSC::Identifier& handlerIdentifier, JSC::JSValue data) {
+    JSValue onMessageCallback = this->get(exec, handlerIdentifier);
 
     CallData callData;
     CallType callType = JSC::getCallData(exec->vm(), onMessageCallback, callData);
@@ -37,7 +49,7 @@ void JSWorkerInstance::onmessage(JSC::ExecState* exec, JSC::JSValue message) {
     JSGlobalObject* globalObject = exec->lexicalGlobalObject();
     Structure* emptyObjectStructure = exec->vm().structureCache.emptyObjectStructureForPrototype(globalObject, globalObject->objectPrototype(), JSFinalObject::defaultInlineCapacity());
     JSFinalObject* onMessageEvent = JSFinalObject::create(exec, emptyObjectStructure);
-    onMessageEvent->putDirect(exec->vm(), Identifier::fromString(&exec->vm(), "data"), message);
+    onMessageEvent->putDirect(exec->vm(), Identifier::fromString(&exec->vm(), "data"), data);
 
     MarkedArgumentBuffer onMessageArguments;
     onMessageArguments.append(onMessageEvent);
@@ -64,16 +76,17 @@ void JSWorkerInstance::terminate() {
     _workerMessagingProxy->parentTerminateWorkerThread();
 }
 
-void JSWorkerInstance::finishCreation(JSC::VM& vm, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String referrer) {
+void JSWorkerInstance::finishCreation(JSC::VM& vm, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String referrer, const WorkerMessageQueueLimits& messageQueueLimits) {
     Base::finishCreation(vm);
 
     _onmessageIdentifier = Identifier::fromString(&vm, "onmessage");
+    _onmessageerrorIdentifier = Identifier::fromString(&vm, "onmessageerror");
     _onerrorIdentifier = Identifier::fromString(&vm, "onerror");
 
     _applicationPath = applicationPath;
     _entryModuleId = entryModuleId;
     _referrer = referrer;
-    _workerMessagingProxy = std::make_shared<WorkerMessagingProxy>(this);
+    _workerMessagingProxy = std::make_shared<WorkerMessagingProxy>(this, messageQueueLimits);
     _workerMessagingProxy->parentStartWorkerThread(applicationPath, entryModuleId, referrer);
 }
 }
@@ -35,8 +35,16 @@ static EncodedJSValue JSC_HOST_CALL jsWorkerProtoFuncPostMessage(ExecState* exec
         }
     }
 
-    workerInstance->postMessage(exec, message, transferList);
-    return JSValue::encode(jsUndefined());
+    return JSValue::encode(workerInstance->postMessage(exec, message, transferList));
+}
+
+static EncodedJSValue JSC_HOST_CALL jsWorkerProtoGetterBufferedAmount(ExecState* exec) {
+    JSWorkerInstance* workerInstance = jsDynamicCast<JSWorkerInstance*>(exec->vm(), exec->thisValue());
+    auto scope = DECLARE_THROW_SCOPE(exec->vm());
+    if (UNLIKELY(!workerInstance))
+        return throwVMError(exec, scope, createTypeError(exec, makeString("Can only get Worker.bufferedAmount, on instances of Worker")));
+
+    return JSValue::encode(jsNumber(workerInstance->bufferedAmount()));
 }
 
 static EncodedJSValue JSC_HOST_CALL jsWorkerProtoFuncTerminate(ExecState* state) {
@@ -54,5 +62,10 @@ void JSWorkerPrototype::finishCreation(VM& vm, JSGlobalObject* globalObject) {
 
     this->putDirectNativeFunction(vm, globalObject, Identifier::fromString(&vm, "postMessage"_s), 2, jsWorkerProtoFuncPostMessage, NoIntrinsic, PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly);
     this->putDirectNativeFunction(vm, globalObject, Identifier::fromString(&vm, "terminate"_s), 0, jsWorkerProtoFuncTerminate, NoIntrinsic, PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly);
+
+    PropertyDescriptor bufferedAmountDescriptor;
+    bufferedAmountDescriptor.setGetter(JSFunction::create(vm, globalObject, 0, "bufferedAmount"_s, jsWorkerProtoGetterBufferedAmount));
+    bufferedAmountDescriptor.setConfigurable(false);
+    Base::defineOwnProperty(this, globalObject->globalExec(), Identifier::fromString(&vm, "bufferedAmount"), bufferedAmountDescriptor, false);
 }
 } // namespace NativeScript
@@ -0,0 +1,505 @@
+//
+//  WorkerMessage.cpp
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "WorkerMessage.h"
+#include <JavaScriptCore/ArrayConstructor.h>
+#include <JavaScriptCore/BooleanObject.h>
+#include <JavaScriptCore/JSArrayBuffer.h>
+#include <JavaScriptCore/JSPromiseDeferred.h>
+#include <JavaScriptCore/LiteralParser.h>
+#include <JavaScriptCore/NumberObject.h>
+#include <JavaScriptCore/StringObject.h>
+#include <mutex>
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/dtoa.h>
+#include <wtf/text/StringConcatenate.h>
+
+namespace NativeScript {
+using namespace JSC;
+
+// Buffers are recycled so that a stream of large messages does not reallocate and regrow
+// a buffer for every message. The pool holds at most this many bytes of capacity, larger
+// buffers are released instead.
+static const size_t maxPooledBytes = 1024 * 1024;
+
+static std::mutex bufferPoolMutex;
+static size_t pooledBytes = 0;
+
+// A SharedArrayBuffer is written as {"\u0000SharedArrayBuffer":<index in _sharedBuffers>}. Keys of
+// the value which start with a NUL character are written with another one in front of them, so they
+// can never be taken for it, and the receiver removes it.
+static const char sharedArrayBufferKey[] = "\0SharedArrayBuffer";
+
+static bool isEscapedKey(const WTF::String& key) {
+    return !key.isEmpty() && key[0] == '\0';
+}
+
+static WTF::Vector<WTF::Vector<LChar>>& bufferPool() {
+    static WTF::NeverDestroyed<WTF::Vector<WTF::Vector<LChar>>> pool;
+    return pool;
+}
+
+WorkerMessage::WorkerMessage() {
+    std::lock_guard<std::mutex> lock(bufferPoolMutex);
+    if (!bufferPool().isEmpty()) {
+        _buffer = bufferPool().takeLast();
+        pooledBytes -= _buffer.capacity();
+    }
+}
+
+WorkerMessage::~WorkerMessage() {
+    if (_buffer.capacity() > maxPooledBytes) {
+        return;
+    }
+
+    // shrink() keeps the capacity, unlike clear()
+    _buffer.shrink(0);
+
+    std::lock_guard<std::mutex> lock(bufferPoolMutex);
+    if (pooledBytes + _buffer.capacity() <= maxPooledBytes) {
+        pooledBytes += _buffer.capacity();
+        bufferPool().append(WTFMove(_buffer));
+    }
+}
+
+void WorkerMessage::releasePooledBuffers() {
+    WTF::Vector<WTF::Vector<LChar>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(bufferPoolMutex);
+        buffers.swap(bufferPool());
+        pooledBytes = 0;
+    }
+}
+
+class WorkerMessageSerializer {
+public:
+    WorkerMessageSerializer(ExecState* execState, WTF::Vector<LChar>& buffer, WTF::Vector<ArrayBufferContents>& sharedBuffers)
+        : _execState(execState)
+        , _vm(execState->vm())
+        , _buffer(buffer)
+        , _sharedBuffers(sharedBuffers)
+        , _hasEscapedKeys(false) {
+    }
+
+    bool hasEscapedKeys() const {
+        return _hasEscapedKeys;
+    }
+
+    // Returns false without writing anything for values that JSON.stringify skips
+    // (undefined, functions and symbols). Callers must check for an exception.
+    bool appendValue(JSValue value, const Identifier* key, unsigned index) {
+        auto scope = DECLARE_THROW_SCOPE(_vm);
+
+        if (value.isObject()) {
+            JSValue toJSON = asObject(value)->get(_execState, _vm.propertyNames->toJSON);
+            RETURN_IF_EXCEPTION(scope, false);
+
+            CallData callData;
+            CallType callType = getCallData(_vm, toJSON, callData);
+            if (callType != CallType::None) {
+                MarkedArgumentBuffer arguments;
+                arguments.append(jsString(_execState, key ? key->string() : WTF::String::number(index)));
+                value = call(_execState, toJSON, callType, callData, value, arguments);
+                RETURN_IF_EXCEPTION(scope, false);
+            }
+        }
+
+        if (value.isObject()) {
+            JSObject* object = asObject(value);
+            if (object->inherits<NumberObject>(_vm)) {
+                value = jsNumber(value.toNumber(_execState));
+                RETURN_IF_EXCEPTION(scope, false);
+            } else if (object->inherits<StringObject>(_vm)) {
+                value = value.toString(_execState);
+                RETURN_IF_EXCEPTION(scope, false);
+            } else if (object->inherits<BooleanObject>(_vm)) {
+                value = jsCast<BooleanObject*>(object)->internalValue();
+            } else if (JSArrayBuffer* arrayBuffer = jsDynamicCast<JSArrayBuffer*>(_vm, object)) {
+                if (arrayBuffer->isShared()) {
+                    appendSharedArrayBuffer(arrayBuffer->impl());
+                    return true;
+                }
+            }
+        }
+
+        if (value.isNull()) {
+            append("null");
+            return true;
+        }
+
+        if (value.isBoolean()) {
+            append(value.isTrue() ? "true" : "false");
+            return true;
+        }
+
+        if (value.isInt32()) {
+            appendInteger(value.asInt32());
+            return true;
+        }
+
+        if (value.isNumber()) {
+            double number = value.asNumber();
+            if (!std::isfinite(number)) {
+                append("null");
+            } else {
+                WTF::NumberToStringBuffer numberBuffer;
+                append(WTF::numberToString(number, numberBuffer));
+            }
+            return true;
+        }
+
+        if (value.isString()) {
+            WTF::String string = asString(value)->value(_execState);
+            RETURN_IF_EXCEPTION(scope, false);
+            appendQuotedString(string);
+            return true;
+        }
+
+        CallData callData;
+        if (!value.isObject() || getCallData(_vm, value, callData) != CallType::None) {
+            return false;
+        }
+
+        JSObject* object = asObject(value);
+        if (!_vm.isSafeToRecurse()) {
+            throwStackOverflowError(_execState, scope);
+            return false;
+        }
+
+        if (_holders.contains(object)) {
+            throwTypeError(_execState, scope, "JSON.stringify cannot serialize cyclic structures."_s);
+            return false;
+        }
+
+        _holders.append(object);
+        bool isArrayObject = isArray(_execState, object);
+        RETURN_IF_EXCEPTION(scope, false);
+        if (isArrayObject) {
+            appendArray(object);
+        } else {
+            appendObject(object);
+        }
+        _holders.removeLast();
+
+        return !scope.exception();
+    }
+
+private:
+    void appendSharedArrayBuffer(ArrayBuffer* arrayBuffer) {
+        // A buffer referenced more than once is shared once, so that the receiver gets a single object for it
+        auto addResult = _sharedBufferIndices.add(arrayBuffer, _sharedBuffers.size());
+        if (addResult.isNewEntry) {
+            ArrayBufferContents contents;
+            arrayBuffer->shareWith(contents);
+            _sharedBuffers.append(WTFMove(contents));
+        }
+
+        _buffer.append('{');
+        appendQuotedCharacters(reinterpret_cast<const LChar*>(sharedArrayBufferKey), sizeof(sharedArrayBufferKey) - 1);
+        _buffer.append(':');
+        appendInteger(static_cast<int32_t>(addResult.iterator->value));
+        _buffer.append('}');
+    }
+
+    void appendArray(JSObject* array) {
+        auto scope = DECLARE_THROW_SCOPE(_vm);
+
+        JSValue lengthValue = array->get(_execState, _vm.propertyNames->length);
+        RETURN_IF_EXCEPTION(scope, void());
+        double length = lengthValue.toLength(_execState);
+        RETURN_IF_EXCEPTION(scope, void());
+
+        _buffer.append('[');
+        for (unsigned i = 0; i < length; i++) {
+            if (i) {
+                _buffer.append(',');
+            }
+
+            JSValue element = array->get(_execState, i);
+            RETURN_IF_EXCEPTION(scope, void());
+            bool written = appendValue(element, nullptr, i);
+            RETURN_IF_EXCEPTION(scope, void());
+            if (!written) {
+                append("null");
+            }
+        }
+        _buffer.append(']');
+    }
+
+    void appendObject(JSObject* object) {
+        auto scope = DECLARE_THROW_SCOPE(_vm);
+
+        PropertyNameArray propertyNames(&_vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
+        object->methodTable(_vm)->getOwnPropertyNames(object, _execState, propertyNames, EnumerationMode());
+        RETURN_IF_EXCEPTION(scope, void());
+
+        _buffer.append('{');
+        bool isFirst = true;
+        for (const Identifier& propertyName : propertyNames) {
+            JSValue propertyValue = object->get(_execState, propertyName);
+            RETURN_IF_EXCEPTION(scope, void());
+
+            // The key is written optimistically and dropped again if the value is skipped.
+            size_t propertyStart = _buffer.size();
+            if (!isFirst) {
+                _buffer.append(',');
+            }
+            appendQuotedKey(propertyName.string());
+            _buffer.append(':');
+
+            bool written = appendValue(propertyValue, &propertyName, 0);
+            RETURN_IF_EXCEPTION(scope, void());
+            if (written) {
+                isFirst = false;
+            } else {
+                _buffer.shrink(propertyStart);
+            }
+        }
+        _buffer.append('}');
+    }
+
+    void append(const char* characters) {
+        _buffer.append(reinterpret_cast<const LChar*>(characters), strlen(characters));
+    }
+
+    void appendInteger(int32_t value) {
+        LChar characters[12];
+        LChar* end = characters + sizeof(characters);
+        LChar* p = end;
+        uint32_t magnitude = value < 0 ? -static_cast<uint32_t>(value) : value;
+        do {
+            *--p = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) {
+            *--p = '-';
+        }
+        _buffer.append(p, end - p);
+    }
+
+    void appendEscaped(UChar character) {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        switch (character) {
+        case '"':
+            append("\\\"");
+            return;
+        case '\\':
+            append("\\\\");
+            return;
+        case '\b':
+            append("\\b");
+            return;
+        case '\f':
+            append("\\f");
+            return;
+        case '\n':
+            append("\\n");
+            return;
+        case '\r':
+            append("\\r");
+            return;
+        case '\t':
+            append("\\t");
+            return;
+        default:
+            LChar escape[6] = { '\\', 'u',
+                                static_cast<LChar>(hexDigits[character >> 12]),
+                                static_cast<LChar>(hexDigits[(character >> 8) & 0xF]),
+                                static_cast<LChar>(hexDigits[(character >> 4) & 0xF]),
+                                static_cast<LChar>(hexDigits[character & 0xF]) };
+            _buffer.append(escape, sizeof(escape));
+            return;
+        }
+    }
+
+    template <typename CharType>
+    void appendQuotedCharacters(const CharType* characters, unsigned length) {
+        _buffer.append('"');
+
+        // Copy runs of printable ASCII characters in bulk
+        unsigned runStart = 0;
+        for (unsigned i = 0; i < length; i++) {
+            CharType character = characters[i];
+            if (character >= 0x20 && character < 0x80 && character != '"' && character != '\\') {
+                continue;
+            }
+
+            appendASCII(characters + runStart, i - runStart);
+            appendEscaped(character);
+            runStart = i + 1;
+        }
+        appendASCII(characters + runStart, length - runStart);
+
+        _buffer.append('"');
+    }
+
+    void appendASCII(const LChar* characters, unsigned length) {
+        _buffer.append(characters, length);
+    }
+
+    void appendASCII(const UChar* characters, unsigned length) {
+        size_t start = _buffer.size();
+        _buffer.grow(start + length);
+        for (unsigned i = 0; i < length; i++) {
+            _buffer[start + i] = static_cast<LChar>(characters[i]);
+        }
+    }
+
+    void appendQuotedString(const WTF::String& string) {
+        if (string.is8Bit()) {
+            appendQuotedCharacters(string.characters8(), string.length());
+        } else {
+            appendQuotedCharacters(string.characters16(), string.length());
+        }
+    }
+
+    void appendQuotedKey(const WTF::String& key) {
+        if (!isEscapedKey(key)) {
+            appendQuotedString(key);
+            return;
+        }
+
+        _hasEscapedKeys = true;
+        appendQuotedString(makeString(UChar(0), key));
+    }
+
+    ExecState* _execState;
+    VM& _vm;
+    WTF::Vector<LChar>& _buffer;
+    WTF::Vector<ArrayBufferContents>& _sharedBuffers;
+    WTF::HashMap<ArrayBuffer*, unsigned> _sharedBufferIndices;
+    WTF::Vector<JSObject*, 16> _holders;
+    bool _hasEscapedKeys;
+};
+
+// Replaces the placeholders of shared array buffers in a parsed message and removes the NUL
+// characters added in front of escaped keys. Parsed messages consist of plain arrays and objects
+// only, so their own properties are all there is to visit.
+class SharedArrayBufferReviver {
+public:
+    SharedArrayBufferReviver(ExecState* execState, WTF::Vector<ArrayBufferContents>& sharedBuffers)
+        : _execState(execState)
+        , _vm(execState->vm())
+        , _sharedBuffers(sharedBuffers)
+        , _key(Identifier::fromString(&_vm, WTF::String(sharedArrayBufferKey, sizeof(sharedArrayBufferKey) - 1))) {
+        _revivedBuffers.fill(nullptr, _sharedBuffers.size());
+    }
+
+    JSValue revive(JSValue value) {
+        if (!value.isObject() || !_vm.isSafeToRecurse()) {
+            return value;
+        }
+
+        JSObject* object = asObject(value);
+        JSValue index = object->getDirect(_vm, _key);
+        if (index && index.isUInt32() && index.asUInt32() < _sharedBuffers.size()) {
+            JSArrayBuffer*& revivedBuffer = _revivedBuffers[index.asUInt32()];
+            if (!revivedBuffer) {
+                RefPtr<ArrayBuffer> arrayBuffer = ArrayBuffer::create(WTFMove(_sharedBuffers[index.asUInt32()]));
+                Structure* structure = _execState->lexicalGlobalObject()->arrayBufferStructure(ArrayBufferSharingMode::Shared);
+                revivedBuffer = JSArrayBuffer::create(_vm, structure, WTFMove(arrayBuffer));
+            }
+            return revivedBuffer;
+        }
+
+        PropertyNameArray propertyNames(&_vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
+        object->methodTable(_vm)->getOwnPropertyNames(object, _execState, propertyNames, EnumerationMode());
+
+        bool hasEscapedKeys = false;
+        for (const Identifier& propertyName : propertyNames) {
+            hasEscapedKeys = hasEscapedKeys || isEscapedKey(propertyName.string());
+        }
+
+        if (hasEscapedKeys) {
+            // Renaming properties in place would change their order, so the object is rebuilt
+            JSObject* unescaped = constructEmptyObject(_execState);
+            for (const Identifier& propertyName : propertyNames) {
+                Identifier key = isEscapedKey(propertyName.string()) ? Identifier::fromString(&_vm, propertyName.string().substring(1)) : propertyName;
+                unescaped->putDirectMayBeIndex(_execState, key, revive(object->get(_execState, propertyName)));
+            }
+            return unescaped;
+        }
+
+        for (const Identifier& propertyName : propertyNames) {
+            JSValue propertyValue = object->get(_execState, propertyName);
+            JSValue revivedValue = revive(propertyValue);
+            if (revivedValue != propertyValue) {
+                object->putDirectMayBeIndex(_execState, propertyName, revivedValue);
+            }
+        }
+
+        return value;
+    }
+
+private:
+    ExecState* _execState;
+    VM& _vm;
+    WTF::Vector<ArrayBufferContents>& _sharedBuffers;
+    // Each one is referenced from the parsed message, which is on the stack, once it is revived
+    WTF::Vector<JSArrayBuffer*> _revivedBuffers;
+    Identifier _key;
+};
+
+std::shared_ptr<WorkerMessage> WorkerMessage::serialize(ExecState* execState, JSValue value) {
+    auto scope = DECLARE_THROW_SCOPE(execState->vm());
+
+    std::shared_ptr<WorkerMessage> message(new WorkerMessage());
+    WorkerMessageSerializer serializer(execState, message->_buffer, message->_sharedBuffers);
+    bool written = serializer.appendValue(value, &execState->vm().propertyNames->emptyIdentifier, 0);
+    RETURN_IF_EXCEPTION(scope, nullptr);
+    if (!written) {
+        message->_buffer.shrink(0);
+    }
+    message->_hasEscapedKeys = serializer.hasEscapedKeys();
+
+    return message;
+}
+
+JSValue WorkerMessage::deserialize(ExecState* execState) {
+    if (_buffer.isEmpty()) {
+        return jsUndefined();
+    }
+
+    LiteralParser<LChar> parser(execState, _buffer.data(), _buffer.size(), StrictJSON);
+    JSValue value = parser.tryLiteralParse();
+    if (!value || (_sharedBuffers.isEmpty() && !_hasEscapedKeys)) {
+        return value;
+    }
+
+    SharedArrayBufferReviver reviver(execState, _sharedBuffers);
+    value = reviver.revive(value);
+    _sharedBuffers.clear();
+    return value;
+}
+
+JSValue postMessageResult(ExecState* execState, const WorkerMessageQueueLimits& limits, bool isPosted, const WTF::String& overflowMessage) {
+    VM& vm = execState->vm();
+    if (!isPosted && limits.overflowPolicy == WorkerMessageQueueLimits::OverflowPolicy::Block) {
+        auto scope = DECLARE_THROW_SCOPE(vm);
+        throwVMError(execState, scope, createRangeError(execState, overflowMessage));
+        return JSValue();
+    }
+
+    if (limits.overflowPolicy != WorkerMessageQueueLimits::OverflowPolicy::Reject) {
+        return jsUndefined();
+    }
+
+    JSPromiseDeferred* deferred = JSPromiseDeferred::create(execState, execState->lexicalGlobalObject());
+    JSValue settle = isPosted ? deferred->resolve() : deferred->reject();
+
+    CallData callData;
+    CallType callType = JSC::getCallData(vm, settle, callData);
+
+    MarkedArgumentBuffer arguments;
+    arguments.append(isPosted ? jsUndefined() : JSValue(createRangeError(execState, overflowMessage)));
+    JSC::call(execState, settle, callType, callData, jsUndefined(), arguments);
+
+    return deferred->promise();
+}
+} // namespace NativeScript
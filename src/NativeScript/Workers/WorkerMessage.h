@@ -0,0 +1,78 @@
+//
+//  WorkerMessage.h
+//  NativeScript
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __NativeScript__WorkerMessage__
+#define __NativeScript__WorkerMessage__
+
+#include <JavaScriptCore/ArrayBuffer.h>
+#include <wtf/Vector.h>
+
+namespace NativeScript {
+
+/// A message posted between a worker and its parent.
+///
+/// The value is serialized as JSON straight into a byte buffer taken from a small process-wide pool,
+/// the buffer is handed over to the receiving thread as is, and it is parsed there in place.
+/// Characters outside of ASCII are always written as \u escapes, so the buffer is valid both as
+/// UTF-8 and as Latin-1 and never needs to be decoded into a WTF::String.
+///
+/// SharedArrayBuffers are not copied. The message holds a reference to their backing store and the
+/// receiver gets a SharedArrayBuffer over the same memory.
+class WorkerMessage {
+public:
+    /// Serializes the value with the semantics of JSON.stringify(value).
+    /// Returns nullptr if an exception has been thrown, e.g. for cyclic structures.
+    static std::shared_ptr<WorkerMessage> serialize(JSC::ExecState* execState, JSC::JSValue value);
+
+    ~WorkerMessage();
+
+    /// Parses the message in the realm of the given ExecState. A message created from a value
+    /// that JSON.stringify would not serialize (e.g. undefined) is parsed as undefined.
+    /// Hands the shared memory over to the receiver, so a message can be deserialized only once.
+    JSC::JSValue deserialize(JSC::ExecState* execState);
+
+    size_t size() const {
+        return _buffer.size();
+    }
+
+    /// Frees the buffers kept for reuse, e.g. on a memory warning.
+    static void releasePooledBuffers();
+
+private:
+    WorkerMessage();
+
+    WTF::Vector<LChar> _buffer;
+    WTF::Vector<JSC::ArrayBufferContents> _sharedBuffers;
+    bool _hasEscapedKeys = false;
+};
+
+/// Limits of the messages that are posted in one direction between a worker and its parent but
+/// are not yet taken by the receiving thread. They are passed as the options of the Worker constructor.
+struct WorkerMessageQueueLimits {
+    enum class OverflowPolicy {
+        // postMessage drops the message and an onmessageerror event is dispatched to the sender
+        Drop,
+        // postMessage returns a promise, which is rejected if the message has been dropped
+        Reject,
+        // postMessage waits until the receiving thread has taken enough messages. The main thread never
+        // waits, postMessage throws a RangeError there instead.
+        Block,
+    };
+
+    // 0 means unlimited. A message is always accepted when nothing is queued, however large it is.
+    size_t maxBytes = 0;
+    size_t maxMessages = 0;
+    OverflowPolicy overflowPolicy = OverflowPolicy::Drop;
+};
+
+/// The value returned by postMessage. It is undefined, except with the Reject overflow policy, where it is
+/// a promise that is resolved if the message has been posted and rejected with a RangeError if it has been dropped.
+/// With the Block overflow policy a message is dropped only on the main thread, where a RangeError is thrown.
+JSC::JSValue postMessageResult(JSC::ExecState* execState, const WorkerMessageQueueLimits& limits, bool isPosted, const WTF::String& overflowMessage);
+} // namespace NativeScript
+
+#endif /* defined(__NativeScript__WorkerMessage__) */
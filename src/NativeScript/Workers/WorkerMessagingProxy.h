@@ -10,7 +10,10 @@
 #define __NativeScript__WorkerMessagingProxy__
 
 #include "JSWorkerInstance.h"
+#include "WorkerMessage.h"
 #include <JavaScriptCore/InternalFunction.h>
+#include <condition_variable>
+#include <mutex>
 
 @class TNSRuntime;
 
@@ -96,15 +99,28 @@ class WorkerMessagingProxy {
         WTF::Deque<std::function<void()>> tasksQueue;
     };
 
+    struct MessageQueueUsage {
+        size_t bytes = 0;
+        size_t messages = 0;
+        bool isProducerBlocked = false;
+    };
+
 public:
-    WorkerMessagingProxy(JSWorkerInstance* worker);
+    WorkerMessagingProxy(JSWorkerInstance* worker, const WorkerMessageQueueLimits& messageQueueLimits);
+
+    const WorkerMessageQueueLimits& messageQueueLimits() const {
+        return _messageQueueLimits;
+    }
 
     // Called on parent thread
     void parentPerformWork();
     void parentStartWorkerThread(const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String& referrer);
     void parentTerminateWorkerThread();
-    void parentPostMessageToWorkerThread(WTF::String& message);
-    void parentOnMessagePostedFromWorker(WTF::String& message);
+    // Returns false if the message has been dropped because of the message queue limits
+    bool parentPostMessageToWorkerThread(std::shared_ptr<WorkerMessage> message);
+    void parentOnMessagePostedFromWorker(const std::shared_ptr<WorkerMessage>& message);
+    void parentOnMessageDropped();
+    size_t parentBufferedAmount();
     void parentOnExceptionPosted(const WTF::String& message, const WTF::String& sourceUrl, unsigned lineNumber, unsigned colNumber);
     void parentOnWorkerThreadExited();
 
@@ -112,8 +128,11 @@ public:
     void workerPerformWork();
     static void workerThreadMain(std::shared_ptr<WorkerMessagingProxy> messagingProxy, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String& referrer);
     void workerThreadInitialize(std::shared_ptr<WorkerMessagingProxy> messagingProxy, const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String& referrer);
-    void workerPostMessageToParent(WTF::String& message);
-    void workerOnMessagePostedFromParent(WTF::String& message);
+    // Returns false if the message has been dropped because of the message queue limits
+    bool workerPostMessageToParent(std::shared_ptr<WorkerMessage> message);
+    void workerOnMessagePostedFromParent(const std::shared_ptr<WorkerMessage>& message);
+    void workerOnMessageDropped();
+    size_t workerBufferedAmount();
     void workerClose();
     void workerClosed();
     void workerPostException(const WTF::String& message = "", const WTF::String& filename = "", int lineNumber = 0, int colNumber = 0);
@@ -126,6 +145,10 @@ private:
     void workerAppendTask(std::function<void()> task);
     void workerPrependTask(std::function<void()> task);
 
+    bool reserveMessageQueueSpace(MessageQueueUsage& usage, const MessageQueueUsage& peerUsage, size_t size);
+    void releaseMessageQueueSpace(MessageQueueUsage& usage, size_t size);
+    void closeMessageQueues();
+
     WTF::Lock _parentPortLock;
     std::unique_ptr<ThreadMessagingPort> _parentPort;
     std::unique_ptr<ParentThreadData> _parentData; // initialized and accessed only by the parent thread, therefore locking is not needed
@@ -133,6 +156,13 @@ private:
     WTF::Lock _workerPortLock;
     std::unique_ptr<ThreadMessagingPort> _workerPort;
     std::unique_ptr<WorkerThreadData> _workerData; // initialized and accessed only by the worker thread, therefore locking is not needed
+
+    const WorkerMessageQueueLimits _messageQueueLimits;
+    std::mutex _messageQueuesMutex;
+    std::condition_variable _messageQueuesDrained;
+    MessageQueueUsage _parentToWorkerUsage; // guarded by _messageQueuesMutex
+    MessageQueueUsage _workerToParentUsage; // guarded by _messageQueuesMutex
+    bool _areMessageQueuesClosed; // guarded by _messageQueuesMutex
 };
 } // namespace NativeScript
 
@@ -10,7 +10,6 @@
 #include "JSErrors.h"
 #include "JSWorkerGlobalObject.h"
 #include "TNSRuntime+Private.h"
-#include <JavaScriptCore/JSONObject.h>
 #include <JavaScriptCore/runtime/Exception.h>
 #include <wtf/RunLoop.h>
 
@@ -119,14 +118,71 @@ void WorkerMessagingProxy::workerPrependTask(std::function<void()> task) {
         _workerPort->prependTask(task);
 }
 
-WorkerMessagingProxy::WorkerMessagingProxy(JSWorkerInstance* worker)
+WorkerMessagingProxy::WorkerMessagingProxy(JSWorkerInstance* worker, const WorkerMessageQueueLimits& messageQueueLimits)
     : _parentPort(std::make_unique<ThreadMessagingPort>(CFRunLoopGetCurrent(), NativeScript::parentPerformWork, this))
     , _parentData(std::make_unique<ParentThreadData>(&WTF::Thread::current(), worker))
     , _workerPort(std::make_unique<ThreadMessagingPort>(nullptr, NativeScript::workerPerformWork, this))
-    , _workerData(nullptr) {
+    , _workerData(nullptr)
+    , _messageQueueLimits(messageQueueLimits)
+    , _areMessageQueuesClosed(false) {
     ASSERT_IS_PARENT_THREAD;
 }
 
+bool WorkerMessagingProxy::reserveMessageQueueSpace(MessageQueueUsage& usage, const MessageQueueUsage& peerUsage, size_t size) {
+    std::unique_lock<std::mutex> lock(_messageQueuesMutex);
+    if (_areMessageQueuesClosed)
+        return true;
+
+    auto fits = [&]() {
+        return usage.messages == 0
+            || ((!_messageQueueLimits.maxBytes || usage.bytes + size <= _messageQueueLimits.maxBytes)
+                && (!_messageQueueLimits.maxMessages || usage.messages < _messageQueueLimits.maxMessages));
+    };
+
+    while (!fits()) {
+        if (_messageQueueLimits.overflowPolicy != WorkerMessageQueueLimits::OverflowPolicy::Block)
+            return false;
+
+        // Waiting would freeze the UI, so the main thread is refused instead and postMessage throws
+        if (isMainThread())
+            return false;
+
+        // The peer can't take any messages while it is itself waiting to post to this thread,
+        // so the limit is exceeded instead of deadlocking.
+        if (peerUsage.isProducerBlocked || _areMessageQueuesClosed)
+            break;
+
+        usage.isProducerBlocked = true;
+        _messageQueuesDrained.wait(lock);
+        usage.isProducerBlocked = false;
+    }
+
+    usage.bytes += size;
+    usage.messages++;
+    return true;
+}
+
+void WorkerMessagingProxy::releaseMessageQueueSpace(MessageQueueUsage& usage, size_t size) {
+    std::lock_guard<std::mutex> lock(_messageQueuesMutex);
+    if (_areMessageQueuesClosed)
+        return;
+
+    ASSERT(usage.messages > 0 && usage.bytes >= size);
+    usage.bytes -= size;
+    usage.messages--;
+    if (usage.isProducerBlocked)
+        _messageQueuesDrained.notify_all();
+}
+
+void WorkerMessagingProxy::closeMessageQueues() {
+    // Messages to a worker which has stopped are never taken, so they are no longer accounted for
+    std::lock_guard<std::mutex> lock(_messageQueuesMutex);
+    _areMessageQueuesClosed = true;
+    _parentToWorkerUsage = MessageQueueUsage();
+    _workerToParentUsage = MessageQueueUsage();
+    _messageQueuesDrained.notify_all();
+}
+
 void WorkerMessagingProxy::parentStartWorkerThread(const WTF::String& applicationPath, const WTF::String& entryModuleId, const WTF::String& referrer) {
     ASSERT_IS_PARENT_THREAD;
 
@@ -154,19 +210,43 @@ void WorkerMessagingProxy::parentTerminateWorkerThread() {
     workerPrependTask(Func(workerRunLoopStop));
 }
 
-void WorkerMessagingProxy::parentPostMessageToWorkerThread(WTF::String& message) {
+bool WorkerMessagingProxy::parentPostMessageToWorkerThread(std::shared_ptr<WorkerMessage> message) {
     ASSERT_IS_PARENT_THREAD;
-    workerAppendTask(Func(workerOnMessagePostedFromParent, message));
+
+    if (!reserveMessageQueueSpace(_parentToWorkerUsage, _workerToParentUsage, message->size())) {
+        if (_messageQueueLimits.overflowPolicy == WorkerMessageQueueLimits::OverflowPolicy::Drop)
+            parentAppendTask(Func(parentOnMessageDropped));
+        return false;
+    }
+
+    workerAppendTask(Func(workerOnMessagePostedFromParent, WTFMove(message)));
+    return true;
 }
 
-void WorkerMessagingProxy::parentOnMessagePostedFromWorker(WTF::String& message) {
+void WorkerMessagingProxy::parentOnMessagePostedFromWorker(const std::shared_ptr<WorkerMessage>& message) {
     ASSERT_IS_PARENT_THREAD;
 
+    releaseMessageQueueSpace(_workerToParentUsage, message->size());
+
     ExecState* exec = _parentData->globalObject->globalExec();
-    JSValue value = JSONParse(exec, message);
+    JSValue value = message->deserialize(exec);
     _parentData->workerInstance->onmessage(exec, value);
 }
 
+void WorkerMessagingProxy::parentOnMessageDropped() {
+    ASSERT_IS_PARENT_THREAD;
+
+    ExecState* exec = _parentData->globalObject->globalExec();
+    _parentData->workerInstance->onmessageerror(exec, JSC::createRangeError(exec, "The message queue of the worker is full."_s));
+}
+
+size_t WorkerMessagingProxy::parentBufferedAmount() {
+    ASSERT_IS_PARENT_THREAD;
+
+    std::lock_guard<std::mutex> lock(_messageQueuesMutex);
+    return _parentToWorkerUsage.bytes;
+}
+
 void WorkerMessagingProxy::parentOnExceptionPosted(const String& message, const String& sourceUrl, unsigned lineNumber, unsigned colNumber) {
     ASSERT_IS_PARENT_THREAD;
 
@@ -213,18 +293,43 @@ void WorkerMessagingProxy::workerThreadInitialize(std::shared_ptr<WorkerMessagin
     Thread::current().detach();
 }
 
-void WorkerMessagingProxy::workerPostMessageToParent(WTF::String& message) {
+bool WorkerMessagingProxy::workerPostMessageToParent(std::shared_ptr<WorkerMessage> message) {
     ASSERT_IS_WORKER_THREAD;
-    parentAppendTask(Func(parentOnMessagePostedFromWorker, message));
+
+    if (!reserveMessageQueueSpace(_workerToParentUsage, _parentToWorkerUsage, message->size())) {
+        if (_messageQueueLimits.overflowPolicy == WorkerMessageQueueLimits::OverflowPolicy::Drop)
+            workerAppendTask(Func(workerOnMessageDropped));
+        return false;
+    }
+
+    parentAppendTask(Func(parentOnMessagePostedFromWorker, WTFMove(message)));
+    return true;
 }
 
-void WorkerMessagingProxy::workerOnMessagePostedFromParent(WTF::String& message) {
+void WorkerMessagingProxy::workerOnMessagePostedFromParent(const std::shared_ptr<WorkerMessage>& message) {
     ASSERT_IS_WORKER_THREAD;
+
+    releaseMessageQueueSpace(_parentToWorkerUsage, message->size());
+
     ExecState* exec = _workerData->globalObject()->globalExec();
-    JSValue value = JSONParse(exec, message);
+    JSValue value = message->deserialize(exec);
     _workerData->globalObject()->onmessage(exec, value);
 }
 
+void WorkerMessagingProxy::workerOnMessageDropped() {
+    ASSERT_IS_WORKER_THREAD;
+
+    ExecState* exec = _workerData->globalObject()->globalExec();
+    _workerData->globalObject()->onmessageerror(exec, JSC::createRangeError(exec, "The message queue of the parent is full."_s));
+}
+
+size_t WorkerMessagingProxy::workerBufferedAmount() {
+    ASSERT_IS_WORKER_THREAD;
+
+    std::lock_guard<std::mutex> lock(_messageQueuesMutex);
+    return _workerToParentUsage.bytes;
+}
+
 void WorkerMessagingProxy::workerClose() {
     ASSERT_IS_WORKER_THREAD;
     workerPrependTask(Func(workerClosed));
@@ -258,6 +363,7 @@ void WorkerMessagingProxy::workerRunLoopStop() {
     ASSERT_IS_WORKER_THREAD;
 
     _workerData->stopExecutingQueueTasksInTheCurrentLoopTick = true;
+    closeMessageQueues();
     LockHolder lock(_workerPortLock);
     CFRunLoopStop(_workerPort->runLoop);
     _workerPort->invalidate();
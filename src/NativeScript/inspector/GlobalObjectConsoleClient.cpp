@@ -7,6 +7,7 @@
 #include <JavaScriptCore/ConsoleMessage.h>
 #include <JavaScriptCore/Exception.h>
 #include <JavaScriptCore/InspectorConsoleAgent.h>
+#include <JavaScriptCore/InspectorFrontendRouter.h>
 #include <JavaScriptCore/ScriptArguments.h>
 #include <JavaScriptCore/ScriptCallStack.h>
 #include <JavaScriptCore/ScriptCallStackFactory.h>
@@ -32,6 +33,53 @@ static WTF::String smartStringifyObject(ExecState* exec, JSC::JSValue value) {
     return smartStringifyResult.toWTFString(exec);
 }
 
+// Tells whether value.toString() is going to be "[object Object]" without actually calling it,
+// i.e. the object uses the default Object.prototype.toString and has no custom @@toStringTag.
+// Only the structures of the object and its prototypes are looked at, so no getters run. Objects
+// which are not plain objects, e.g. proxies or native wrappers, are reported as having a custom one.
+static bool hasDefaultObjectToString(JSC::VM& vm, JSC::JSObject* object) {
+    JSC::JSGlobalObject* globalObject = object->globalObject();
+    JSC::JSObject* objectPrototype = globalObject->objectPrototype();
+
+    JSC::JSObject* current = object;
+    while (current != objectPrototype) {
+        if (current->type() != JSC::FinalObjectType) {
+            return false;
+        }
+
+        JSC::Structure* structure = current->structure(vm);
+        if (structure->get(vm, vm.propertyNames->toString) != JSC::invalidOffset || structure->get(vm, vm.propertyNames->toStringTagSymbol) != JSC::invalidOffset) {
+            return false;
+        }
+
+        JSC::JSValue prototype = current->getPrototypeDirect(vm);
+        if (!prototype.isObject()) {
+            return false;
+        }
+        current = asObject(prototype);
+    }
+
+    return objectPrototype->getDirect(vm, vm.propertyNames->toString) == globalObject->objectProtoToStringFunction()
+        && objectPrototype->structure(vm)->get(vm, vm.propertyNames->toStringTagSymbol) == JSC::invalidOffset;
+}
+
+// Stringifies plain objects with the smart stringify function and everything else with toString().
+static WTF::String getStringRepresentationOfArgument(JSC::ExecState* exec, JSC::JSValue value) {
+    auto scope = DECLARE_THROW_SCOPE(exec->vm());
+
+    if (value.isObject() && hasDefaultObjectToString(exec->vm(), asObject(value))) {
+        return smartStringifyObject(exec, value);
+    }
+
+    String valueAsString = value.toWTFString(exec);
+    RETURN_IF_EXCEPTION(scope, WTF::String());
+    if (value.isObject() && valueAsString.contains("[object Object]")) {
+        return smartStringifyObject(exec, value);
+    }
+
+    return valueAsString;
+}
+
 static WTF::String getStringRepresentationOfObject(JSC::ExecState* exec, JSC::JSValue value) {
     if (value.isFunction(exec->vm())) {
         return "()";
@@ -53,12 +101,7 @@ static WTF::String getStringRepresentationOfObject(JSC::ExecState* exec, JSC::JS
         output.append("]");
         return output.toString();
     } else if (value.isObject()) {
-        String valueAsString = value.toWTFString(exec);
-        if (valueAsString.contains("[object Object]")) {
-            return smartStringifyObject(exec, value);
-        } else {
-            return valueAsString;
-        }
+        return getStringRepresentationOfArgument(exec, value);
     }
 
     return value.toWTFString(exec);
@@ -90,13 +133,23 @@ void GlobalObjectConsoleClient::setLogToSystemConsole(bool shouldLog) {
     sLogToSystemConsole = shouldLog;
 }
 
-GlobalObjectConsoleClient::GlobalObjectConsoleClient(Inspector::InspectorConsoleAgent* consoleAgent, Inspector::InspectorLogAgent* logAgent)
+GlobalObjectConsoleClient::GlobalObjectConsoleClient(Inspector::InspectorConsoleAgent* consoleAgent, Inspector::InspectorLogAgent* logAgent, const Inspector::FrontendRouter& frontendRouter)
     : ConsoleClient()
     , m_consoleAgent(consoleAgent)
-    , m_logAgent(logAgent) {
+    , m_logAgent(logAgent)
+    , m_frontendRouter(frontendRouter) {
+}
+
+bool GlobalObjectConsoleClient::hasMessageSinks() const {
+    return GlobalObjectConsoleClient::logToSystemConsole() || m_frontendRouter.hasFrontends();
 }
 
 void GlobalObjectConsoleClient::messageWithTypeAndLevel(MessageType type, MessageLevel level, JSC::ExecState* exec, Ref<Inspector::ScriptArguments>&& arguments) {
+    // Formatting the arguments runs arbitrary JavaScript and is by far the most expensive part
+    // of a console call, so skip it altogether when nobody is going to see the message.
+    if (!this->hasMessageSinks()) {
+        return;
+    }
 
     String message = this->createMessageFromArguments(type, exec, arguments.copyRef());
     if (GlobalObjectConsoleClient::logToSystemConsole()) {
@@ -194,15 +247,10 @@ WTF::String GlobalObjectConsoleClient::createMessageFromArguments(MessageType ty
         builder.append(this->getDirMessage(exec, argumentValue));
     } else {
         for (size_t i = 0; i < arguments->argumentCount(); ++i) {
-            String argAsString = arguments->argumentAt(i).toWTFString(arguments->globalState());
             if (i > 0) {
                 builder.append(' ');
             }
-            if (argAsString.contains("[object Object]")) {
-                builder.append(smartStringifyObject(exec, arguments->argumentAt(i)));
-            } else {
-                builder.append(argAsString);
-            }
+            builder.append(getStringRepresentationOfArgument(exec, arguments->argumentAt(i)));
         }
     }
 
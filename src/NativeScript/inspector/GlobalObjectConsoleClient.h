@@ -8,12 +8,16 @@
 #include <JavaScriptCore/runtime/ConsoleClient.h>
 #include <stdio.h>
 
+namespace Inspector {
+class FrontendRouter;
+}
+
 namespace NativeScript {
 class GlobalObjectConsoleClient : public JSC::ConsoleClient {
     WTF_MAKE_FAST_ALLOCATED;
 
 public:
-    explicit GlobalObjectConsoleClient(Inspector::InspectorConsoleAgent*, Inspector::InspectorLogAgent*);
+    explicit GlobalObjectConsoleClient(Inspector::InspectorConsoleAgent*, Inspector::InspectorLogAgent*, const Inspector::FrontendRouter&);
     virtual ~GlobalObjectConsoleClient() {}
 
     static bool logToSystemConsole();
@@ -33,6 +37,7 @@ protected:
     virtual void recordEnd(JSC::ExecState*, Ref<Inspector::ScriptArguments>&&) override;
 
 private:
+    bool hasMessageSinks() const;
     void warnUnimplemented(const String& method);
     void internalAddMessage(MessageType, MessageLevel, JSC::ExecState*, RefPtr<Inspector::ScriptArguments>&&);
     WTF::String getDirMessage(JSC::ExecState*, JSC::JSValue);
@@ -42,6 +47,7 @@ private:
 
     Inspector::InspectorConsoleAgent* m_consoleAgent;
     Inspector::InspectorLogAgent* m_logAgent;
+    const Inspector::FrontendRouter& m_frontendRouter;
 };
 } // namespace NativeScript
 #endif /* GlobalObjectConsoleClient_h */
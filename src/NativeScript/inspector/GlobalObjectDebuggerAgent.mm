@@ -139,12 +139,13 @@ void GlobalObjectDebuggerAgent::setScriptSource(Inspector::ErrorString& error, c
                     return;
                 }
 
-                WTF::Vector<DiffChunk> diff = TextualDifferencesHelper::CompareStrings(moduleSource, sourceCode.provider()->source().toString());
+                WTF::String oldModuleSource = sourceCode.provider()->source().toString();
+                WTF::Vector<DiffChunk> diff = TextualDifferencesHelper::CompareStrings(moduleSource, oldModuleSource);
                 sourceProvider->setSource(moduleSource);
                 sourceCode.setEndOffset(sourceProvider->source().length());
 
                 m_globalObject->vm().clearSourceProviderCaches();
-                const ClearChangedCellsFunctor functor(vm, moduleRecord->sourceCode().provider()->url(), diff);
+                const ClearChangedCellsFunctor functor(vm, moduleRecord->sourceCode().provider()->url(), diff, oldModuleSource, moduleSource);
                 {
                     HeapIterationScope iterationScope(m_globalObject->vm().heap);
                     vm.heap.objectSpace().forEachLiveCell(iterationScope, functor);
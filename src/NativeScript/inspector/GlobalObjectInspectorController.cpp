@@ -125,7 +125,7 @@ GlobalObjectInspectorController::GlobalObjectInspectorController(GlobalObject& g
     m_debuggerAgent = debuggerAgent.get();
     m_consoleAgent = consoleAgent.get();
     m_logAgent = logAgent.get();
-    m_consoleClient = std::make_unique<GlobalObjectConsoleClient>(m_consoleAgent, m_logAgent);
+    m_consoleClient = std::make_unique<GlobalObjectConsoleClient>(m_consoleAgent, m_logAgent, m_frontendRouter.get());
 
     m_agents.append(WTFMove(inspectorAgent));
     m_agents.append(WTFMove(pageAgent));
@@ -0,0 +1,120 @@
+//
+//  ArgumentMarshallingBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "ArgumentWrites.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+// FFICall writes arguments with writeArgument() from ArgumentWrites.h, which is benchmarked here as is.
+// Only JSValue and its conversions need JavaScriptCore, a value is modelled as a double or an object
+// pointer instead. The baseline is the dispatch FFICall did before: an indirect call through each
+// parameter's method table, whose numeric and object writes are modelled the same way.
+namespace Benchmarks {
+using namespace NativeScript;
+
+struct Value {
+    bool isObject;
+    union {
+        double number;
+        void* object;
+    };
+};
+
+typedef void (*WriteFunction)(const Value&, void* buffer);
+
+struct MethodTable {
+    WriteFunction write;
+};
+
+template <typename T>
+__attribute__((noinline)) static void writeNumber(const Value& value, void* buffer) {
+    *static_cast<T*>(buffer) = value.number;
+}
+
+__attribute__((noinline)) static void writeObject(const Value& value, void* buffer) {
+    *static_cast<void**>(buffer) = value.isObject ? value.object : nullptr;
+}
+
+// The conversions FFICall::ArgumentMarshaller does with JavaScriptCore
+struct ValueMarshaller {
+    bool toBoolean(const Value& value) {
+        return value.isObject || value.number != 0;
+    }
+
+    double toNumber(const Value& value) {
+        return value.number;
+    }
+
+    void writeObject(const Value& value, void* buffer) {
+        *static_cast<void**>(buffer) = value.isObject ? value.object : nullptr;
+    }
+
+    void writeString(const Value& value, void* buffer) {
+        writeObject(value, buffer);
+    }
+
+    void writeGeneric(size_t, const Value& value, void* buffer) {
+        writeObject(value, buffer);
+    }
+};
+
+struct Parameter {
+    MethodTable methodTable;
+    ArgumentWrite write;
+};
+
+// (double, int, id, int64_t, id, double), the shape of a typical UIKit method with a few arguments
+static std::vector<Parameter> parameters() {
+    return {
+        { { &writeNumber<double> }, { ArgumentWriteKind::Double, 0 } },
+        { { &writeNumber<int32_t> }, { ArgumentWriteKind::Int32, 8 } },
+        { { &writeObject }, { ArgumentWriteKind::Object, 16 } },
+        { { &writeNumber<int64_t> }, { ArgumentWriteKind::Int64, 24 } },
+        { { &writeObject }, { ArgumentWriteKind::Object, 32 } },
+        { { &writeNumber<double> }, { ArgumentWriteKind::Double, 40 } },
+    };
+}
+
+static std::vector<Value> arguments() {
+    static int object;
+    Value number = { false, {} };
+    number.number = 42;
+    Value objectValue = { true, {} };
+    objectValue.object = &object;
+    return { number, number, objectValue, number, objectValue, number };
+}
+
+static void writeThroughMethodTables(benchmark::State& state) {
+    std::vector<Parameter> plan = parameters();
+    std::vector<Value> values = arguments();
+    alignas(16) uint8_t buffer[48];
+    for (auto _ : state) {
+        for (size_t i = 0; i < plan.size(); i++) {
+            plan[i].methodTable.write(values[i], buffer + plan[i].write.offset);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * plan.size());
+}
+BENCHMARK(writeThroughMethodTables);
+
+static void writeThroughResolvedKinds(benchmark::State& state) {
+    std::vector<Parameter> plan = parameters();
+    std::vector<Value> values = arguments();
+    ValueMarshaller marshaller;
+    alignas(16) uint8_t buffer[48];
+    for (auto _ : state) {
+        for (size_t i = 0; i < plan.size(); i++) {
+            writeArgument(marshaller, plan[i].write, buffer, i, values[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * plan.size());
+}
+BENCHMARK(writeThroughResolvedKinds);
+} // namespace Benchmarks
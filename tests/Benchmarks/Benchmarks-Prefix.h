@@ -0,0 +1,29 @@
+//
+//  Benchmarks-Prefix.h
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+//  Stands in for NativeScript-Prefix.h when the portable runtime sources are built for the benchmarks.
+//
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "WTFShims.h"
+
+typedef uint8_t UInt8;
+typedef uint8_t Byte;
+
+// Only passed through by the metadata lookups, never dereferenced
+typedef struct objc_class* Class;
+typedef struct objc_selector* SEL;
+
+// Only named by the signatures of the method tables in FFIType.h
+namespace JSC {
+class ExecState;
+class JSCell;
+class JSValue;
+class VM;
+} // namespace JSC
@@ -0,0 +1,126 @@
+//
+//  FFIBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "FFICache.h"
+#include "FFICallLayout.h"
+#include <benchmark/benchmark.h>
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+static const std::vector<const ffi_type*> voidSignature = { &ffi_type_void };
+static const std::vector<const ffi_type*> pointerSignature = { &ffi_type_pointer, &ffi_type_pointer, &ffi_type_pointer };
+static const std::vector<const ffi_type*> numericSignature = { &ffi_type_double, &ffi_type_double, &ffi_type_sint32, &ffi_type_float, &ffi_type_uint8 };
+
+static const std::vector<const ffi_type*>& signature(int64_t index) {
+    static const std::vector<const ffi_type*>* signatures[] = { &voidSignature, &pointerSignature, &numericSignature };
+    return *signatures[index];
+}
+
+static const char* signatureName(int64_t index) {
+    static const char* names[] = { "void()", "id(id, SEL)", "double(double, int, float, uint8_t)" };
+    return names[index];
+}
+
+// What initializing a call cost before cifs were shared between calls with the same signature
+static void prepareCif(benchmark::State& state) {
+    const std::vector<const ffi_type*>& types = signature(state.range(0));
+    for (auto _ : state) {
+        ffi_cif cif;
+        ffi_type** parameterTypes = new ffi_type*[types.size() - 1];
+        for (size_t i = 1; i < types.size(); i++) {
+            parameterTypes[i - 1] = const_cast<ffi_type*>(types[i]);
+        }
+        ffi_prep_cif(&cif, FFI_DEFAULT_ABI, types.size() - 1, const_cast<ffi_type*>(types[0]), parameterTypes);
+        benchmark::DoNotOptimize(cif);
+        delete[] parameterTypes;
+    }
+    state.SetLabel(signatureName(state.range(0)));
+}
+BENCHMARK(prepareCif)->DenseRange(0, 2);
+
+static void cachedCif(benchmark::State& state) {
+    const std::vector<const ffi_type*>& types = signature(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FFICache::global()->getCif(types));
+    }
+    state.SetLabel(signatureName(state.range(0)));
+}
+BENCHMARK(cachedCif)->DenseRange(0, 2);
+
+static void callLayout(benchmark::State& state) {
+    std::shared_ptr<ffi_cif> cif = FFICache::global()->getCif(signature(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FFICallLayout(*cif));
+    }
+    state.SetLabel(signatureName(state.range(0)));
+}
+BENCHMARK(callLayout)->DenseRange(0, 2);
+
+extern "C" {
+__attribute__((noinline)) void benchmarkVoidFunction() {
+    benchmark::ClobberMemory();
+}
+
+__attribute__((noinline)) void* benchmarkPointerFunction(void* receiver, void* selector) {
+    benchmark::DoNotOptimize(selector);
+    return receiver;
+}
+
+__attribute__((noinline)) double benchmarkNumericFunction(double a, int32_t b, float c, uint8_t d) {
+    return a + b + c + d;
+}
+}
+
+static void* benchmarkFunction(int64_t index) {
+    static void* functions[] = { reinterpret_cast<void*>(&benchmarkVoidFunction), reinterpret_cast<void*>(&benchmarkPointerFunction), reinterpret_cast<void*>(&benchmarkNumericFunction) };
+    return functions[index];
+}
+
+// One invocation the way FFICall::Invocation lays it out: a single buffer, with the argument pointers
+// set up once and the arguments written in place
+static void ffiCallThroughLayout(benchmark::State& state) {
+    std::shared_ptr<ffi_cif> cif = FFICache::global()->getCif(signature(state.range(0)));
+    FFICallLayout layout(*cif);
+    void* function = benchmarkFunction(state.range(0));
+
+    std::vector<uint8_t> buffer(layout.stackSize);
+    void** argsArray = reinterpret_cast<void**>(buffer.data() + layout.argsArrayOffset);
+    for (unsigned i = 0; i < cif->nargs; i++) {
+        argsArray[i] = buffer.data() + layout.argValueOffsets[i];
+        memset(argsArray[i], 0, cif->arg_types[i]->size);
+    }
+
+    for (auto _ : state) {
+        ffi_call(cif.get(), FFI_FN(function), buffer.data() + layout.returnOffset, argsArray);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(signatureName(state.range(0)));
+}
+BENCHMARK(ffiCallThroughLayout)->DenseRange(0, 2);
+
+// The floor for the above
+static void directCall(benchmark::State& state) {
+    double a = 1;
+    void* receiver = &a;
+    for (auto _ : state) {
+        switch (state.range(0)) {
+        case 0:
+            benchmarkVoidFunction();
+            break;
+        case 1:
+            benchmark::DoNotOptimize(benchmarkPointerFunction(receiver, nullptr));
+            break;
+        case 2:
+            benchmark::DoNotOptimize(benchmarkNumericFunction(a, 2, 3, 4));
+            break;
+        }
+    }
+    state.SetLabel(signatureName(state.range(0)));
+}
+BENCHMARK(directCall)->DenseRange(0, 2);
+} // namespace Benchmarks
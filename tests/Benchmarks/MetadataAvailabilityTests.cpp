@@ -0,0 +1,80 @@
+//
+//  MetadataAvailabilityTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "MetadataFixture.h"
+#include <gtest/gtest.h>
+
+namespace Benchmarks {
+using namespace Metadata;
+
+class MetadataAvailability : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!isSyntheticMetadata()) {
+            GTEST_SKIP() << "The versioned entities are only in the synthetic metadata";
+        }
+    }
+
+    void TearDown() override {
+        resetSimulatedSystemVersion();
+    }
+
+    static const InterfaceMeta* interfaceMeta(const char* name) {
+        return metadataFixture()->globalTable()->findInterfaceMeta(name);
+    }
+
+    static bool hasInstanceMethod(const char* className, const char* name, bool onlyIfAvailable = true) {
+        const Meta* meta = metadataFixture()->globalTable()->findMeta(className, /*onlyIfAvailable*/ false);
+        const BaseClassMeta* classMeta = static_cast<const BaseClassMeta*>(meta);
+        return !classMeta->members(name, strlen(name), MemberType::InstanceMethod, /*includeProtocols*/ true, onlyIfAvailable).isEmpty();
+    }
+};
+
+TEST_F(MetadataAvailability, EncodedVersionsRoundTrip) {
+    UInt8 version = encodeVersion(11, 3);
+    EXPECT_EQ(11, getMajorVersion(version));
+    EXPECT_EQ(3, getMinorVersion(version));
+    EXPECT_LT(encodeVersion(11, 4), encodeVersion(12, 0));
+}
+
+TEST_F(MetadataAvailability, EntitiesWithoutVersionAreAlwaysAvailable) {
+    setSimulatedSystemVersion(8, 0);
+    EXPECT_TRUE(interfaceMeta("TNSVersionedBase")->isAvailable());
+    EXPECT_TRUE(hasInstanceMethod("TNSVersionedBase", "protocolMethodSince10"));
+}
+
+TEST_F(MetadataAvailability, MembersAreCheckedAgainstTheMinorVersion) {
+    setSimulatedSystemVersion(11, 2);
+    EXPECT_TRUE(hasInstanceMethod("TNSVersionedBase", "methodSince11"));
+    EXPECT_FALSE(hasInstanceMethod("TNSVersionedBase", "methodSince11_3"));
+    EXPECT_TRUE(hasInstanceMethod("TNSVersionedBase", "methodSince11_3", /*onlyIfAvailable*/ false));
+
+    setSimulatedSystemVersion(11, 3);
+    EXPECT_TRUE(hasInstanceMethod("TNSVersionedBase", "methodSince11_3"));
+}
+
+TEST_F(MetadataAvailability, ProtocolMembersAreCheckedWhenLookedUp) {
+    setSimulatedSystemVersion(11, 4);
+    EXPECT_FALSE(hasInstanceMethod("TNSVersionedBase", "protocolMethodSince12"));
+    EXPECT_TRUE(hasInstanceMethod("TNSVersionedBase", "protocolMethodSince12", /*onlyIfAvailable*/ false));
+
+    // The protocols cache is shared, so the same entry must answer for a newer version too
+    setSimulatedSystemVersion(12, 0);
+    EXPECT_TRUE(hasInstanceMethod("TNSVersionedBase", "protocolMethodSince12"));
+}
+
+TEST_F(MetadataAvailability, UnavailableInterfacesFallBackToTheirNearestAvailableBase) {
+    setSimulatedSystemVersion(11, 0);
+    EXPECT_STREQ("TNSVersionedBase", interfaceMeta("TNSVersionedSince12_1")->jsName());
+
+    setSimulatedSystemVersion(12, 0);
+    EXPECT_STREQ("TNSVersionedSince12", interfaceMeta("TNSVersionedSince12_1")->jsName());
+
+    setSimulatedSystemVersion(12, 1);
+    EXPECT_STREQ("TNSVersionedSince12_1", interfaceMeta("TNSVersionedSince12_1")->jsName());
+}
+} // namespace Benchmarks
@@ -0,0 +1,212 @@
+//
+//  MetadataBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "MetadataFixture.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace Benchmarks {
+using namespace Metadata;
+
+struct Identifier {
+    std::string name;
+    unsigned hash;
+};
+
+static Identifier identifier(const std::string& name) {
+    return { name, WTF::StringHasher::computeHashAndMaskTop8Bits(reinterpret_cast<const LChar*>(name.c_str()), name.size()) };
+}
+
+static void setMetadataLabel(benchmark::State& state) {
+    state.SetLabel(isSyntheticMetadata() ? "synthetic metadata" : "metadata from NS_BENCHMARK_METADATA");
+}
+
+// Every global with its hash computed up front, as JS identifiers cache their hash
+static const std::vector<Identifier>& globalIdentifiers() {
+    static const std::vector<Identifier> identifiers = [] {
+        std::vector<Identifier> result;
+        const GlobalTable* globalTable = metadataFixture()->globalTable();
+        for (GlobalTable::iterator it = globalTable->begin(); it != globalTable->end(); ++it) {
+            result.push_back(identifier((*it)->jsName()));
+        }
+        // Consecutive lookups should not hit neighbouring buckets
+        std::shuffle(result.begin(), result.end(), std::mt19937(0));
+        return result;
+    }();
+    return identifiers;
+}
+
+static void findMetaHit(benchmark::State& state) {
+    const GlobalTable* globalTable = metadataFixture()->globalTable();
+    const std::vector<Identifier>& identifiers = globalIdentifiers();
+    size_t i = 0;
+    for (auto _ : state) {
+        const Identifier& current = identifiers[i++ % identifiers.size()];
+        benchmark::DoNotOptimize(globalTable->findMeta(current.name.c_str(), current.name.size(), current.hash));
+    }
+    setMetadataLabel(state);
+}
+BENCHMARK(findMetaHit);
+
+// Global lookups which miss, e.g. JS globals checked against metadata before falling through
+static void findMetaMiss(benchmark::State& state) {
+    const GlobalTable* globalTable = metadataFixture()->globalTable();
+    std::vector<Identifier> identifiers;
+    for (const Identifier& global : globalIdentifiers()) {
+        identifiers.push_back(identifier(global.name + "Missing"));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const Identifier& current = identifiers[i++ % identifiers.size()];
+        benchmark::DoNotOptimize(globalTable->findMeta(current.name.c_str(), current.name.size(), current.hash));
+    }
+    setMetadataLabel(state);
+}
+BENCHMARK(findMetaMiss);
+
+// The const char* overloads used with names coming from metadata, which hash on every call
+static void findInterfaceMetaByCString(benchmark::State& state) {
+    const GlobalTable* globalTable = metadataFixture()->globalTable();
+    std::vector<std::string> names;
+    for (const Identifier& global : globalIdentifiers()) {
+        const Meta* meta = globalTable->findMeta(global.name.c_str(), global.name.size(), global.hash);
+        if (meta->type() == MetaType::Interface) {
+            names.push_back(global.name);
+        }
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(globalTable->findInterfaceMeta(names[i++ % names.size()].c_str()));
+    }
+    setMetadataLabel(state);
+}
+BENCHMARK(findInterfaceMetaByCString);
+
+struct MemberLookup {
+    const BaseClassMeta* meta;
+    std::string name;
+};
+
+static std::vector<MemberLookup> memberLookups(bool (*accept)(const BaseClassMeta*, const char* jsName)) {
+    std::vector<MemberLookup> result;
+    const GlobalTable* globalTable = metadataFixture()->globalTable();
+    for (GlobalTable::iterator it = globalTable->begin(); it != globalTable->end(); ++it) {
+        if ((*it)->type() != MetaType::Interface) {
+            continue;
+        }
+
+        const InterfaceMeta* interfaceMeta = static_cast<const InterfaceMeta*>(*it);
+        for (ArrayOfPtrTo<MethodMeta>::iterator method = interfaceMeta->instanceMethods->begin(); method != interfaceMeta->instanceMethods->end(); ++method) {
+            if (accept(interfaceMeta, (*method)->jsName())) {
+                result.push_back({ interfaceMeta, (*method)->jsName() });
+            }
+        }
+    }
+    return result;
+}
+
+static void instanceMethodLookup(benchmark::State& state, const std::vector<MemberLookup>& lookups) {
+    if (lookups.empty()) {
+        state.SkipWithError("The metadata has no such members");
+        return;
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const MemberLookup& lookup = lookups[i++ % lookups.size()];
+        benchmark::DoNotOptimize(lookup.meta->members(lookup.name.c_str(), lookup.name.size(), MemberType::InstanceMethod));
+    }
+    setMetadataLabel(state);
+}
+
+// Methods declared in a single class of the hierarchy
+static void instanceMethodLookupOwn(benchmark::State& state) {
+    static const std::vector<MemberLookup> lookups = memberLookups([](const BaseClassMeta* meta, const char* jsName) {
+        const InterfaceMeta* baseMeta = static_cast<const InterfaceMeta*>(meta)->baseMeta();
+        return !baseMeta || baseMeta->members(jsName, strlen(jsName), MemberType::InstanceMethod, /*includeProtocols*/ false).empty();
+    });
+    instanceMethodLookup(state, lookups);
+}
+BENCHMARK(instanceMethodLookupOwn);
+
+// Overridden methods, whose overloads are collected from the whole inheritance chain
+static void instanceMethodLookupOverridden(benchmark::State& state) {
+    static const std::vector<MemberLookup> lookups = memberLookups([](const BaseClassMeta* meta, const char* jsName) {
+        const InterfaceMeta* baseMeta = static_cast<const InterfaceMeta*>(meta)->baseMeta();
+        return baseMeta && !baseMeta->members(jsName, strlen(jsName), MemberType::InstanceMethod, /*includeProtocols*/ false).empty();
+    });
+    instanceMethodLookup(state, lookups);
+}
+BENCHMARK(instanceMethodLookupOverridden);
+
+// Methods which are only declared by adopted protocols
+static void instanceMethodLookupProtocol(benchmark::State& state) {
+    static const std::vector<MemberLookup> lookups = [] {
+        std::vector<MemberLookup> result;
+        const GlobalTable* globalTable = metadataFixture()->globalTable();
+        for (GlobalTable::iterator it = globalTable->begin(); it != globalTable->end(); ++it) {
+            if ((*it)->type() != MetaType::Interface) {
+                continue;
+            }
+
+            const BaseClassMeta* meta = static_cast<const BaseClassMeta*>(*it);
+            for (const ProtocolMeta* protocolMeta : meta->protocolsClosure()) {
+                for (ArrayOfPtrTo<MethodMeta>::iterator method = protocolMeta->instanceMethods->begin(); method != protocolMeta->instanceMethods->end(); ++method) {
+                    const char* jsName = (*method)->jsName();
+                    if (meta->members(jsName, strlen(jsName), MemberType::InstanceMethod, /*includeProtocols*/ false).empty()) {
+                        result.push_back({ meta, jsName });
+                    }
+                }
+            }
+        }
+        return result;
+    }();
+    instanceMethodLookup(state, lookups);
+}
+BENCHMARK(instanceMethodLookupProtocol)->Threads(1)->Threads(4)->Threads(8);
+
+// Conformance checks of the classes with protocols, which read the shared protocols cache
+static void protocolsClosureLookup(benchmark::State& state) {
+    static const std::vector<const BaseClassMeta*> metas = [] {
+        std::vector<const BaseClassMeta*> result;
+        const GlobalTable* globalTable = metadataFixture()->globalTable();
+        for (GlobalTable::iterator it = globalTable->begin(); it != globalTable->end(); ++it) {
+            if ((*it)->type() == MetaType::Interface && static_cast<const BaseClassMeta*>(*it)->protocols->count > 0) {
+                result.push_back(static_cast<const BaseClassMeta*>(*it));
+            }
+        }
+        return result;
+    }();
+    if (metas.empty()) {
+        state.SkipWithError("The metadata has no classes with protocols");
+        return;
+    }
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(metas[i++ % metas.size()]->protocolsClosure().size());
+    }
+    setMetadataLabel(state);
+}
+BENCHMARK(protocolsClosureLookup)->Threads(1)->Threads(4)->Threads(8);
+
+static void globalTableIteration(benchmark::State& state) {
+    const GlobalTable* globalTable = metadataFixture()->globalTable();
+    int64_t count = 0;
+    for (auto _ : state) {
+        for (GlobalTable::iterator it = globalTable->begin(); it != globalTable->end(); ++it) {
+            benchmark::DoNotOptimize(*it);
+            count++;
+        }
+    }
+    state.SetItemsProcessed(count);
+    setMetadataLabel(state);
+}
+BENCHMARK(globalTableIteration);
+} // namespace Benchmarks
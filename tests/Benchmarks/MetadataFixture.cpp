@@ -0,0 +1,308 @@
+//
+//  MetadataFixture.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "MetadataFixture.h"
+#include <fstream>
+#include <iterator>
+#include <map>
+
+namespace Benchmarks {
+using namespace Metadata;
+
+static_assert(sizeof(Meta) == 10, "The synthetic metadata is written by hand and must match the file layout");
+static_assert(sizeof(MethodMeta) == sizeof(Meta) + 8, "");
+static_assert(sizeof(PropertyMeta) == sizeof(Meta) + 8, "");
+static_assert(sizeof(FunctionMeta) == sizeof(Meta) + 4, "");
+static_assert(sizeof(ProtocolMeta) == sizeof(Meta) + 22, "");
+static_assert(sizeof(InterfaceMeta) == sizeof(ProtocolMeta) + 4, "");
+
+static const int chainsCount = 256;
+static const int chainDepth = 8;
+static const int ownMethodsCount = 16;
+static const int ownPropertiesCount = 4;
+static const int protocolMethodsCount = 8;
+static const int functionsCount = 2048;
+
+/// Lays out a metadata file: the global table, a single top level module and the heap, with every
+/// entity written in the heap and referred to by its offset there.
+class MetadataWriter {
+public:
+    MetadataWriter() {
+        // Offset 0 is the null pointer
+        this->_heap.push_back(0);
+        this->_module = this->offset();
+        this->put<uint8_t>(1);
+        this->put<int32_t>(this->string("TNSBenchmarks"));
+        this->put<int32_t>(0);
+    }
+
+    int32_t string(const std::string& value) {
+        auto it = this->_strings.find(value);
+        if (it != this->_strings.end()) {
+            return it->second;
+        }
+
+        int32_t result = this->offset();
+        this->_heap.insert(this->_heap.end(), value.c_str(), value.c_str() + value.size() + 1);
+        this->_strings.emplace(value, result);
+        return result;
+    }
+
+    int32_t array(const std::vector<int32_t>& items) {
+        int32_t result = this->offset();
+        this->put<ArrayCount>(items.size());
+        for (int32_t item : items) {
+            this->put<int32_t>(item);
+        }
+        return result;
+    }
+
+    // Member arrays are binary searched by JS name
+    int32_t sortedArray(std::vector<std::pair<std::string, int32_t>> members) {
+        std::stable_sort(members.begin(), members.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        std::vector<int32_t> items;
+        for (const auto& member : members) {
+            items.push_back(member.second);
+        }
+        return this->array(items);
+    }
+
+    int32_t encodings(const std::vector<BinaryTypeEncodingType>& types) {
+        int32_t result = this->offset();
+        this->put<ArrayCount>(types.size());
+        for (BinaryTypeEncodingType type : types) {
+            this->put<uint8_t>(type);
+        }
+        return result;
+    }
+
+    int32_t method(const std::string& jsName, const std::vector<BinaryTypeEncodingType>& types, uint8_t introducedIn = 0) {
+        int32_t encodings = this->encodings(types);
+        int32_t result = this->meta(jsName, MetaType::Undefined, 0, introducedIn);
+        this->put<int32_t>(encodings);
+        this->put<int32_t>(0);
+        return result;
+    }
+
+    int32_t property(const std::string& jsName, int32_t getter) {
+        int32_t result = this->meta(jsName, MetaType::Undefined, 1 << MetaFlags::PropertyHasGetter);
+        this->put<int32_t>(getter);
+        this->put<int32_t>(0);
+        return result;
+    }
+
+    struct Members {
+        std::vector<std::pair<std::string, int32_t>> instanceMethods;
+        std::vector<std::pair<std::string, int32_t>> instanceProperties;
+        std::vector<std::string> protocols;
+    };
+
+    void baseClass(const std::string& jsName, MetaType type, const Members& members, const char* baseName = nullptr, uint8_t introducedIn = 0) {
+        int32_t instanceMethods = this->sortedArray(members.instanceMethods);
+        int32_t staticMethods = this->array({});
+        int32_t instanceProperties = this->sortedArray(members.instanceProperties);
+        int32_t staticProperties = this->array({});
+        std::vector<int32_t> protocols;
+        for (const std::string& protocol : members.protocols) {
+            protocols.push_back(this->string(protocol));
+        }
+        int32_t protocolsArray = this->array(protocols);
+        int32_t baseNameString = baseName ? this->string(baseName) : 0;
+
+        this->global(jsName, this->meta(jsName, type, 0, introducedIn));
+        this->put<int32_t>(instanceMethods);
+        this->put<int32_t>(staticMethods);
+        this->put<int32_t>(instanceProperties);
+        this->put<int32_t>(staticProperties);
+        this->put<int32_t>(protocolsArray);
+        this->put<int16_t>(0);
+        if (type == MetaType::Interface) {
+            this->put<int32_t>(baseNameString);
+        }
+    }
+
+    void function(const std::string& jsName, const std::vector<BinaryTypeEncodingType>& types) {
+        int32_t encodings = this->encodings(types);
+        this->global(jsName, this->meta(jsName, MetaType::Function, 0));
+        this->put<int32_t>(encodings);
+    }
+
+    // Buckets are picked with the same hash as GlobalTable::findMeta
+    std::vector<char> finish() {
+        std::vector<std::vector<int32_t>> buckets(this->_globals.size());
+        for (const auto& global : this->_globals) {
+            unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits(reinterpret_cast<const LChar*>(global.first.c_str()), global.first.size());
+            buckets[hash % buckets.size()].push_back(global.second);
+        }
+
+        std::vector<int32_t> header = { static_cast<int32_t>(buckets.size()) };
+        for (const std::vector<int32_t>& bucket : buckets) {
+            header.push_back(bucket.empty() ? 0 : this->array(bucket));
+        }
+        header.push_back(1);
+        header.push_back(this->_module);
+
+        std::vector<char> file(reinterpret_cast<const char*>(header.data()), reinterpret_cast<const char*>(header.data() + header.size()));
+        file.insert(file.end(), this->_heap.begin(), this->_heap.end());
+        return file;
+    }
+
+private:
+    int32_t offset() const {
+        return static_cast<int32_t>(this->_heap.size());
+    }
+
+    template <typename T>
+    void put(T value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        this->_heap.insert(this->_heap.end(), bytes, bytes + sizeof(T));
+    }
+
+    int32_t meta(const std::string& jsName, MetaType type, uint8_t flags, uint8_t introducedIn = 0) {
+        int32_t name = this->string(jsName);
+        int32_t result = this->offset();
+        this->put<int32_t>(name);
+        this->put<int32_t>(this->_module);
+        this->put<uint8_t>(type | flags);
+        this->put<uint8_t>(introducedIn);
+        return result;
+    }
+
+    void global(const std::string& jsName, int32_t meta) {
+        this->_globals.emplace_back(jsName, meta);
+    }
+
+    std::vector<char> _heap;
+    std::map<std::string, int32_t> _strings;
+    std::vector<std::pair<std::string, int32_t>> _globals;
+    int32_t _module;
+};
+
+static std::vector<char> syntheticMetadata() {
+    MetadataWriter writer;
+    const std::vector<BinaryTypeEncodingType> idGetter = { IdEncoding };
+    const std::vector<BinaryTypeEncodingType> voidWithInt = { VoidEncoding, IntEncoding };
+    const std::vector<BinaryTypeEncodingType> boolWithId = { BoolEncoding, IdEncoding };
+
+    // Methods which every class in a chain overrides, so looking them up walks the whole chain
+    auto addOverrides = [&](MetadataWriter::Members& members) {
+        members.instanceMethods.emplace_back("init", writer.method("init", idGetter));
+        members.instanceMethods.emplace_back("description", writer.method("description", idGetter));
+        members.instanceMethods.emplace_back("isEqual", writer.method("isEqual", boolWithId));
+    };
+
+    MetadataWriter::Members rootMembers;
+    addOverrides(rootMembers);
+    rootMembers.instanceProperties.emplace_back("hash", writer.property("hash", writer.method("hash", idGetter)));
+    writer.baseClass("NSObject", MetaType::Interface, rootMembers);
+
+    MetadataWriter::Members baseProtocolMembers;
+    for (int i = 0; i < protocolMethodsCount; i++) {
+        std::string name = "baseProtocolMethod" + std::to_string(i);
+        baseProtocolMembers.instanceMethods.emplace_back(name, writer.method(name, voidWithInt));
+    }
+    writer.baseClass("TNSBaseProtocol", MetaType::ProtocolType, baseProtocolMembers);
+
+    for (int chain = 0; chain < chainsCount; chain++) {
+        std::string chainName = "TNSChain" + std::to_string(chain);
+
+        MetadataWriter::Members protocolMembers;
+        for (int i = 0; i < protocolMethodsCount; i++) {
+            std::string name = chainName + "ProtocolMethod" + std::to_string(i);
+            protocolMembers.instanceMethods.emplace_back(name, writer.method(name, voidWithInt));
+        }
+        protocolMembers.protocols.push_back("TNSBaseProtocol");
+        writer.baseClass(chainName + "Protocol", MetaType::ProtocolType, protocolMembers);
+
+        std::string baseName = "NSObject";
+        for (int level = 0; level < chainDepth; level++) {
+            std::string className = chainName + "Level" + std::to_string(level);
+
+            MetadataWriter::Members members;
+            addOverrides(members);
+            for (int i = 0; i < ownMethodsCount; i++) {
+                std::string name = "method" + std::to_string(i) + "Of" + className;
+                members.instanceMethods.emplace_back(name, writer.method(name, voidWithInt));
+            }
+            for (int i = 0; i < ownPropertiesCount; i++) {
+                std::string name = "property" + std::to_string(i) + "Of" + className;
+                members.instanceProperties.emplace_back(name, writer.property(name, writer.method(name, idGetter)));
+            }
+            members.protocols.push_back(chainName + "Protocol");
+            writer.baseClass(className, MetaType::Interface, members, baseName.c_str());
+
+            baseName = className;
+        }
+    }
+
+    // APIs introduced in later OS versions, for availability checks against a simulated version
+    MetadataWriter::Members versionedProtocolMembers;
+    versionedProtocolMembers.instanceMethods.emplace_back("protocolMethodSince10", writer.method("protocolMethodSince10", voidWithInt));
+    versionedProtocolMembers.instanceMethods.emplace_back("protocolMethodSince12", writer.method("protocolMethodSince12", voidWithInt, encodeVersion(12, 0)));
+    writer.baseClass("TNSVersionedProtocol", MetaType::ProtocolType, versionedProtocolMembers);
+
+    MetadataWriter::Members versionedMembers;
+    versionedMembers.instanceMethods.emplace_back("methodSince11", writer.method("methodSince11", voidWithInt, encodeVersion(11, 0)));
+    versionedMembers.instanceMethods.emplace_back("methodSince11_3", writer.method("methodSince11_3", voidWithInt, encodeVersion(11, 3)));
+    versionedMembers.protocols.push_back("TNSVersionedProtocol");
+    writer.baseClass("TNSVersionedBase", MetaType::Interface, versionedMembers, "NSObject");
+    writer.baseClass("TNSVersionedSince12", MetaType::Interface, {}, "TNSVersionedBase", encodeVersion(12, 0));
+    writer.baseClass("TNSVersionedSince12_1", MetaType::Interface, {}, "TNSVersionedSince12", encodeVersion(12, 1));
+
+    // Sibling protocols which declare the same members, and a parent protocol with an overload of
+    // one of them, for lookups which have to merge protocols
+    MetadataWriter::Members sharedParentMembers;
+    sharedParentMembers.instanceMethods.emplace_back("sharedMethod", writer.method("sharedMethod", { VoidEncoding, IntEncoding, IdEncoding }));
+    sharedParentMembers.instanceMethods.emplace_back("parentOnlyMethod", writer.method("parentOnlyMethod", voidWithInt));
+    writer.baseClass("TNSSharedParentProtocol", MetaType::ProtocolType, sharedParentMembers);
+
+    for (const char* siblingName : { "TNSSiblingProtocolA", "TNSSiblingProtocolB" }) {
+        MetadataWriter::Members siblingMembers;
+        siblingMembers.instanceMethods.emplace_back("sharedMethod", writer.method("sharedMethod", voidWithInt));
+        siblingMembers.instanceProperties.emplace_back("sharedProperty", writer.property("sharedProperty", writer.method("sharedProperty", idGetter)));
+        siblingMembers.protocols.push_back("TNSSharedParentProtocol");
+        writer.baseClass(siblingName, MetaType::ProtocolType, siblingMembers);
+    }
+
+    MetadataWriter::Members siblingsAdopterMembers;
+    siblingsAdopterMembers.protocols = { "TNSSiblingProtocolA", "TNSSiblingProtocolB" };
+    writer.baseClass("TNSSiblingsAdopter", MetaType::Interface, siblingsAdopterMembers, "NSObject");
+
+    for (int i = 0; i < functionsCount; i++) {
+        writer.function("TNSFunction" + std::to_string(i), voidWithInt);
+    }
+
+    return writer.finish();
+}
+
+static bool isSynthetic;
+
+const MetaFile* metadataFixture() {
+    static std::vector<char>* blob = [] {
+        if (const char* path = getenv("NS_BENCHMARK_METADATA")) {
+            std::ifstream file(path, std::ios::binary);
+            if (file) {
+                return new std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+            fprintf(stderr, "Could not read %s, falling back to synthetic metadata\n", path);
+        }
+
+        isSynthetic = true;
+        return new std::vector<char>(syntheticMetadata());
+    }();
+
+    if (MetaFile::instance() == nullptr) {
+        MetaFile::setInstance(blob->data());
+    }
+    return MetaFile::instance();
+}
+
+bool isSyntheticMetadata() {
+    metadataFixture();
+    return isSynthetic;
+}
+} // namespace Benchmarks
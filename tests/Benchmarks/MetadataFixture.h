@@ -0,0 +1,31 @@
+//
+//  MetadataFixture.h
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __Benchmarks__MetadataFixture__
+#define __Benchmarks__MetadataFixture__
+
+#include "Metadata.h"
+
+namespace Benchmarks {
+
+/// Installs the metadata the lookups run against as MetaFile::instance(), once per process.
+///
+/// The blob at $NS_BENCHMARK_METADATA is used when set, e.g. the metadata-<arch>.bin produced by the
+/// metadata generator for an application. Otherwise a synthetic blob is laid out the same way:
+/// interfaces in inheritance chains which override some of their methods, adopted protocols and functions.
+const Metadata::MetaFile* metadataFixture();
+
+/// Whether the installed metadata is the synthetic one, for labelling results.
+bool isSyntheticMetadata();
+
+/// Checks availability as if running on the given OS version instead of one on which everything is
+/// available. Unlike the version read on devices, it can change during the process.
+void setSimulatedSystemVersion(UInt8 majorVersion, UInt8 minorVersion);
+void resetSimulatedSystemVersion();
+} // namespace Benchmarks
+
+#endif /* defined(__Benchmarks__MetadataFixture__) */
@@ -0,0 +1,135 @@
+//
+//  MetadataLookupTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "MetadataFixture.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Benchmarks {
+using namespace Metadata;
+
+static const MemberType memberTypes[] = { MemberType::InstanceMethod, MemberType::StaticMethod, MemberType::InstanceProperty, MemberType::StaticProperty };
+
+static const ArrayOfPtrTo<MemberMeta>& declaredMembers(const BaseClassMeta* meta, MemberType type) {
+    switch (type) {
+    case MemberType::InstanceMethod:
+        return meta->instanceMethods->castTo<PtrTo<MemberMeta>>();
+    case MemberType::StaticMethod:
+        return meta->staticMethods->castTo<PtrTo<MemberMeta>>();
+    case MemberType::InstanceProperty:
+        return meta->instanceProps->castTo<PtrTo<MemberMeta>>();
+    case MemberType::StaticProperty:
+        break;
+    }
+    return meta->staticProps->castTo<PtrTo<MemberMeta>>();
+}
+
+/// Protocol members looked up the way they were before the protocols cache: every adopted protocol
+/// is resolved by name on each lookup and searched for its own members first.
+static MembersCollection uncachedMembers(const BaseClassMeta* meta, const char* identifier, size_t length, MemberType type, bool onlyIfAvailable) {
+    MembersCollection result = meta->members(identifier, length, type, /*includeProtocols*/ false, onlyIfAvailable);
+    if (result.size() > 0) {
+        return result;
+    }
+
+    for (Array<Metadata::String>::iterator it = meta->protocols->begin(); it != meta->protocols->end(); ++it) {
+        if (const ProtocolMeta* protocolMeta = MetaFile::instance()->globalTable()->findProtocol((*it).valuePtr())) {
+            MembersCollection members = uncachedMembers(protocolMeta, identifier, length, type, onlyIfAvailable);
+            result.add(members.begin(), members.end());
+        }
+    }
+    return result;
+}
+
+/// Names of the members a lookup on the meta can find: those of its base classes and protocols.
+static void collectReachableNames(const BaseClassMeta* meta, MemberType type, std::set<std::string>& names) {
+    const ArrayOfPtrTo<MemberMeta>& members = declaredMembers(meta, type);
+    for (ArrayOfPtrTo<MemberMeta>::iterator it = members.begin(); it != members.end(); ++it) {
+        names.insert((*it)->jsName());
+    }
+
+    for (const ProtocolMeta* protocolMeta : meta->protocolsClosure()) {
+        collectReachableNames(protocolMeta, type, names);
+    }
+
+    if (meta->type() == MetaType::Interface) {
+        if (const InterfaceMeta* baseMeta = static_cast<const InterfaceMeta*>(meta)->baseMeta()) {
+            collectReachableNames(baseMeta, type, names);
+        }
+    }
+}
+
+static std::set<const MemberMeta*> asSet(const MembersCollection& members) {
+    return std::set<const MemberMeta*>(members.begin(), members.end());
+}
+
+static std::vector<std::string> lookup(const char* className, const char* name, MemberType type) {
+    const BaseClassMeta* meta = static_cast<const BaseClassMeta*>(metadataFixture()->globalTable()->findMeta(className));
+    std::vector<std::string> result;
+    for (const MemberMeta* member : meta->members(name, strlen(name), type)) {
+        std::string declaration = member->jsName();
+        if (type == MemberType::InstanceMethod) {
+            declaration += "/" + std::to_string(static_cast<const MethodMeta*>(member)->encodings()->count);
+        }
+        result.push_back(declaration);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+TEST(MetadataLookup, CachedProtocolsFindTheSameMembersAsUncached) {
+    const GlobalTable* globalTable = metadataFixture()->globalTable();
+    size_t comparedLookups = 0;
+    for (const Meta* meta : *globalTable) {
+        if (meta->type() != MetaType::Interface && meta->type() != MetaType::ProtocolType) {
+            continue;
+        }
+
+        const BaseClassMeta* classMeta = static_cast<const BaseClassMeta*>(meta);
+        for (MemberType type : memberTypes) {
+            std::set<std::string> names = { "notAMember" };
+            collectReachableNames(classMeta, type, names);
+
+            for (const std::string& name : names) {
+                for (bool onlyIfAvailable : { true, false }) {
+                    MembersCollection cached = classMeta->members(name.c_str(), name.size(), type, /*includeProtocols*/ true, onlyIfAvailable);
+                    MembersCollection uncached = uncachedMembers(classMeta, name.c_str(), name.size(), type, onlyIfAvailable);
+                    ASSERT_EQ(asSet(uncached), asSet(cached)) << classMeta->jsName() << "." << name << " (member type " << type << ")";
+                    comparedLookups++;
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(comparedLookups, 0u);
+}
+
+class MetadataLookupSiblings : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!isSyntheticMetadata()) {
+            GTEST_SKIP() << "The sibling protocols are only in the synthetic metadata";
+        }
+    }
+};
+
+TEST_F(MetadataLookupSiblings, SameArityMethodsOfSiblingProtocolsAreAllFound) {
+    EXPECT_EQ((std::vector<std::string>{ "sharedMethod/2", "sharedMethod/2" }), lookup("TNSSiblingsAdopter", "sharedMethod", MemberType::InstanceMethod));
+}
+
+TEST_F(MetadataLookupSiblings, PropertiesOfSiblingProtocolsAreAllFound) {
+    EXPECT_EQ((std::vector<std::string>{ "sharedProperty", "sharedProperty" }), lookup("TNSSiblingsAdopter", "sharedProperty", MemberType::InstanceProperty));
+}
+
+TEST_F(MetadataLookupSiblings, InheritedProtocolsAreSearchedOnlyForNamesTheProtocolLacks) {
+    // The parent's overload is hidden by the siblings' own declarations
+    EXPECT_EQ((std::vector<std::string>{ "sharedMethod/3" }), lookup("TNSSharedParentProtocol", "sharedMethod", MemberType::InstanceMethod));
+    EXPECT_EQ((std::vector<std::string>{ "parentOnlyMethod/2" }), lookup("TNSSiblingsAdopter", "parentOnlyMethod", MemberType::InstanceMethod));
+}
+} // namespace Benchmarks
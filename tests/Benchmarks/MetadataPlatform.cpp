@@ -0,0 +1,49 @@
+//
+//  MetadataPlatform.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "MetadataFixture.h"
+
+// The parts of Metadata.mm which the lookups depend on, checking availability against a simulated
+// OS version instead of the one NSProcessInfo reports.
+namespace Benchmarks {
+
+// Everything is available unless a test simulates an older OS
+static UInt8 simulatedSystemVersion = 0xFF;
+
+void setSimulatedSystemVersion(UInt8 majorVersion, UInt8 minorVersion) {
+    simulatedSystemVersion = Metadata::encodeVersion(majorVersion, minorVersion);
+}
+
+void resetSimulatedSystemVersion() {
+    simulatedSystemVersion = 0xFF;
+}
+} // namespace Benchmarks
+
+namespace Metadata {
+
+static UInt8 getSystemVersion() {
+    return Benchmarks::simulatedSystemVersion;
+}
+
+bool Meta::isAvailable() const {
+    return isIntroducedBy(this->introducedIn(), getSystemVersion());
+}
+
+const InterfaceMeta* GlobalTable::findInterfaceMeta(const char* identifierString, size_t length, unsigned hash) const {
+    const Meta* meta = this->findMeta(identifierString, length, hash, /*onlyIfAvailable*/ false);
+    if (meta == nullptr || meta->type() != MetaType::Interface) {
+        return nullptr;
+    }
+
+    const InterfaceMeta* interfaceMeta = static_cast<const InterfaceMeta*>(meta);
+    if (interfaceMeta->isAvailable()) {
+        return interfaceMeta;
+    }
+
+    return this->findInterfaceMeta(interfaceMeta->baseName());
+}
+} // namespace Metadata
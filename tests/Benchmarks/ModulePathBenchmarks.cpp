@@ -0,0 +1,174 @@
+//
+//  ModulePathBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "ModuleBundle.h"
+#include "ModulePathFixture.h"
+#include <benchmark/benchmark.h>
+#include <map>
+
+// Module resolution against an application laid out in a temporary directory, as loose files or packed
+// in app.tnsmodules the way build/scripts/pack-modules.py does it:
+//
+//     app/main.js, app/views/view<N>.js, app/data/settings.json
+//     app/node_modules/package<N>/package.json ("main": "lib/index"), lib/index.js, lib/util.js
+//     app/node_modules/plain<N>/index.js
+namespace Benchmarks {
+using namespace NativeScript;
+
+static const int packagesCount = 32;
+static const int viewsCount = 64;
+
+class ApplicationFixture {
+public:
+    explicit ApplicationFixture(bool packed) {
+        std::map<std::string, std::string> files;
+        files["app/main.js"] = "require('./views/view0');";
+        files["app/data/settings.json"] = "{}";
+        for (int i = 0; i < viewsCount; i++) {
+            files["app/views/view" + std::to_string(i) + ".js"] = "module.exports = {};";
+        }
+        for (int i = 0; i < packagesCount; i++) {
+            std::string package = "app/node_modules/package" + std::to_string(i);
+            files[package + "/package.json"] = "{ \"name\": \"package" + std::to_string(i) + "\", \"main\": \"lib/index\" }";
+            files[package + "/lib/index.js"] = "module.exports = require('./util');";
+            files[package + "/lib/util.js"] = "module.exports = {};";
+            files["app/node_modules/plain" + std::to_string(i) + "/index.js"] = "module.exports = {};";
+        }
+
+        if (packed) {
+            this->writeBundle(files);
+        } else {
+            for (const auto& file : files) {
+                this->_root.writeFile(file.first, file.second);
+            }
+        }
+    }
+
+    WTF::String applicationPath() const {
+        return WTF::String(this->_root.path());
+    }
+
+    // The module requests of a start up: relative requires inside the application and packages from node_modules
+    std::vector<WTF::String> requests() const {
+        std::vector<WTF::String> result;
+        result.push_back(this->path("app/main"));
+        result.push_back(this->path("app/data/settings"));
+        for (int i = 0; i < viewsCount; i++) {
+            result.push_back(this->path("app/views/view" + std::to_string(i)));
+        }
+        for (int i = 0; i < packagesCount; i++) {
+            result.push_back(this->path("app/node_modules/package" + std::to_string(i)));
+            result.push_back(this->path("app/node_modules/package" + std::to_string(i) + "/lib/./util"));
+            result.push_back(this->path("app/node_modules/plain" + std::to_string(i)));
+        }
+        return result;
+    }
+
+private:
+    WTF::String path(const std::string& relativePath) const {
+        return normalizePath(WTF::String(this->_root.path() + "/" + relativePath));
+    }
+
+    void writeBundle(const std::map<std::string, std::string>& files) {
+        // Paths in the bundle are relative to the application path, which is <root>/app, and sorted by their bytes
+        const std::string prefix = "app/";
+        std::vector<std::pair<std::string, std::string>> entries;
+        for (const auto& file : files) {
+            entries.emplace_back(file.first.substr(prefix.size()), file.second);
+        }
+
+        uint32_t dataOffset = 12 + entries.size() * 16;
+        std::string header = "TNSM";
+        std::string table;
+        std::string data;
+        auto putInteger = [](std::string& to, uint32_t value) {
+            to.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        putInteger(header, ModuleBundle::version);
+        putInteger(header, entries.size());
+        for (const auto& entry : entries) {
+            putInteger(table, dataOffset + data.size());
+            putInteger(table, entry.first.size());
+            data += entry.first;
+            putInteger(table, dataOffset + data.size());
+            putInteger(table, entry.second.size());
+            data += entry.second;
+        }
+
+        this->_root.writeFile("app/app.tnsmodules", header + table + data);
+    }
+
+    TemporaryDirectory _root;
+};
+
+static void resolve(benchmark::State& state, bool packed, bool warm) {
+    static ApplicationFixture looseApplication(false);
+    static ApplicationFixture packedApplication(true);
+    const ApplicationFixture& application = packed ? packedApplication : looseApplication;
+
+    const ModuleBundle* bundle = packed ? ModuleBundle::forApplicationPath(makeString(application.applicationPath(), "/app")) : nullptr;
+    if (packed && !bundle) {
+        state.SkipWithError("Could not map app.tnsmodules");
+        return;
+    }
+
+    std::vector<WTF::String> requests = application.requests();
+    PackageMainReader packageMainReader = readPackageMain;
+    if (packed) {
+        // Nothing is extracted from the bundle, package.json files are read through ModuleBundle::contents
+        packageMainReader = [bundle](const WTF::String& packageJsonPath, WTF::String& main) {
+            const char* data;
+            size_t length;
+            if (!bundle->contents(packageJsonPath, data, length)) {
+                return false;
+            }
+
+            return readPackageMainFromJson(std::string(data, length), main);
+        };
+    }
+
+    ModulePathCache cache;
+    for (auto _ : state) {
+        if (!warm) {
+            cache.clear();
+        }
+
+        for (const WTF::String& request : requests) {
+            WTF::String resolved;
+            if (!resolveAbsolutePath(bundle, request, cache, packageMainReader, resolved) || resolved.isNull()) {
+                state.SkipWithError("A module of the fixture could not be resolved");
+                return;
+            }
+            benchmark::DoNotOptimize(resolved);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * requests.size());
+}
+
+static void resolveLooseFilesCold(benchmark::State& state) {
+    resolve(state, /*packed*/ false, /*warm*/ false);
+}
+BENCHMARK(resolveLooseFilesCold);
+
+static void resolveLooseFilesWarm(benchmark::State& state) {
+    resolve(state, /*packed*/ false, /*warm*/ true);
+}
+BENCHMARK(resolveLooseFilesWarm);
+
+static void resolveBundleCold(benchmark::State& state) {
+    resolve(state, /*packed*/ true, /*warm*/ false);
+}
+BENCHMARK(resolveBundleCold);
+
+static void normalizeModulePath(benchmark::State& state) {
+    WTF::String path = "/var/containers/Bundle/Application/app/node_modules/package/lib/../lib/./util/../index.js";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(normalizePath(path));
+    }
+}
+BENCHMARK(normalizeModulePath);
+} // namespace Benchmarks
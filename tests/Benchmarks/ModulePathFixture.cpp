@@ -0,0 +1,55 @@
+//
+//  ModulePathFixture.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "ModulePathFixture.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Benchmarks {
+
+TemporaryDirectory::TemporaryDirectory() {
+    char directory[] = "/tmp/ns-module-paths-XXXXXX";
+    this->_path = mkdtemp(directory);
+}
+
+TemporaryDirectory::~TemporaryDirectory() {
+    std::filesystem::remove_all(this->_path);
+}
+
+void TemporaryDirectory::writeFile(const std::string& relativePath, const std::string& contents) const {
+    std::string path = this->_path + "/" + relativePath;
+    for (size_t separator = path.find('/', 1); separator != std::string::npos; separator = path.find('/', separator + 1)) {
+        mkdir(path.substr(0, separator).c_str(), 0755);
+    }
+    std::ofstream(path) << contents;
+}
+
+bool readPackageMainFromJson(const std::string& json, WTF::String& main) {
+    size_t key = json.find("\"main\"");
+    if (key == std::string::npos) {
+        return true;
+    }
+
+    size_t start = json.find('"', json.find(':', key)) + 1;
+    main = WTF::String(json.substr(start, json.find('"', start) - start));
+    return true;
+}
+
+bool readPackageMain(const WTF::String& packageJsonPath, WTF::String& main) {
+    std::ifstream file(packageJsonPath.utf8().data());
+    if (!file) {
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return readPackageMainFromJson(contents.str(), main);
+}
+} // namespace Benchmarks
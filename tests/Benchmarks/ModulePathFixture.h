@@ -0,0 +1,44 @@
+//
+//  ModulePathFixture.h
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __Benchmarks__ModulePathFixture__
+#define __Benchmarks__ModulePathFixture__
+
+#include "ModulePathResolver.h"
+#include <string>
+
+namespace Benchmarks {
+
+/// A directory under /tmp which is removed with everything in it when the fixture is destroyed.
+class TemporaryDirectory {
+public:
+    TemporaryDirectory();
+    ~TemporaryDirectory();
+
+    TemporaryDirectory(const TemporaryDirectory&) = delete;
+    TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+    const std::string& path() const {
+        return this->_path;
+    }
+
+    /// Writes a file at a path relative to the directory, creating the directories on the way.
+    void writeFile(const std::string& relativePath, const std::string& contents) const;
+
+private:
+    std::string _path;
+};
+
+/// Reads "main" the way a JSON parser would see it for the fixtures' simple package.json files:
+/// a single string value, no escapes.
+bool readPackageMainFromJson(const std::string& json, WTF::String& main);
+
+/// A NativeScript::PackageMainReader over the file system.
+bool readPackageMain(const WTF::String& packageJsonPath, WTF::String& main);
+} // namespace Benchmarks
+
+#endif /* defined(__Benchmarks__ModulePathFixture__) */
@@ -0,0 +1,181 @@
+//
+//  ModulePathResolverTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "ModulePathFixture.h"
+#include <gtest/gtest.h>
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+TEST(ModulePathNormalization, CollapsesDotAndDotDotComponents) {
+    EXPECT_EQ(WTF::String("/app/lib/util.js"), normalizePath("/app/views/../lib/./util.js"));
+    EXPECT_EQ(WTF::String("/app/lib"), normalizePath("/app//lib/"));
+    EXPECT_EQ(WTF::String("lib/util"), normalizePath("./lib/util"));
+}
+
+TEST(ModulePathNormalization, StopsAtTheRoot) {
+    EXPECT_EQ(WTF::String("/"), normalizePath("/app/../.."));
+    EXPECT_EQ(WTF::String("/lib"), normalizePath("/../lib"));
+}
+
+TEST(ModulePathNormalization, ParentPathOfTheRootIsTheRoot) {
+    EXPECT_EQ(WTF::String("/app"), parentPath("/app/main.js"));
+    EXPECT_EQ(WTF::String("/"), parentPath("/app"));
+    EXPECT_EQ(emptyString(), parentPath("main.js"));
+}
+
+/// An application in a temporary directory, which is also the application path:
+///
+///     app/main.js, app/lib/helper.js, app/lib/data.json, app/lib/both.js and both.json
+///     app/pkg (package.json with "main": "dist/entry"), app/pkg-without-main (package.json and index.js)
+///     app/plain/index.js, app/json-index/index.json
+///     app/views/deep/page.js, app/views/node_modules/shared/index.js
+///     app/node_modules/shared/index.js, app/node_modules/outer/index.js
+///     app/tns_modules/tns-core-modules/core/index.js, app/tns_modules/legacy.js
+///     node_modules/above-app/index.js
+class ModulePathResolverTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char* files[] = {
+            "app/main.js",
+            "app/lib/helper.js",
+            "app/lib/data.json",
+            "app/lib/both.js",
+            "app/lib/both.json",
+            "app/pkg/dist/entry.js",
+            "app/pkg/index.js",
+            "app/pkg-without-main/index.js",
+            "app/plain/index.js",
+            "app/json-index/index.json",
+            "app/views/deep/page.js",
+            "app/views/node_modules/shared/index.js",
+            "app/node_modules/shared/index.js",
+            "app/node_modules/outer/index.js",
+            "app/tns_modules/tns-core-modules/core/index.js",
+            "app/tns_modules/legacy.js",
+            "node_modules/above-app/index.js",
+        };
+        for (const char* file : files) {
+            this->_application.writeFile(file, "module.exports = {};");
+        }
+        this->_application.writeFile("app/pkg/package.json", "{ \"name\": \"pkg\", \"main\": \"dist/entry\" }");
+        this->_application.writeFile("app/pkg-without-main/package.json", "{ \"name\": \"pkg-without-main\" }");
+    }
+
+    WTF::String path(const std::string& relativePath) const {
+        return WTF::String(this->_application.path() + "/" + relativePath);
+    }
+
+    /// The path the specifier resolves to relative to the application, or a null string when there is no such module.
+    WTF::String resolve(const char* specifier, const char* referrer = nullptr) {
+        WTF::String resolved;
+        WTF::String computedPath;
+        bool succeeded = resolveModuleSpecifier(nullptr, WTF::String(this->_application.path()), specifier, referrer ? this->path(referrer) : WTF::String(), this->_cache, readPackageMain, resolved, computedPath);
+        EXPECT_TRUE(succeeded) << specifier;
+        if (resolved.isNull()) {
+            return resolved;
+        }
+
+        WTF::String prefix = this->path("");
+        EXPECT_TRUE(resolved.startsWith(prefix)) << resolved.utf8().data();
+        return resolved.substring(prefix.length());
+    }
+
+    TemporaryDirectory _application;
+    ModulePathCache _cache;
+};
+
+TEST_F(ModulePathResolverTest, RelativeSpecifiersAreResolvedFromTheReferrer) {
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve("./lib/helper", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve("../../lib/helper", "app/views/deep/page.js"));
+}
+
+TEST_F(ModulePathResolverTest, RelativeSpecifiersOfTheEntryPointAreResolvedFromTheApp) {
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve("./lib/helper"));
+}
+
+TEST_F(ModulePathResolverTest, TildeIsTheAppDirectory) {
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve("~/lib/helper", "app/views/deep/page.js"));
+}
+
+TEST_F(ModulePathResolverTest, AbsoluteSpecifiersAreNormalized) {
+    std::string specifier = this->_application.path() + "/app/views/../lib/./helper";
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve(specifier.c_str(), "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, ParentComponentsAreNormalized) {
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve("./../lib/./helper", "app/views/page.js"));
+    EXPECT_EQ(WTF::String("app/plain/index.js"), this->resolve("./views/deep/../../plain", "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, ExactFileNamesComeFirst) {
+    EXPECT_EQ(WTF::String("app/lib/helper.js"), this->resolve("./lib/helper.js", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/lib/both.json"), this->resolve("./lib/both.json", "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, JsExtensionIsProbedBeforeJson) {
+    EXPECT_EQ(WTF::String("app/lib/both.js"), this->resolve("./lib/both", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/lib/data.json"), this->resolve("./lib/data", "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, PackageJsonMainIsLoadedAsAFile) {
+    EXPECT_EQ(WTF::String("app/pkg/dist/entry.js"), this->resolve("./pkg", "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, DirectoriesWithoutMainLoadTheirIndex) {
+    EXPECT_EQ(WTF::String("app/pkg-without-main/index.js"), this->resolve("./pkg-without-main", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/plain/index.js"), this->resolve("./plain", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/json-index/index.json"), this->resolve("./json-index", "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, NodeModulesAreSearchedFromTheReferrerUp) {
+    EXPECT_EQ(WTF::String("app/views/node_modules/shared/index.js"), this->resolve("shared", "app/views/deep/page.js"));
+    EXPECT_EQ(WTF::String("app/node_modules/shared/index.js"), this->resolve("shared", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/node_modules/outer/index.js"), this->resolve("outer", "app/views/deep/page.js"));
+}
+
+TEST_F(ModulePathResolverTest, NodeModulesAboveTheApplicationAreNotSearched) {
+    EXPECT_TRUE(this->resolve("above-app", "app/views/deep/page.js").isNull());
+}
+
+TEST_F(ModulePathResolverTest, CoreModulesComeBeforeNodeModulesAndTnsModulesAfter) {
+    EXPECT_EQ(WTF::String("app/tns_modules/tns-core-modules/core/index.js"), this->resolve("core", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/tns_modules/legacy.js"), this->resolve("legacy", "app/main.js"));
+    EXPECT_EQ(WTF::String("app/tns_modules/legacy.js"), this->resolve("legacy"));
+}
+
+TEST_F(ModulePathResolverTest, MissingModulesReportTheLastPathTried) {
+    WTF::String resolved;
+    WTF::String computedPath;
+    EXPECT_TRUE(resolveModuleSpecifier(nullptr, WTF::String(this->_application.path()), "./missing", this->path("app/main.js"), this->_cache, readPackageMain, resolved, computedPath));
+    EXPECT_TRUE(resolved.isNull());
+    EXPECT_EQ(this->path("app/missing"), computedPath);
+
+    EXPECT_TRUE(resolveModuleSpecifier(nullptr, WTF::String(this->_application.path()), "missing", this->path("app/main.js"), this->_cache, readPackageMain, resolved, computedPath));
+    EXPECT_TRUE(resolved.isNull());
+    EXPECT_EQ(this->path("app/tns_modules/missing"), computedPath);
+}
+
+TEST_F(ModulePathResolverTest, UnreadablePackageJsonFailsTheLookupWithoutCachingIt) {
+    PackageMainReader failingReader = [](const WTF::String&, WTF::String&) { return false; };
+    WTF::String resolved;
+    WTF::String computedPath;
+    EXPECT_FALSE(resolveModuleSpecifier(nullptr, WTF::String(this->_application.path()), "./pkg", this->path("app/main.js"), this->_cache, failingReader, resolved, computedPath));
+
+    EXPECT_EQ(WTF::String("app/pkg/dist/entry.js"), this->resolve("./pkg", "app/main.js"));
+}
+
+TEST_F(ModulePathResolverTest, ResolvedPathsAreCached) {
+    EXPECT_EQ(WTF::String("app/pkg/dist/entry.js"), this->resolve("./pkg", "app/main.js"));
+
+    PackageMainReader failingReader = [](const WTF::String&, WTF::String&) { return false; };
+    WTF::String resolved;
+    WTF::String computedPath;
+    EXPECT_TRUE(resolveModuleSpecifier(nullptr, WTF::String(this->_application.path()), "./pkg", this->path("app/main.js"), this->_cache, failingReader, resolved, computedPath));
+    EXPECT_EQ(this->path("app/pkg/dist/entry.js"), resolved);
+}
+} // namespace Benchmarks
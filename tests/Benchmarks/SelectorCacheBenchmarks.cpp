@@ -0,0 +1,67 @@
+//
+//  SelectorCacheBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "SelectorCache.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Benchmarks {
+using namespace Metadata;
+
+static const int methodsCount = 1024;
+
+// Only the addresses of methods are used as keys
+static const MethodMeta* method(uintptr_t index) {
+    return reinterpret_cast<const MethodMeta*>(0x100000 + index * 4);
+}
+
+static const std::vector<std::string>& selectorNames() {
+    static std::vector<std::string> names = [] {
+        std::vector<std::string> names;
+        for (int i = 0; i < methodsCount; i++) {
+            names.push_back("method" + std::to_string(i) + "WithObject:");
+        }
+        return names;
+    }();
+    return names;
+}
+
+// The way sel_registerName interns selector names under the runtime's selector lock
+static const char* registerName(const std::string& name) {
+    static std::mutex lock;
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> guard(lock);
+    return names.insert(name).first->c_str();
+}
+
+// MethodMeta::selector() before the cache, every call takes the lock
+static void registerSelector(benchmark::State& state) {
+    const std::vector<std::string>& names = selectorNames();
+    int i = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registerName(names[i++ % methodsCount]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(registerSelector)->Threads(1)->Threads(4)->Threads(8);
+
+static void cachedSelector(benchmark::State& state) {
+    static SelectorCache<const char*>* cache = new SelectorCache<const char*>([]() -> size_t { return methodsCount; });
+    const std::vector<std::string>& names = selectorNames();
+    int i = state.thread_index();
+    for (auto _ : state) {
+        int index = i++ % methodsCount;
+        benchmark::DoNotOptimize(cache->selector(method(index), [&] { return registerName(names[index]); }));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(cachedSelector)->Threads(1)->Threads(4)->Threads(8);
+} // namespace Benchmarks
@@ -0,0 +1,161 @@
+//
+//  SelectorCacheTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "MetadataFixture.h"
+#include "SelectorCache.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Benchmarks {
+using namespace Metadata;
+
+typedef SelectorCache<const char*> TestSelectorCache;
+
+static const int methodsCount = 1024;
+
+static size_t countMethods() {
+    return methodsCount;
+}
+
+// Only the addresses of methods are used as keys, they are at least 4 bytes apart like real ones
+static const MethodMeta* method(uintptr_t index) {
+    return reinterpret_cast<const MethodMeta*>(0x100000 + index * 4);
+}
+
+static const char* selectorName(int index) {
+    static std::vector<std::string> names = [] {
+        std::vector<std::string> names;
+        for (int i = 0; i < methodsCount; i++) {
+            names.push_back("method" + std::to_string(i) + ":");
+        }
+        return names;
+    }();
+    return names[index].c_str();
+}
+
+class SelectorCacheStress : public ::testing::TestWithParam<int> {
+};
+
+// Every thread looks up every method, starting at a different one, while the others insert
+TEST_P(SelectorCacheStress, ThreadsGetTheRegisteredSelector) {
+    int threadsCount = GetParam();
+    auto cache = std::make_unique<TestSelectorCache>(countMethods);
+    std::vector<std::vector<const char*>> results(threadsCount, std::vector<const char*>(methodsCount));
+
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < threadsCount; thread++) {
+        threads.emplace_back([&, thread] {
+            while (!start) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < methodsCount; i++) {
+                int index = (i + thread * 7) % methodsCount;
+                results[thread][index] = cache->selector(method(index), [&] { return selectorName(index); });
+            }
+        });
+    }
+    start = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < methodsCount; i++) {
+        for (int thread = 0; thread < threadsCount; thread++) {
+            EXPECT_EQ(selectorName(i), results[thread][i]);
+        }
+        EXPECT_EQ(selectorName(i), cache->selector(method(i), [&]() -> const char* { ADD_FAILURE(); return nullptr; }));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, SelectorCacheStress, ::testing::Values(1, 4, 8));
+
+TEST(SelectorCache, SelectorsPastTheProbeSequenceAreRegisteredEveryTime) {
+    auto cache = std::make_unique<TestSelectorCache>(countMethods);
+
+    // Methods this far apart hash to the same slot
+    size_t capacity = cache->capacity();
+    auto collidingMethod = [capacity](uintptr_t index) {
+        return method(index * capacity);
+    };
+
+    for (size_t i = 0; i < TestSelectorCache::maxProbes; i++) {
+        cache->selector(collidingMethod(i), [&] { return selectorName(i); });
+    }
+
+    int registrations = 0;
+    auto registerSelector = [&] {
+        registrations++;
+        return selectorName(TestSelectorCache::maxProbes);
+    };
+    EXPECT_EQ(selectorName(TestSelectorCache::maxProbes), cache->selector(collidingMethod(TestSelectorCache::maxProbes), registerSelector));
+    EXPECT_EQ(selectorName(TestSelectorCache::maxProbes), cache->selector(collidingMethod(TestSelectorCache::maxProbes), registerSelector));
+    EXPECT_EQ(2, registrations);
+
+    for (size_t i = 0; i < TestSelectorCache::maxProbes; i++) {
+        EXPECT_EQ(selectorName(i), cache->selector(collidingMethod(i), [&]() -> const char* { ADD_FAILURE(); return nullptr; }));
+    }
+}
+
+TEST(SelectorCache, IsSizedForTheMethodsOnFirstUse) {
+    static int countCalls;
+    countCalls = 0;
+    TestSelectorCache cache([]() -> size_t {
+        countCalls++;
+        return 3000;
+    });
+    EXPECT_EQ(0, countCalls);
+
+    for (int i = 0; i < methodsCount; i++) {
+        cache.selector(method(i), [&] { return selectorName(i); });
+    }
+    EXPECT_EQ(8192u, cache.capacity());
+    EXPECT_EQ(1, countCalls);
+}
+
+TEST(SelectorCache, CapacityIsAPowerOfTwoAtLeastTwiceTheMethods) {
+    EXPECT_EQ(TestSelectorCache::minCapacity, TestSelectorCache::capacityForMethods(0));
+    EXPECT_EQ(2048u, TestSelectorCache::capacityForMethods(1024));
+    EXPECT_EQ(4096u, TestSelectorCache::capacityForMethods(1025));
+}
+
+TEST(SelectorCache, EveryMethodOfTheMetadataGetsASlot) {
+    const MetaFile* metaFile = metadataFixture();
+    size_t count = metaFile->methodsCount();
+    EXPECT_GT(count, 0u);
+
+    // Every method of every class and protocol, the way MethodMeta::selector() looks them up
+    TestSelectorCache cache([] { return metadataFixture()->methodsCount(); });
+    std::vector<const MethodMeta*> methods;
+    for (const Meta* meta : *metaFile->globalTable()) {
+        if (meta->type() == MetaType::Interface || meta->type() == MetaType::ProtocolType) {
+            const BaseClassMeta* classMeta = static_cast<const BaseClassMeta*>(meta);
+            for (ArrayOfPtrTo<MethodMeta>::iterator it = classMeta->instanceMethods->begin(); it != classMeta->instanceMethods->end(); ++it) {
+                methods.push_back((*it).valuePtr());
+            }
+            for (ArrayOfPtrTo<PropertyMeta>::iterator it = classMeta->instanceProps->begin(); it != classMeta->instanceProps->end(); ++it) {
+                if (const MethodMeta* getter = (*it)->getter()) {
+                    methods.push_back(getter);
+                }
+            }
+        }
+    }
+    EXPECT_LE(methods.size(), count);
+
+    for (const MethodMeta* method : methods) {
+        cache.selector(method, [method] { return method->jsName(); });
+    }
+
+    size_t registrations = 0;
+    for (const MethodMeta* method : methods) {
+        EXPECT_EQ(method->jsName(), cache.selector(method, [&, method] { registrations++; return method->jsName(); }));
+    }
+    EXPECT_EQ(0u, registrations);
+}
+} // namespace Benchmarks
@@ -0,0 +1,24 @@
+// Stands in for <JavaScriptCore/ContentSearchUtilities.h>, which is only used for lineEndings
+#include "WTFShims.h"
+
+namespace Inspector {
+namespace ContentSearchUtilities {
+
+// The positions of all line feeds followed by the length of the text
+inline Vector<size_t> lineEndings(const String& text) {
+    Vector<size_t> result;
+    size_t start = 0;
+    while (start < text.length()) {
+        size_t lineEnd = text.find('\n', start);
+        if (lineEnd == notFound) {
+            break;
+        }
+
+        result.append(lineEnd);
+        start = lineEnd + 1;
+    }
+    result.append(text.length());
+    return result;
+}
+} // namespace ContentSearchUtilities
+} // namespace Inspector
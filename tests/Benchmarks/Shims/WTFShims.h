@@ -0,0 +1,711 @@
+//
+//  WTFShims.h
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#ifndef __Benchmarks__WTFShims__
+#define __Benchmarks__WTFShims__
+
+// The subset of WTF used by the runtime sources which are built for the benchmarks, on top of the standard library.
+// Strings are 8-bit only and share their characters on copy like WTF::String does. Hashing matches WTF::StringHasher,
+// which the metadata generator relies on to place entries in the global table.
+
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#define ASSERT(assertion) assert(assertion)
+#define ASSERT_NOT_REACHED() assert(false)
+#define ASSERT_WITH_MESSAGE(assertion, ...) assert(assertion)
+#define RELEASE_ASSERT(assertion) \
+    do {                          \
+        if (!(assertion)) {       \
+            abort();              \
+        }                         \
+    } while (0)
+#define WTFMove(value) std::move(value)
+
+typedef unsigned char LChar;
+typedef char16_t UChar;
+
+namespace WTF {
+
+static const size_t notFound = std::numeric_limits<size_t>::max();
+
+inline void dataLogF(const char* format, ...) {
+    va_list arguments;
+    va_start(arguments, format);
+    vfprintf(stderr, format, arguments);
+    va_end(arguments);
+}
+
+class Lock {
+public:
+    void lock() {
+        this->_mutex.lock();
+    }
+
+    void unlock() {
+        this->_mutex.unlock();
+    }
+
+private:
+    std::mutex _mutex;
+};
+
+typedef std::lock_guard<Lock> LockHolder;
+
+template <typename T>
+class NeverDestroyed {
+public:
+    template <typename... Arguments>
+    NeverDestroyed(Arguments&&... arguments) {
+        new (this->_storage) T(std::forward<Arguments>(arguments)...);
+    }
+
+    T& get() {
+        return *reinterpret_cast<T*>(this->_storage);
+    }
+
+    operator T&() {
+        return this->get();
+    }
+
+private:
+    alignas(T) unsigned char _storage[sizeof(T)];
+};
+
+class StringHasher {
+public:
+    static const unsigned flagCount = 8;
+
+    template <typename T>
+    static unsigned computeHashAndMaskTop8Bits(const T* data, unsigned length) {
+        StringHasher hasher;
+        for (; length >= 2; length -= 2, data += 2) {
+            hasher.addCharactersAssumingAligned(data[0], data[1]);
+        }
+        if (length) {
+            hasher.addCharacter(data[0]);
+        }
+        return hasher.hashWithTop8BitsMasked();
+    }
+
+    template <typename T>
+    static unsigned computeHashAndMaskTop8Bits(const T* data) {
+        StringHasher hasher;
+        while (T first = *data++) {
+            T second = *data++;
+            if (!second) {
+                hasher.addCharacter(first);
+                break;
+            }
+            hasher.addCharactersAssumingAligned(first, second);
+        }
+        return hasher.hashWithTop8BitsMasked();
+    }
+
+private:
+    void addCharactersAssumingAligned(UChar first, UChar second) {
+        this->_hash += first;
+        this->_hash = (this->_hash << 16) ^ ((second << 11) ^ this->_hash);
+        this->_hash += this->_hash >> 11;
+    }
+
+    void addCharacter(UChar character) {
+        this->_pendingCharacter = character;
+        this->_hasPendingCharacter = true;
+    }
+
+    unsigned hashWithTop8BitsMasked() const {
+        unsigned result = this->_hash;
+        if (this->_hasPendingCharacter) {
+            result += this->_pendingCharacter;
+            result ^= result << 11;
+            result += result >> 17;
+        }
+
+        result ^= result << 3;
+        result += result >> 5;
+        result ^= result << 2;
+        result += result >> 15;
+        result ^= result << 10;
+
+        result &= (1U << (sizeof(result) * 8 - flagCount)) - 1;
+        return result ? result : 0x80000000 >> flagCount;
+    }
+
+    unsigned _hash = 0x9E3779B9U;
+    UChar _pendingCharacter = 0;
+    bool _hasPendingCharacter = false;
+};
+
+template <typename T, size_t inlineCapacity = 0>
+class Vector : public std::vector<T> {
+public:
+    using std::vector<T>::vector;
+
+    bool isEmpty() const {
+        return this->empty();
+    }
+
+    template <typename U>
+    void append(U&& value) {
+        this->push_back(std::forward<U>(value));
+    }
+
+    template <typename U>
+    void uncheckedAppend(U&& value) {
+        this->push_back(std::forward<U>(value));
+    }
+
+    template <typename U>
+    void insert(size_t position, U&& value) {
+        std::vector<T>::insert(this->begin() + position, std::forward<U>(value));
+    }
+
+    void reserveInitialCapacity(size_t capacity) {
+        this->reserve(capacity);
+    }
+
+    void reserveCapacity(size_t capacity) {
+        this->reserve(capacity);
+    }
+
+    void removeLast() {
+        this->pop_back();
+    }
+
+    void fill(const T& value, size_t size) {
+        this->assign(size, value);
+    }
+
+    T& at(size_t index) {
+        return (*this)[index];
+    }
+
+    const T& at(size_t index) const {
+        return (*this)[index];
+    }
+};
+
+template <typename T>
+class HashSet : public std::unordered_set<T> {
+public:
+    void add(const T& value) {
+        this->insert(value);
+    }
+
+    template <typename Iterator>
+    void add(Iterator begin, Iterator end) {
+        this->insert(begin, end);
+    }
+
+    bool contains(const T& value) const {
+        return this->find(value) != this->end();
+    }
+
+    bool isEmpty() const {
+        return this->empty();
+    }
+
+    template <typename Predicate>
+    void removeIf(const Predicate& predicate) {
+        for (auto it = this->begin(); it != this->end();) {
+            it = predicate(*it) ? this->erase(it) : std::next(it);
+        }
+    }
+};
+
+class CString {
+public:
+    CString() = default;
+
+    CString(const char* characters, size_t length)
+        : _characters(characters, length) {
+    }
+
+    const char* data() const {
+        return this->_characters.c_str();
+    }
+
+    size_t length() const {
+        return this->_characters.length();
+    }
+
+private:
+    std::string _characters;
+};
+
+class StringImpl {
+public:
+    explicit StringImpl(std::string characters)
+        : _characters(std::move(characters)) {
+    }
+
+    unsigned length() const {
+        return static_cast<unsigned>(this->_characters.length());
+    }
+
+    const LChar* characters8() const {
+        return reinterpret_cast<const LChar*>(this->_characters.data());
+    }
+
+    CString utf8() const {
+        return CString(this->_characters.data(), this->_characters.length());
+    }
+
+    unsigned hash() const {
+        if (!this->_hash) {
+            this->_hash = StringHasher::computeHashAndMaskTop8Bits(this->characters8(), this->length());
+        }
+        return this->_hash;
+    }
+
+    const std::string& characters() const {
+        return this->_characters;
+    }
+
+private:
+    std::string _characters;
+    mutable unsigned _hash = 0;
+};
+
+struct ASCIILiteral {
+    const char* characters;
+};
+
+class StringView;
+
+class String {
+public:
+    String() = default;
+
+    String(const char* characters)
+        : _impl(characters ? std::make_shared<StringImpl>(characters) : nullptr) {
+    }
+
+    String(ASCIILiteral literal)
+        : String(literal.characters) {
+    }
+
+    String(const LChar* characters, unsigned length)
+        : _impl(std::make_shared<StringImpl>(std::string(reinterpret_cast<const char*>(characters), length))) {
+    }
+
+    explicit String(std::string characters)
+        : _impl(std::make_shared<StringImpl>(std::move(characters))) {
+    }
+
+    bool isNull() const {
+        return !this->_impl;
+    }
+
+    bool isEmpty() const {
+        return !this->length();
+    }
+
+    unsigned length() const {
+        return this->_impl ? this->_impl->length() : 0;
+    }
+
+    bool is8Bit() const {
+        return true;
+    }
+
+    const LChar* characters8() const {
+        return this->_impl ? this->_impl->characters8() : nullptr;
+    }
+
+    StringImpl* impl() const {
+        return this->_impl.get();
+    }
+
+    UChar operator[](unsigned index) const {
+        return this->characters8()[index];
+    }
+
+    CString utf8() const {
+        return this->_impl ? this->_impl->utf8() : CString("", 0);
+    }
+
+    size_t find(UChar character, unsigned start = 0) const {
+        return this->_impl ? this->_impl->characters().find(static_cast<char>(character), start) : notFound;
+    }
+
+    size_t reverseFind(UChar character) const {
+        return this->_impl ? this->_impl->characters().rfind(static_cast<char>(character)) : notFound;
+    }
+
+    bool startsWith(const String& prefix) const {
+        return prefix.length() <= this->length() && !memcmp(this->characters8(), prefix.characters8(), prefix.length());
+    }
+
+    String substring(unsigned start, unsigned length = std::numeric_limits<unsigned>::max()) const {
+        start = std::min(start, this->length());
+        return String(this->characters8() + start, std::min(length, this->length() - start));
+    }
+
+    String left(unsigned length) const {
+        return this->substring(0, length);
+    }
+
+    friend bool operator==(const String& a, const String& b) {
+        return a.isNull() == b.isNull() && a.length() == b.length() && !memcmp(a.characters8(), b.characters8(), a.length());
+    }
+
+    friend bool operator!=(const String& a, const String& b) {
+        return !(a == b);
+    }
+
+private:
+    std::shared_ptr<StringImpl> _impl;
+};
+
+// Lets GoogleTest print strings in failed expectations
+inline void PrintTo(const String& string, std::ostream* stream) {
+    *stream << (string.isNull() ? "(null)" : "\"" + std::string(reinterpret_cast<const char*>(string.characters8()), string.length()) + "\"");
+}
+
+inline const String& emptyString() {
+    static const String empty("");
+    return empty;
+}
+
+class StringView {
+public:
+    class SplitResult;
+
+    StringView() = default;
+
+    StringView(const LChar* characters, unsigned length)
+        : _characters(characters)
+        , _length(length) {
+    }
+
+    StringView(const String& string)
+        : StringView(string.characters8(), string.length()) {
+    }
+
+    StringView(const char* characters)
+        : StringView(reinterpret_cast<const LChar*>(characters), strlen(characters)) {
+    }
+
+    unsigned length() const {
+        return this->_length;
+    }
+
+    bool isEmpty() const {
+        return !this->_length;
+    }
+
+    bool is8Bit() const {
+        return true;
+    }
+
+    const LChar* characters8() const {
+        return this->_characters;
+    }
+
+    const UChar* characters16() const {
+        return nullptr;
+    }
+
+    UChar operator[](unsigned index) const {
+        return this->_characters[index];
+    }
+
+    bool startsWith(UChar character) const {
+        return this->_length && this->_characters[0] == character;
+    }
+
+    StringView substring(unsigned start, unsigned length = std::numeric_limits<unsigned>::max()) const {
+        start = std::min(start, this->_length);
+        return StringView(this->_characters + start, std::min(length, this->_length - start));
+    }
+
+    String toString() const {
+        return String(this->_characters, this->_length);
+    }
+
+    // Empty components are skipped
+    SplitResult split(UChar separator) const;
+
+    friend bool operator==(StringView a, StringView b) {
+        return a._length == b._length && !memcmp(a._characters, b._characters, a._length);
+    }
+
+    friend bool operator!=(StringView a, StringView b) {
+        return !(a == b);
+    }
+
+private:
+    const LChar* _characters = nullptr;
+    unsigned _length = 0;
+};
+
+class StringView::SplitResult {
+public:
+    class Iterator {
+    public:
+        Iterator(StringView string, UChar separator, unsigned position)
+            : _string(string)
+            , _separator(separator)
+            , _position(position) {
+            this->findComponent();
+        }
+
+        StringView operator*() const {
+            return this->_string.substring(this->_position, this->_end - this->_position);
+        }
+
+        Iterator& operator++() {
+            this->_position = this->_end;
+            this->findComponent();
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return this->_position != other._position;
+        }
+
+    private:
+        void findComponent() {
+            while (this->_position < this->_string.length() && this->_string[this->_position] == this->_separator) {
+                this->_position++;
+            }
+            this->_end = this->_position;
+            while (this->_end < this->_string.length() && this->_string[this->_end] != this->_separator) {
+                this->_end++;
+            }
+        }
+
+        StringView _string;
+        UChar _separator;
+        unsigned _position;
+        unsigned _end;
+    };
+
+    SplitResult(StringView string, UChar separator)
+        : _string(string)
+        , _separator(separator) {
+    }
+
+    Iterator begin() const {
+        return Iterator(this->_string, this->_separator, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this->_string, this->_separator, this->_string.length());
+    }
+
+private:
+    StringView _string;
+    UChar _separator;
+};
+
+inline StringView::SplitResult StringView::split(UChar separator) const {
+    return SplitResult(*this, separator);
+}
+
+class StringBuilder {
+public:
+    void append(StringView string) {
+        this->_characters.append(reinterpret_cast<const char*>(string.characters8()), string.length());
+    }
+
+    void append(const String& string) {
+        this->append(StringView(string));
+    }
+
+    void append(const char* characters) {
+        this->_characters.append(characters);
+    }
+
+    void append(char character) {
+        this->_characters.push_back(character);
+    }
+
+    void append(UChar character) {
+        this->_characters.push_back(static_cast<char>(character));
+    }
+
+    void reserveCapacity(unsigned capacity) {
+        this->_characters.reserve(capacity);
+    }
+
+    unsigned length() const {
+        return static_cast<unsigned>(this->_characters.length());
+    }
+
+    bool isEmpty() const {
+        return this->_characters.empty();
+    }
+
+    String toString() const {
+        return String(this->_characters);
+    }
+
+private:
+    std::string _characters;
+};
+
+template <typename... Strings>
+String makeString(const Strings&... strings) {
+    StringBuilder builder;
+    (builder.append(strings), ...);
+    return builder.toString();
+}
+
+struct StringHash {
+    static unsigned hash(const String& string) {
+        return string.isNull() ? 0 : string.impl()->hash();
+    }
+
+    static bool equal(const String& a, const String& b) {
+        return a == b;
+    }
+};
+
+struct ASCIICaseInsensitiveHash {
+    static unsigned hash(const String& string) {
+        std::string folded(reinterpret_cast<const char*>(string.characters8()), string.length());
+        std::transform(folded.begin(), folded.end(), folded.begin(), [](unsigned char character) { return tolower(character); });
+        return StringHasher::computeHashAndMaskTop8Bits(reinterpret_cast<const LChar*>(folded.data()), folded.length());
+    }
+
+    static bool equal(const String& a, const String& b) {
+        return a.length() == b.length() && !strncasecmp(reinterpret_cast<const char*>(a.characters8()), reinterpret_cast<const char*>(b.characters8()), a.length());
+    }
+};
+
+template <typename T>
+struct DefaultHash {
+    static unsigned hash(const T& value) {
+        return std::hash<T>()(value);
+    }
+
+    static bool equal(const T& a, const T& b) {
+        return a == b;
+    }
+};
+
+template <>
+struct DefaultHash<String> : StringHash {
+};
+
+template <typename Key, typename Value>
+struct KeyValuePair {
+    Key key;
+    mutable Value value;
+};
+
+// Entries are looked up by key only, so the value can be changed in place like with WTF::HashMap
+template <typename Key, typename Value, typename Hash = DefaultHash<Key>>
+class HashMap {
+    typedef KeyValuePair<Key, Value> Entry;
+
+    struct EntryHash {
+        using is_transparent = void;
+
+        size_t operator()(const Entry& entry) const {
+            return Hash::hash(entry.key);
+        }
+
+        size_t operator()(const Key& key) const {
+            return Hash::hash(key);
+        }
+    };
+
+    struct EntryEqual {
+        using is_transparent = void;
+
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) const {
+            return Hash::equal(keyOf(a), keyOf(b));
+        }
+
+        static const Key& keyOf(const Entry& entry) {
+            return entry.key;
+        }
+
+        static const Key& keyOf(const Key& key) {
+            return key;
+        }
+    };
+
+    typedef std::unordered_set<Entry, EntryHash, EntryEqual> Table;
+
+public:
+    typedef typename Table::const_iterator iterator;
+
+    iterator find(const Key& key) const {
+        return this->_table.find(key);
+    }
+
+    iterator end() const {
+        return this->_table.end();
+    }
+
+    bool contains(const Key& key) const {
+        return this->find(key) != this->end();
+    }
+
+    void set(const Key& key, const Value& value) {
+        auto it = this->_table.find(key);
+        if (it != this->_table.end()) {
+            it->value = value;
+        } else {
+            this->_table.insert(Entry{ key, value });
+        }
+    }
+
+    void clear() {
+        this->_table.clear();
+    }
+
+    size_t size() const {
+        return this->_table.size();
+    }
+
+private:
+    Table _table;
+};
+} // namespace WTF
+
+inline WTF::ASCIILiteral operator"" _s(const char* characters, size_t) {
+    return WTF::ASCIILiteral{ characters };
+}
+
+using WTF::ASCIICaseInsensitiveHash;
+using WTF::ASCIILiteral;
+using WTF::CString;
+using WTF::emptyString;
+using WTF::HashMap;
+using WTF::HashSet;
+using WTF::makeString;
+using WTF::notFound;
+using WTF::String;
+using WTF::StringBuilder;
+using WTF::StringImpl;
+using WTF::StringView;
+using WTF::Vector;
+
+#endif /* defined(__Benchmarks__WTFShims__) */
@@ -0,0 +1,7 @@
+// Stands in for <malloc/malloc.h> of Darwin, which is only used for malloc_good_size
+#include <cstddef>
+
+// Darwin's tiny allocator hands out 16 byte quanta
+inline size_t malloc_good_size(size_t size) {
+    return (size + 15) & ~static_cast<size_t>(15);
+}
@@ -0,0 +1,2 @@
+// Stands in for <wtf/HashMap.h> of WTF, see WTFShims.h
+#include "WTFShims.h"
@@ -0,0 +1,2 @@
+// Stands in for <wtf/NeverDestroyed.h> of WTF, see WTFShims.h
+#include "WTFShims.h"
@@ -0,0 +1,2 @@
+// Stands in for <wtf/text/StringHasher.h> of WTF, see WTFShims.h
+#include "WTFShims.h"
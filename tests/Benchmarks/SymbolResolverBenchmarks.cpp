@@ -0,0 +1,67 @@
+//
+//  SymbolResolverBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "SymbolResolverCache.h"
+#include <benchmark/benchmark.h>
+#include <dlfcn.h>
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+static const int modulesCount = 256;
+
+// Only the addresses of modules are used as keys
+static const Metadata::ModuleMeta* module(int index) {
+    static char modules[modulesCount];
+    return reinterpret_cast<const Metadata::ModuleMeta*>(&modules[index]);
+}
+
+// The way DlSymbolResolver keeps a library open
+struct LibraryResolver {
+    LibraryResolver()
+        : handle(dlopen(nullptr, RTLD_LAZY | RTLD_LOCAL)) {
+    }
+
+    ~LibraryResolver() {
+        dlclose(this->handle);
+    }
+
+    void* handle;
+};
+
+static SymbolResolverCache<LibraryResolver>& sharedCache() {
+    static SymbolResolverCache<LibraryResolver>* cache = new SymbolResolverCache<LibraryResolver>();
+    return *cache;
+}
+
+// Symbol lookups from the main and worker runtimes once their modules have been resolved
+static void resolveCachedModule(benchmark::State& state) {
+    SymbolResolverCache<LibraryResolver>& cache = sharedCache();
+    for (int i = 0; i < modulesCount; i++) {
+        cache.resolve(module(i), [] { return std::make_unique<LibraryResolver>(); });
+    }
+
+    int i = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.resolve(module(i++ % modulesCount), [] { return std::make_unique<LibraryResolver>(); }));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(resolveCachedModule)->Threads(1)->Threads(4)->Threads(8);
+
+// Resolving every module of an application for the first time
+static void resolveModules(benchmark::State& state) {
+    for (auto _ : state) {
+        SymbolResolverCache<LibraryResolver> cache;
+        for (int i = 0; i < modulesCount; i++) {
+            benchmark::DoNotOptimize(cache.resolve(module(i), [] { return std::make_unique<LibraryResolver>(); }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * modulesCount);
+}
+BENCHMARK(resolveModules);
+} // namespace Benchmarks
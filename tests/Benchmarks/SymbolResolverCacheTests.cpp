@@ -0,0 +1,92 @@
+//
+//  SymbolResolverCacheTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "SymbolResolverCache.h"
+#include <dlfcn.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+static const int modulesCount = 512;
+
+static const Metadata::ModuleMeta* module(int index) {
+    static char modules[modulesCount];
+    return reinterpret_cast<const Metadata::ModuleMeta*>(&modules[index]);
+}
+
+struct LibraryResolver {
+    LibraryResolver(std::atomic<int>& liveCount)
+        : handle(dlopen(nullptr, RTLD_LAZY | RTLD_LOCAL))
+        , liveCount(liveCount) {
+        this->liveCount++;
+    }
+
+    ~LibraryResolver() {
+        dlclose(this->handle);
+        this->liveCount--;
+    }
+
+    void* handle;
+    std::atomic<int>& liveCount;
+};
+
+class SymbolResolverCacheStress : public ::testing::TestWithParam<int> {
+};
+
+// Every thread resolves every module, starting at a different one, while the others insert
+TEST_P(SymbolResolverCacheStress, ThreadsAgreeOnOneResolverPerModule) {
+    int threadsCount = GetParam();
+    std::atomic<int> liveCount(0);
+    std::vector<std::vector<LibraryResolver*>> results(threadsCount, std::vector<LibraryResolver*>(modulesCount));
+
+    {
+        SymbolResolverCache<LibraryResolver> cache;
+        std::atomic<bool> start(false);
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < threadsCount; thread++) {
+            threads.emplace_back([&, thread] {
+                while (!start) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < modulesCount; i++) {
+                    int index = (i + thread * 7) % modulesCount;
+                    results[thread][index] = cache.resolve(module(index), [&] { return std::make_unique<LibraryResolver>(liveCount); });
+                }
+            });
+        }
+        start = true;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Resolvers which lost a race have been destroyed, one per module is left
+        EXPECT_EQ(modulesCount, liveCount);
+        for (int i = 0; i < modulesCount; i++) {
+            ASSERT_NE(nullptr, results[0][i]);
+            for (int thread = 1; thread < threadsCount; thread++) {
+                EXPECT_EQ(results[0][i], results[thread][i]);
+            }
+            EXPECT_EQ(results[0][i], cache.resolve(module(i), [&]() -> std::unique_ptr<LibraryResolver> { ADD_FAILURE(); return nullptr; }));
+        }
+    }
+
+    EXPECT_EQ(0, liveCount);
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, SymbolResolverCacheStress, ::testing::Values(1, 4, 8));
+
+TEST(SymbolResolverCache, ModulesWithoutResolverAreCached) {
+    SymbolResolverCache<int> cache;
+    int creations = 0;
+    auto create = [&]() -> std::unique_ptr<int> { creations++; return nullptr; };
+    EXPECT_EQ(nullptr, cache.resolve(module(0), create));
+    EXPECT_EQ(nullptr, cache.resolve(module(0), create));
+    EXPECT_EQ(1, creations);
+}
+} // namespace Benchmarks
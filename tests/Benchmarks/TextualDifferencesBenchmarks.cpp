@@ -0,0 +1,57 @@
+//
+//  TextualDifferencesBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "TextualDifferencesHelper.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+// Diffs of a generated module of a few thousand lines against an edited copy, as LiveEdit does on every
+// save: the range argument is the number of lines changed.
+namespace Benchmarks {
+using namespace NativeScript;
+
+static const int linesCount = 4000;
+
+static std::string sourceLine(int index, int revision) {
+    return "    exports.function" + std::to_string(index) + " = function (value) { return value + " + std::to_string(index * 31 + revision) + "; };\n";
+}
+
+static WTF::String source(const std::vector<int>& revisions) {
+    std::string result = "'use strict';\n";
+    for (int i = 0; i < linesCount; i++) {
+        result += sourceLine(i, revisions[i]);
+    }
+    return WTF::String(result);
+}
+
+static void compareStrings(benchmark::State& state, TextualDifferencesHelper::Algorithm algorithm) {
+    std::vector<int> revisions(linesCount, 0);
+    WTF::String original = source(revisions);
+
+    std::mt19937 random(0);
+    for (int64_t i = 0; i < state.range(0); i++) {
+        revisions[random() % linesCount]++;
+    }
+    WTF::String edited = source(revisions);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TextualDifferencesHelper::CompareStrings(original, edited, algorithm));
+    }
+    state.SetBytesProcessed(state.iterations() * (original.length() + edited.length()));
+}
+
+static void compareStrings(benchmark::State& state) {
+    compareStrings(state, TextualDifferencesHelper::Algorithm::Automatic);
+}
+BENCHMARK(compareStrings)->Arg(0)->Arg(1)->Arg(16)->Arg(256);
+
+// What the module above costs when its table of subproblems would not fit
+static void compareStringsInLinearSpace(benchmark::State& state) {
+    compareStrings(state, TextualDifferencesHelper::Algorithm::LinearSpace);
+}
+BENCHMARK(compareStringsInLinearSpace)->Arg(0)->Arg(1)->Arg(16)->Arg(256);
+} // namespace Benchmarks
@@ -0,0 +1,98 @@
+//
+//  TextualDifferencesTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "TextualDifferencesHelper.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+// Text from a few distinct characters and lines, so that there are many equally long differences
+static std::string randomText(std::mt19937& random, size_t length) {
+    static const char characters[] = "aab\n";
+    std::string result;
+    for (size_t i = 0; i < length; i++) {
+        result += characters[random() % (sizeof(characters) - 1)];
+    }
+    return result;
+}
+
+// Replaces, inserts and deletes runs of the text
+static std::string randomEdit(std::mt19937& random, std::string text, int edits) {
+    for (int i = 0; i < edits; i++) {
+        size_t position = text.empty() ? 0 : random() % text.size();
+        size_t length = std::min<size_t>(random() % 16, text.size() - position);
+        switch (random() % 3) {
+        case 0:
+            text.replace(position, length, randomText(random, length));
+            break;
+        case 1:
+            text.insert(position, randomText(random, length));
+            break;
+        case 2:
+            text.erase(position, length);
+            break;
+        }
+    }
+    return text;
+}
+
+static std::string describe(const WTF::Vector<DiffChunk>& chunks) {
+    std::string result;
+    for (const DiffChunk& chunk : chunks) {
+        result += "(" + std::to_string(chunk.pos1) + ", " + std::to_string(chunk.pos2) + ", " + std::to_string(chunk.len1) + ", " + std::to_string(chunk.len2) + ") ";
+    }
+    return result;
+}
+
+static void expectSameDifference(const std::string& s1, const std::string& s2) {
+    WTF::String string1(s1);
+    WTF::String string2(s2);
+    WTF::Vector<DiffChunk> table = TextualDifferencesHelper::CompareStrings(string1, string2, TextualDifferencesHelper::Algorithm::Table);
+    WTF::Vector<DiffChunk> linearSpace = TextualDifferencesHelper::CompareStrings(string1, string2, TextualDifferencesHelper::Algorithm::LinearSpace);
+    ASSERT_EQ(describe(table), describe(linearSpace)) << "between\n"
+                                                      << s1 << "\nand\n"
+                                                      << s2;
+}
+
+TEST(TextualDifferences, LinearSpaceMatchesTableOnEdgeCases) {
+    expectSameDifference("", "");
+    expectSameDifference("", "a\nb");
+    expectSameDifference("a\nb", "");
+    expectSameDifference("a\nb\nc", "a\nb\nc");
+    expectSameDifference("a\nb", "b\na");
+    expectSameDifference("ab", "ba");
+    expectSameDifference("a\na\na\n", "a\n");
+    expectSameDifference("abab", "baba");
+}
+
+TEST(TextualDifferences, LinearSpaceMatchesTableOnRandomEdits) {
+    std::mt19937 random(0);
+    for (int i = 0; i < 2000; i++) {
+        std::string original = randomText(random, random() % 200);
+        expectSameDifference(original, randomEdit(random, original, 1 + random() % 8));
+    }
+}
+
+TEST(TextualDifferences, LinearSpaceMatchesTableOnUnrelatedTexts) {
+    std::mt19937 random(1);
+    for (int i = 0; i < 200; i++) {
+        expectSameDifference(randomText(random, random() % 300), randomText(random, random() % 300));
+    }
+}
+
+// Large enough for the linear space differencer to bisect before it walks a table
+TEST(TextualDifferences, LinearSpaceMatchesTableOnLargeInputs) {
+    std::mt19937 random(2);
+    for (int i = 0; i < 3; i++) {
+        std::string original = randomText(random, 12000);
+        expectSameDifference(original, randomEdit(random, original, 400));
+        expectSameDifference(original, randomText(random, 12000));
+    }
+}
+} // namespace Benchmarks
@@ -0,0 +1,80 @@
+//
+//  TimerQueueBenchmarks.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "TimerQueue.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+// Scheduling the range argument of timers at random times and firing them all
+static void scheduleAndFire(benchmark::State& state) {
+    std::mt19937 random(0);
+    std::uniform_real_distribution<double> fireTimes(0, 1000);
+
+    for (auto _ : state) {
+        TimerQueue queue;
+        for (int64_t i = 0; i < state.range(0); i++) {
+            queue.schedule(fireTimes(random));
+        }
+
+        queue.beginBatch(1000);
+        TimerQueue::TimerId id;
+        while (queue.takeExpired(id)) {
+            benchmark::DoNotOptimize(id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(scheduleAndFire)->Arg(16)->Arg(1024)->Arg(65536);
+
+// Debouncing: most timers are cleared before they fire
+static void scheduleAndCancel(benchmark::State& state) {
+    TimerQueue queue;
+    double now = 0;
+    std::vector<TimerQueue::TimerId> pending;
+    for (auto _ : state) {
+        pending.push_back(queue.schedule(now + 100));
+        if (pending.size() == static_cast<size_t>(state.range(0))) {
+            for (TimerQueue::TimerId id : pending) {
+                queue.cancel(id);
+            }
+            pending.clear();
+
+            now += 1;
+            queue.beginBatch(now);
+            TimerQueue::TimerId id;
+            while (queue.takeExpired(id)) {
+                benchmark::DoNotOptimize(id);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(scheduleAndCancel)->Arg(16)->Arg(1024);
+
+// A steady state of setInterval timers firing in every batch
+static void repeatingTimers(benchmark::State& state) {
+    TimerQueue queue;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        queue.schedule(1, 1);
+    }
+
+    double now = 0;
+    for (auto _ : state) {
+        now += 1;
+        queue.beginBatch(now);
+        TimerQueue::TimerId id;
+        while (queue.takeExpired(id)) {
+            benchmark::DoNotOptimize(id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(repeatingTimers)->Arg(16)->Arg(1024);
+} // namespace Benchmarks
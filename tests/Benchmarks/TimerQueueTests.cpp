@@ -0,0 +1,187 @@
+//
+//  TimerQueueTests.cpp
+//  Benchmarks
+//
+//  Copyright (c) 2018 Telerik. All rights reserved.
+//
+
+#include "TimerQueue.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+namespace NativeScript {
+class TimerQueueTests {
+public:
+    // Includes the entries of cancelled timers which have not been dropped yet
+    static size_t heapSize(const TimerQueue& queue) {
+        return queue._heap.size();
+    }
+
+    static void setLastId(TimerQueue& queue, TimerQueue::TimerId id) {
+        queue._lastId = id;
+    }
+};
+} // namespace NativeScript
+
+namespace Benchmarks {
+using namespace NativeScript;
+
+typedef std::vector<TimerQueue::TimerId> TimerIds;
+
+static TimerIds fire(TimerQueue& queue, double now) {
+    TimerIds fired;
+    queue.beginBatch(now);
+    TimerQueue::TimerId id;
+    while (queue.takeExpired(id)) {
+        fired.push_back(id);
+    }
+    return fired;
+}
+
+TEST(TimerQueue, TimersFireInTheOrderOfTheirFireTimes) {
+    TimerQueue queue;
+    TimerQueue::TimerId late = queue.schedule(30);
+    TimerQueue::TimerId early = queue.schedule(10);
+    TimerQueue::TimerId middle = queue.schedule(20);
+
+    EXPECT_EQ(10, queue.nextFireTime());
+    EXPECT_EQ((TimerIds{ early, middle }), fire(queue, 25));
+    EXPECT_EQ((TimerIds{ late }), fire(queue, 30));
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), queue.nextFireTime());
+}
+
+TEST(TimerQueue, TimersWithEqualFireTimesFireInTheOrderTheyWereScheduled) {
+    TimerQueue queue;
+    TimerIds scheduled;
+    for (int i = 0; i < 100; i++) {
+        scheduled.push_back(queue.schedule(10));
+    }
+
+    EXPECT_EQ(scheduled, fire(queue, 10));
+}
+
+TEST(TimerQueue, TimersScheduledDuringABatchWaitForTheNextBatch) {
+    TimerQueue queue;
+    TimerQueue::TimerId first = queue.schedule(10);
+    TimerQueue::TimerId second = queue.schedule(10);
+
+    TimerIds fired;
+    TimerIds scheduledInBatch;
+    queue.beginBatch(10);
+    TimerQueue::TimerId id;
+    while (queue.takeExpired(id)) {
+        fired.push_back(id);
+        // Already due, e.g. setTimeout(callback, 0) from a timer callback
+        scheduledInBatch.push_back(queue.schedule(5));
+    }
+
+    EXPECT_EQ((TimerIds{ first, second }), fired);
+    EXPECT_EQ(5, queue.nextFireTime());
+    EXPECT_EQ(scheduledInBatch, fire(queue, 10));
+}
+
+TEST(TimerQueue, TimersCancelledDuringABatchDoNotFire) {
+    TimerQueue queue;
+    TimerQueue::TimerId first = queue.schedule(10);
+    TimerQueue::TimerId second = queue.schedule(10);
+    TimerQueue::TimerId repeating = queue.schedule(10, 5);
+
+    queue.beginBatch(10);
+    TimerQueue::TimerId id;
+    ASSERT_TRUE(queue.takeExpired(id));
+    EXPECT_EQ(first, id);
+
+    TimerQueue::TimerId scheduledInBatch = queue.schedule(10);
+    EXPECT_TRUE(queue.cancel(second));
+    EXPECT_TRUE(queue.cancel(scheduledInBatch));
+    EXPECT_FALSE(queue.cancel(first));
+
+    ASSERT_TRUE(queue.takeExpired(id));
+    EXPECT_EQ(repeating, id);
+    // A repeating timer clearing itself from its own callback
+    EXPECT_TRUE(queue.cancel(repeating));
+    EXPECT_FALSE(queue.takeExpired(id));
+
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ((TimerIds{}), fire(queue, 100));
+}
+
+TEST(TimerQueue, RepeatingTimersAreRescheduledFromTheBatchTime) {
+    TimerQueue queue;
+    TimerQueue::TimerId repeating = queue.schedule(5, 10);
+
+    // The batch runs late, the next expiration is an interval after it
+    EXPECT_EQ((TimerIds{ repeating }), fire(queue, 7));
+    EXPECT_EQ(17, queue.nextFireTime());
+    EXPECT_EQ((TimerIds{}), fire(queue, 16));
+    EXPECT_EQ((TimerIds{ repeating }), fire(queue, 17));
+
+    // A repeating timer fires once per batch however late the batch is
+    EXPECT_EQ((TimerIds{ repeating }), fire(queue, 100));
+    EXPECT_EQ(110, queue.nextFireTime());
+    EXPECT_TRUE(queue.contains(repeating));
+}
+
+TEST(TimerQueue, NonPositiveIntervalsFireOnce) {
+    TimerQueue queue;
+    TimerQueue::TimerId timer = queue.schedule(5, -1);
+
+    EXPECT_EQ((TimerIds{ timer }), fire(queue, 5));
+    EXPECT_FALSE(queue.contains(timer));
+}
+
+TEST(TimerQueue, CancelledTimersAreCompactedOnceTheyAreHalfOfTheHeap) {
+    TimerQueue queue;
+    TimerIds scheduled;
+    for (int i = 0; i < 100; i++) {
+        scheduled.push_back(queue.schedule(100 + i));
+    }
+
+    // The latest timers are deep in the heap and never surface by themselves
+    for (int i = 0; i < 49; i++) {
+        EXPECT_TRUE(queue.cancel(scheduled[99 - i]));
+    }
+    EXPECT_EQ(100u, TimerQueueTests::heapSize(queue));
+
+    EXPECT_TRUE(queue.cancel(scheduled[50]));
+    EXPECT_EQ(50u, TimerQueueTests::heapSize(queue));
+    EXPECT_EQ(50u, queue.size());
+
+    EXPECT_EQ(TimerIds(scheduled.begin(), scheduled.begin() + 50), fire(queue, 1000));
+}
+
+TEST(TimerQueue, SmallHeapsAreNotCompacted) {
+    TimerQueue queue;
+    TimerIds scheduled;
+    for (int i = 0; i < 32; i++) {
+        scheduled.push_back(queue.schedule(100 + i));
+    }
+    for (int i = 1; i < 32; i++) {
+        queue.cancel(scheduled[i]);
+    }
+
+    EXPECT_EQ(32u, TimerQueueTests::heapSize(queue));
+    EXPECT_EQ((TimerIds{ scheduled[0] }), fire(queue, 1000));
+}
+
+TEST(TimerQueue, IdsSkipZeroAndIdsInUseAfterWrappingAround) {
+    TimerQueue queue;
+    TimerQueue::TimerId first = queue.schedule(10);
+    TimerQueue::TimerId second = queue.schedule(10);
+    TimerQueue::TimerId third = queue.schedule(10);
+    EXPECT_EQ(1u, first);
+    EXPECT_TRUE(queue.cancel(second));
+
+    TimerQueueTests::setLastId(queue, std::numeric_limits<TimerQueue::TimerId>::max() - 1);
+    TimerQueue::TimerId last = queue.schedule(10);
+    EXPECT_EQ(std::numeric_limits<TimerQueue::TimerId>::max(), last);
+
+    // 0 is never handed out, 1 and 3 are pending and 2 has been cancelled
+    EXPECT_EQ(second, queue.schedule(10));
+    EXPECT_EQ(4u, queue.schedule(10));
+    EXPECT_TRUE(queue.contains(first));
+    EXPECT_TRUE(queue.contains(third));
+}
+} // namespace Benchmarks
@@ -20,6 +20,8 @@ CFTypeRef TNSFunctionWithCreateCFTypeRefReturn() CF_RETURNS_RETAINED;
 typedef int (^NumberReturner)(int, int, int);
 
 @interface TNSObjCTypes : NSObject
+@property(nonatomic, copy) NumberReturner storedBlock;
+
 + (void)methodWithComplexBlock:(id (^)(int, id, SEL, NSObject*, TNSOStruct))block;
 
 - (void)methodWithIdOutParameter:(NSString**)value;
@@ -31,6 +33,7 @@ typedef int (^NumberReturner)(int, int, int);
 
 - (NumberReturner)methodWithBlockScope:(int)number;
 - (id)methodReturningBlockAsId:(int)number;
+- (void)storeBlockWithScope:(int)number;
 
 - (NSDate*)methodWithNSDate:(NSDate*)date;
 - (void (^)(void))methodWithBlock:(void (^)(void))block;
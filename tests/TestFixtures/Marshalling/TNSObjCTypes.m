@@ -65,6 +65,10 @@ CFTypeRef TNSFunctionWithCreateCFTypeRefReturn() {
     };
 }
 
+- (void)storeBlockWithScope:(int)number {
+    self.storedBlock = [self methodWithBlockScope:number];
+}
+
 - (NSDate*)methodWithNSDate:(NSDate*)date {
     TNSLog(date.description);
     return date;
@@ -27,6 +27,8 @@ SEL functionWithSelector(SEL x);
 Class functionWithClass(Class x);
 Protocol* functionWithProtocol(Protocol* x);
 NSNull* functionWithNull(NSNull* x);
+NSObject* functionWithNSObject(NSObject* x);
+NSString* functionWithNSString(NSString* x);
 unichar functionWithUnichar(unichar x);
 
 @interface TNSPrimitives : NSObject
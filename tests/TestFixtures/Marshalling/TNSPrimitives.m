@@ -84,6 +84,14 @@ NSNull* functionWithNull(NSNull* x) {
     TNSLog([NSString stringWithFormat:@"%@", x]);
     return x;
 }
+NSObject* functionWithNSObject(NSObject* x) {
+    TNSLog([NSString stringWithFormat:@"%@", x]);
+    return x;
+}
+NSString* functionWithNSString(NSString* x) {
+    TNSLog([NSString stringWithFormat:@"%@", x]);
+    return x;
+}
 unichar functionWithUnichar(unichar x) {
     TNSLog([NSString stringWithFormat:@"%C", x]);
     return x;
@@ -20,6 +20,11 @@ void TNSClearOutput();
 
 void TNSSaveResults(NSString*);
 
+NSDictionary<NSString*, NSNumber*>* TNSInteropHeapUsage();
+
+// Replaces the source of a loaded module through the inspector, the way LiveEdit does. Returns an error message or nil.
+NSString* TNSLiveEditScript(NSString* path, NSString* source);
+
 #if defined __cplusplus
 }
 #endif
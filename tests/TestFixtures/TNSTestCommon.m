@@ -8,6 +8,14 @@
 
 #import "TNSTestCommon.h"
 
+// Implemented by the runtime the test app links, whose headers the fixtures don't depend on
+@interface NSObject (TNSRuntimeForTests)
++ (instancetype)current;
+- (NSDictionary<NSString*, NSNumber*>*)interopHeapUsage;
+- (id)attachInspectorWithHandler:(void (^)(NSString*))messageHandler;
+- (void)dispatchMessage:(NSString*)message;
+@end
+
 #ifdef DEBUG
 bool TNSIsConfigurationDebug = true;
 #else
@@ -53,3 +61,51 @@ void TNSSaveResults(NSString* result) {
                                      userInfo:nil];
     }
 }
+
+NSDictionary<NSString*, NSNumber*>* TNSInteropHeapUsage() {
+    return [[NSClassFromString(@"TNSRuntime") current] interopHeapUsage];
+}
+
+static id TNSInspector;
+static NSMutableDictionary<NSString*, NSString*>* TNSScriptIds;
+static NSDictionary* TNSInspectorResponse;
+
+static void TNSDispatchInspectorMessage(NSDictionary* message) {
+    NSData* data = [NSJSONSerialization dataWithJSONObject:message options:0 error:nil];
+    TNSInspectorResponse = nil;
+    [TNSInspector dispatchMessage:[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]];
+}
+
+NSString* TNSLiveEditScript(NSString* path, NSString* source) {
+    if (TNSInspector == nil) {
+        TNSScriptIds = [NSMutableDictionary new];
+        TNSInspector = [[NSClassFromString(@"TNSRuntime") current] attachInspectorWithHandler:^(NSString* message) {
+            NSDictionary* json = [NSJSONSerialization JSONObjectWithData:[message dataUsingEncoding:NSUTF8StringEncoding] options:0 error:nil];
+            if ([json[@"method"] isEqualToString:@"Debugger.scriptParsed"]) {
+                TNSScriptIds[json[@"params"][@"url"]] = json[@"params"][@"scriptId"];
+            } else if (json[@"id"]) {
+                TNSInspectorResponse = json;
+            }
+        }];
+        // Scripts which have already been loaded are reported when the debugger is enabled
+        TNSDispatchInspectorMessage(@{ @"id" : @1, @"method" : @"Debugger.enable" });
+    }
+
+    NSString* scriptId = nil;
+    for (NSString* url in TNSScriptIds) {
+        if ([url hasSuffix:path]) {
+            scriptId = TNSScriptIds[url];
+        }
+    }
+    if (scriptId == nil) {
+        return [NSString stringWithFormat:@"%@ has not been loaded", path];
+    }
+
+    TNSDispatchInspectorMessage(@{ @"id" : @2,
+                                   @"method" : @"Debugger.setScriptSource",
+                                   @"params" : @{ @"scriptId" : scriptId, @"scriptSource" : source } });
+    if (TNSInspectorResponse == nil) {
+        return @"Debugger.setScriptSource did not respond";
+    }
+    return TNSInspectorResponse[@"error"][@"message"];
+}
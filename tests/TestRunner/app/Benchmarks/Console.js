@@ -0,0 +1,21 @@
+// console.log() of objects, which are stringified by smartStringify when they use the default toString()
+
+var plainObject = { name: "plain", values: [1, 2, 3] };
+
+function Point(x, y) {
+    this.x = x;
+    this.y = y;
+}
+var instance = new Point(1, 2);
+
+benchmark("console.log(plain object)", 1000, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        console.log(plainObject);
+    }
+});
+
+benchmark("console.log(instance)", 1000, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        console.log(instance);
+    }
+});
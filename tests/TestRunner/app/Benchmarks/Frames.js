@@ -0,0 +1,40 @@
+// __requestAnimationFrame with 1, 10 and 100 callbacks per frame. The reported time per iteration is that
+// of a whole frame, so the time spent in the callbacks of a frame is logged separately.
+
+[1, 10, 100].forEach(function (callbacksPerFrame) {
+    var name = callbacksPerFrame + " frame callbacks per frame";
+
+    benchmarkAsync(name, 120, function (frames, done) {
+        var frame = 0;
+        var dispatchTime = 0;
+        var frameStart;
+
+        function first() {
+            frameStart = __time();
+        }
+
+        function callback() {
+        }
+
+        function last() {
+            dispatchTime += __time() - frameStart;
+            if (++frame < frames) {
+                request();
+                return;
+            }
+
+            console.log("Benchmark: " + name + " " + (dispatchTime * 1e6 / frames).toFixed(1) + " ns dispatching per frame");
+            done();
+        }
+
+        function request() {
+            __requestAnimationFrame(first);
+            for (var i = 0; i < callbacksPerFrame; i++) {
+                __requestAnimationFrame(callback);
+            }
+            __requestAnimationFrame(last);
+        }
+
+        request();
+    });
+});
@@ -0,0 +1,32 @@
+// Startup cost of an application which defines many TypeScript classes extending native ones,
+// most of which are not instantiated right away
+
+function defineSubclass() {
+    var BenchmarkSubclass = (function (_super) {
+        __extends(BenchmarkSubclass, _super);
+        function BenchmarkSubclass() {
+            return _super !== null && _super.apply(this, arguments) || this;
+        }
+        BenchmarkSubclass.prototype.description = function () {
+            return "BenchmarkSubclass";
+        };
+        BenchmarkSubclass.prototype.isEqual = function (other) {
+            return this === other;
+        };
+        return BenchmarkSubclass;
+    }(NSObject));
+
+    return BenchmarkSubclass;
+}
+
+benchmark("define 300 TypeScript subclasses", 300, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        defineSubclass();
+    }
+}, { warmUp: false });
+
+benchmark("define and instantiate 300 TypeScript subclasses", 300, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        defineSubclass().alloc().init();
+    }
+}, { warmUp: false });
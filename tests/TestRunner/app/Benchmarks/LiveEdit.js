@@ -0,0 +1,53 @@
+// LiveEdit of a large module: the time from replacing the source of one function in the middle of the
+// file until all of its functions have run again, the edited one with its new body. The edit changes
+// the length of the function, so that all functions after it move and have to be relinked.
+//
+// The inspector this attaches stays attached, so the benchmark is required last and runs after all others.
+
+var functionsCount = 2000;
+var editedFunction = functionsCount / 2;
+
+function liveEditModuleSource(edit) {
+    var source = "";
+    for (var i = 0; i < functionsCount; i++) {
+        var result = i === editedFunction && edit !== undefined ? "\"edit" + edit + "\" /*" + new Array(edit % 7 + 2).join(" ") + "*/" : i;
+        source += "exports.f" + i + " = function () {\n    return " + result + ";\n};\n";
+    }
+    return source;
+}
+
+var liveEditDirectory = NSTemporaryDirectory() + "LiveEdit-" + NSUUID.UUID().UUIDString;
+var liveEditModulePath = liveEditDirectory + "/large-module.js";
+NSFileManager.defaultManager.createDirectoryAtPathWithIntermediateDirectoriesAttributesError(liveEditDirectory, true, null, null);
+NSFileManager.defaultManager.createFileAtPathContentsAttributes(liveEditModulePath, NSString.stringWithString(liveEditModuleSource()).dataUsingEncoding(NSUTF8StringEncoding), null);
+
+var largeModule = require(liveEditModulePath);
+
+function callAll() {
+    var result;
+    for (var i = 0; i < functionsCount; i++) {
+        var value = largeModule["f" + i]();
+        if (i === editedFunction) {
+            result = value;
+        }
+    }
+    return result;
+}
+
+// Link all functions before the first edit
+callAll();
+
+benchmarkAsync("LiveEdit of one function in a module of " + functionsCount + " functions", 20, function (iterations, done) {
+    for (var i = 0; i < iterations; i++) {
+        var error = TNSLiveEditScript(liveEditModulePath, liveEditModuleSource(i));
+        if (error) {
+            throw new Error("Debugger.setScriptSource failed: " + error);
+        }
+
+        var result = callAll();
+        if (result !== "edit" + i) {
+            throw new Error("The edited function returned " + result + " instead of edit" + i);
+        }
+    }
+    done();
+});
@@ -0,0 +1,82 @@
+// toObject, interop.handleof and interop.sizeof for each kind of value they dispatch on
+
+var receiver = NSObject.alloc().init();
+
+var objects = {
+    "string": "a string",
+    "number": 42.5,
+    "wrapper": NSObject.alloc().init(),
+    "constructor": NSObject,
+    "array": [1, 2, 3],
+    "typed array": new Uint8Array(16),
+    "pointer": interop.alloc(16),
+    "date": new Date(),
+    "object": { a: 1 },
+};
+
+Object.keys(objects).forEach(function (kind) {
+    var value = objects[kind];
+    benchmark("toObject " + kind, 100000, function (iterations) {
+        for (var i = 0; i < iterations; i++) {
+            receiver.isEqual(value);
+        }
+    });
+});
+
+var handles = {
+    "wrapper": objects["wrapper"],
+    "constructor": NSObject,
+    "typed array": objects["typed array"],
+    "pointer": objects["pointer"],
+    "reference": new interop.Reference(interop.types.int32, 1),
+};
+
+Object.keys(handles).forEach(function (kind) {
+    var value = handles[kind];
+    benchmark("handleof " + kind, 100000, function (iterations) {
+        for (var i = 0; i < iterations; i++) {
+            interop.handleof(value);
+        }
+    });
+});
+
+var sizes = {
+    "wrapper": objects["wrapper"],
+    "constructor": NSObject,
+    "simple type": interop.types.int32,
+    "record constructor": CGRect,
+    "pointer": objects["pointer"],
+};
+
+Object.keys(sizes).forEach(function (kind) {
+    var value = sizes[kind];
+    benchmark("sizeof " + kind, 100000, function (iterations) {
+        for (var i = 0; i < iterations; i++) {
+            interop.sizeof(value);
+        }
+    });
+});
+
+// Reading a native block which is stored in a property returns the wrapper created by the first read
+var blockOwner = TNSObjCTypes.alloc().init();
+blockOwner.storeBlockWithScope(4);
+
+benchmark("read stored block", 100000, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        blockOwner.storedBlock;
+    }
+});
+
+// Arguments of NSString and id parameters, written without the method tables of their types
+benchmark("NSString argument", 100000, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        NSString.stringWithString("a string");
+    }
+});
+
+var argumentObject = NSObject.alloc().init();
+benchmark("id argument", 100000, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        receiver.isEqual(argumentObject);
+    }
+});
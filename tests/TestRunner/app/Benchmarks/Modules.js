@@ -0,0 +1,49 @@
+// require() of modules which have already been loaded from the same referrer
+
+require("../Modules/empty-file");
+
+benchmark("cached require", 100000, function (iterations) {
+    for (var i = 0; i < iterations; i++) {
+        require("../Modules/empty-file");
+    }
+});
+
+// Application startup: the first require() of many modules, each of which queues some promise work
+// of its own. The modules are written to a fresh directory so that every run loads them from disk.
+var startupModulesCount = 200;
+
+function writeStartupModules(name) {
+    var directory = NSTemporaryDirectory() + "StartupModules-" + NSUUID.UUID().UUIDString + "/" + name;
+    var fileManager = NSFileManager.defaultManager;
+    fileManager.createDirectoryAtPathWithIntermediateDirectoriesAttributesError(directory, true, null, null);
+    for (var i = 0; i < startupModulesCount; i++) {
+        var source = "exports.index = " + i + "; Promise.resolve().then(function () { exports.settled = true; });";
+        fileManager.createFileAtPathContentsAttributes(directory + "/module" + i + ".js", NSString.stringWithString(source).dataUsingEncoding(NSUTF8StringEncoding), null);
+    }
+    return directory;
+}
+
+function requireStartupModules(directory, iterations) {
+    for (var i = 0; i < iterations; i++) {
+        require(directory + "/module" + i + ".js");
+    }
+}
+
+var idleStartupDirectory = writeStartupModules("idle");
+benchmark("startup require", startupModulesCount, function (iterations) {
+    requireStartupModules(idleStartupDirectory, iterations);
+}, { warmUp: false });
+
+// The same with application microtasks pending, which require() must leave for the run loop
+var busyStartupDirectory = writeStartupModules("busy");
+benchmark("startup require with 10000 pending microtasks", startupModulesCount, function (iterations) {
+    var pendingMicrotasksRan = 0;
+    for (var i = 0; i < 10000; i++) {
+        Promise.resolve().then(function () { pendingMicrotasksRan++; });
+    }
+
+    requireStartupModules(busyStartupDirectory, iterations);
+    if (pendingMicrotasksRan !== 0) {
+        throw new Error(pendingMicrotasksRan + " pending microtasks ran inside require()");
+    }
+}, { warmUp: false });
@@ -0,0 +1,78 @@
+// A sum split between workers, with each part either copied to a worker and back by postMessage or read
+// from a SharedArrayBuffer, against the same sum on the main thread. The time of the workers includes
+// starting them.
+
+var workersCount = 4;
+var length = 4 * 1024 * 1024;
+var partLength = length / workersCount;
+var expectedSum = 0;
+
+var buffer = new SharedArrayBuffer(length * Int32Array.BYTES_PER_ELEMENT);
+var values = new Int32Array(buffer);
+for (var i = 0; i < length; i++) {
+    values[i] = i % 7;
+    expectedSum += values[i];
+}
+
+benchmark("sum of a 16 MB Int32Array on the main thread", 5, function (iterations) {
+    for (var iteration = 0; iteration < iterations; iteration++) {
+        var sum = 0;
+        for (var i = 0; i < length; i++) {
+            sum += values[i];
+        }
+    }
+}, { warmUp: false });
+
+function benchmarkWorkers(name, partMessage) {
+    benchmarkAsync(name, 5, function (iterations, done) {
+        var workers = [];
+        var pendingSums = 0;
+        var sum = 0;
+        var iteration = 0;
+
+        function post() {
+            pendingSums = workersCount;
+            sum = 0;
+            workers.forEach(function (worker, index) {
+                worker.postMessage(partMessage(index * partLength, (index + 1) * partLength));
+            });
+        }
+
+        function onmessage(message) {
+            sum += message.data.sum;
+            if (--pendingSums > 0) {
+                return;
+            }
+
+            if (sum !== expectedSum) {
+                throw new Error("The workers summed up to " + sum + " instead of " + expectedSum);
+            }
+
+            if (++iteration < iterations) {
+                post();
+                return;
+            }
+
+            workers.forEach(function (worker) {
+                worker.terminate();
+            });
+            done();
+        }
+
+        for (var i = 0; i < workersCount; i++) {
+            var worker = new Worker("./ReductionWorker.js");
+            worker.onmessage = onmessage;
+            workers.push(worker);
+        }
+
+        post();
+    });
+}
+
+benchmarkWorkers("sum of a 16 MB Int32Array copied to " + workersCount + " workers and back", function (begin, end) {
+    return { values: Array.prototype.slice.call(values, begin, end) };
+});
+
+benchmarkWorkers("sum of a 16 MB Int32Array shared with " + workersCount + " workers", function (begin, end) {
+    return { buffer: buffer, begin: begin, end: end };
+});
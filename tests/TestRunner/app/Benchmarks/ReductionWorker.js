@@ -0,0 +1,20 @@
+// Sums its part of the values and posts the sum back. A part is either a range of a shared Int32Array, or a
+// copy of the values, which is posted back with the sum the way a worker returns processed data.
+
+onmessage = function (message) {
+    var sum = 0;
+    if (message.data.buffer) {
+        var view = new Int32Array(message.data.buffer);
+        for (var i = message.data.begin; i < message.data.end; i++) {
+            sum += view[i];
+        }
+        postMessage({ sum: sum });
+        return;
+    }
+
+    var values = message.data.values;
+    for (var i = 0; i < values.length; i++) {
+        sum += values[i];
+    }
+    postMessage({ sum: sum, values: values });
+};
@@ -0,0 +1,5 @@
+// Posts every message it receives back to the benchmark which started it
+
+onmessage = function (message) {
+    postMessage(message.data);
+};
@@ -0,0 +1,3 @@
+// Posts a message as soon as it starts, for the benchmark of how long a new worker takes to respond
+
+postMessage("ready");
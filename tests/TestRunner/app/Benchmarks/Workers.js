@@ -0,0 +1,57 @@
+// Round trips of large messages through a worker. Besides the timing, the throughput and the peak
+// resident size of the process are logged, which show whether the message buffers are released.
+
+var messageSize = 10 * 1024 * 1024;
+
+function peakResidentMegabytes() {
+    var usage = new interop.Reference(rusage, new rusage());
+    getrusage(0 /* RUSAGE_SELF */, usage);
+    // ru_maxrss is in bytes on Darwin
+    return usage.value.ru_maxrss / (1024 * 1024);
+}
+
+benchmarkAsync("10 MB worker message round trip", 20, function (iterations, done) {
+    var message = new Array(messageSize + 1).join("x");
+    var worker = new Worker("./WorkerEcho.js");
+    var residentBefore = peakResidentMegabytes();
+    var start = __time();
+    var received = 0;
+
+    worker.onmessage = function (response) {
+        if (response.data.length !== messageSize) {
+            throw new Error("Received " + response.data.length + " characters instead of " + messageSize);
+        }
+
+        if (++received < iterations) {
+            worker.postMessage(message);
+            return;
+        }
+
+        var seconds = (__time() - start) / 1000;
+        console.log("Benchmark: 10 MB worker message round trip " + (2 * iterations * messageSize / (1024 * 1024) / seconds).toFixed(1) + " MB/s, peak resident size " + residentBefore.toFixed(1) + " MB before " + peakResidentMegabytes().toFixed(1) + " MB after");
+        worker.terminate();
+        done();
+    };
+
+    worker.postMessage(message);
+});
+
+// The time from creating a worker until its first message arrives, most of which is setting up the
+// worker's runtime and global object
+benchmarkAsync("worker first message", 20, function (iterations, done) {
+    var started = 0;
+
+    function startWorker() {
+        var worker = new Worker("./WorkerReady.js");
+        worker.onmessage = function () {
+            worker.terminate();
+            if (++started < iterations) {
+                startWorker();
+            } else {
+                done();
+            }
+        };
+    }
+
+    startWorker();
+});
@@ -0,0 +1,62 @@
+// On-device micro benchmarks of the paths which depend on JavaScriptCore or the Objective-C runtime and
+// cannot run in tests/Benchmarks. They run instead of the tests when the application is launched with
+// the -benchmarks argument and print one line per benchmark:
+//
+//   Benchmark: <name> <iterations> iterations <total> ms <per iteration> ns/iter
+
+var benchmarks = [];
+var asyncBenchmarks = [];
+
+// Benchmarks of one time work, e.g. defining classes, pass { warmUp: false }
+global.benchmark = function (name, iterations, body, options) {
+    benchmarks.push({ name: name, iterations: iterations, body: body, warmUp: !options || options.warmUp !== false });
+};
+
+// Benchmarks which complete on the run loop, e.g. of workers, call done() once all iterations finished.
+// They run one at a time after the synchronous ones and are not warmed up.
+global.benchmarkAsync = function (name, iterations, body) {
+    asyncBenchmarks.push({ name: name, iterations: iterations, body: body });
+};
+
+function report(entry, total) {
+    console.log("Benchmark: " + entry.name + " " + entry.iterations + " iterations " + total.toFixed(2) + " ms " + (total * 1e6 / entry.iterations).toFixed(1) + " ns/iter");
+}
+
+function measure(entry) {
+    // Warm up so that the measured iterations run in the JIT tiers
+    if (entry.warmUp) {
+        entry.body(Math.min(entry.iterations, 1000));
+    }
+
+    var start = __time();
+    entry.body(entry.iterations);
+    report(entry, __time() - start);
+}
+
+function measureAsync(entries, index) {
+    if (index === entries.length) {
+        console.log("Benchmark: done");
+        return;
+    }
+
+    var entry = entries[index];
+    var start = __time();
+    entry.body(entry.iterations, function () {
+        report(entry, __time() - start);
+        measureAsync(entries, index + 1);
+    });
+}
+
+exports.run = function () {
+    require("./Marshalling");
+    require("./Inheritance");
+    require("./Modules");
+    require("./Console");
+    require("./Workers");
+    require("./Frames");
+    require("./Reduction");
+    require("./LiveEdit");
+
+    benchmarks.forEach(measure);
+    measureAsync(asyncBenchmarks, 0);
+};
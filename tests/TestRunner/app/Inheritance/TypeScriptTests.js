@@ -310,4 +310,25 @@ describe(module.id, function () {
             'variadicSelector:js x:5 called' +
             'staticFunc:9 called');
     });
+    it('registers the native class as soon as it is defined', function () {
+        var TSEagerlyRegisteredObject = (function (_super) {
+            __extends(TSEagerlyRegisteredObject, _super);
+            function TSEagerlyRegisteredObject() {
+                return _super !== null && _super.apply(this, arguments) || this;
+            }
+            Object.defineProperty(TSEagerlyRegisteredObject.prototype, "description", {
+                get: function () {
+                    return "TSEagerlyRegisteredObject description";
+                },
+                enumerable: true,
+                configurable: true
+            });
+            return TSEagerlyRegisteredObject;
+        }(NSObject));
+        expect(NSClassFromString('TSEagerlyRegisteredObject')).toBe(TSEagerlyRegisteredObject);
+
+        var object = NSClassFromString('TSEagerlyRegisteredObject').alloc().init();
+        expect(object instanceof TSEagerlyRegisteredObject).toBe(true);
+        expect(NSString.stringWithFormat("%@", object).toString()).toBe("TSEagerlyRegisteredObject description");
+    });
 });
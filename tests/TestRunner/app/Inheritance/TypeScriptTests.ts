@@ -383,4 +383,17 @@ describe(module.id, function () {
         );
     });
 
+    it('registers the native class as soon as it is defined', function () {
+        class TSEagerlyRegisteredObject extends NSObject {
+            get description() {
+                return "TSEagerlyRegisteredObject description";
+            }
+        }
+        expect(NSClassFromString('TSEagerlyRegisteredObject')).toBe(TSEagerlyRegisteredObject);
+
+        const object = NSClassFromString('TSEagerlyRegisteredObject').alloc().init();
+        expect(object instanceof TSEagerlyRegisteredObject).toBe(true);
+        expect(NSString.stringWithFormat("%@", object).toString()).toBe("TSEagerlyRegisteredObject description");
+    });
+
 });
@@ -0,0 +1,50 @@
+// Arguments of the common types are written inline by FFICall instead of through the method table of
+// their type. Each value is passed to a native function, which returns it unchanged, and is written to a
+// reference of the same type through the method table. Both are read back the same way, so they match
+// only if the bytes written do.
+describe(module.id, function () {
+    afterEach(function () {
+        TNSClearOutput();
+    });
+
+    function writtenThroughMethodTable(type, value) {
+        var reference = new interop.Reference(type);
+        reference.value = value;
+        return reference.value;
+    }
+
+    function expectSameWrites(nativeFunction, type, values) {
+        values.forEach(function (value) {
+            // The value is compared along, so that a mismatch tells which one it is
+            expect([value, nativeFunction(value)]).toEqual([value, writtenThroughMethodTable(type, value)]);
+        });
+    }
+
+    var numbers = [0, -0, 1, -1, 1.9, -1.9, 127, -128, 128, -129, 255, 256, 300, -300, 65536 + 7, 1e10, -1e10, NaN, Infinity, -Infinity, "12", "x", true, false, null, undefined, {}, [5]];
+
+    it("Int8 wraps around like the int8 method table", function () {
+        expectSameWrites(functionWithChar, interop.types.int8, numbers);
+    });
+
+    it("UInt8 wraps around like the uint8 method table", function () {
+        expectSameWrites(functionWithUChar, interop.types.uint8, numbers);
+    });
+
+    it("Bool converts like the bool method table", function () {
+        expectSameWrites(functionWithBool, interop.types.bool, [0, -0, 1, 2, -1, 0.5, NaN, "", "x", "false", true, false, null, undefined, {}, []]);
+    });
+
+    it("Float rounds like the float method table", function () {
+        expectSameWrites(functionWithFloat, interop.types.float, numbers.concat([0.1, 1 / 3, 3.4028234663852886e38, 1e40, -1e40, 1e-46, "1.5"]));
+    });
+
+    it("String writes like the NSString method table", function () {
+        expectSameWrites(functionWithNSString, NSString, ["", "abc", "ünïcødé 😀", NSString.stringWithString("native"), 42, null, undefined]);
+    });
+
+    it("Object writes like the NSObject method table", function () {
+        var object = NSObject.alloc().init();
+        expectSameWrites(functionWithNSObject, NSObject, [object, null, undefined, "abc", 42]);
+        expect(functionWithNSObject(object)).toBe(object);
+    });
+});
@@ -13,6 +13,12 @@ describe(module.id, function () {
         expect(TNSEnums[1]).toBe('TNSEnum3');
     });
 
+    it("EnumMatchesTsEnum", function () {
+        var expected = __tsEnum({ "TNSEnum1": -1, "TNSEnum2": 0, "TNSEnum3": 1 });
+        expect(Object.keys(TNSEnums)).toEqual(Object.keys(expected));
+        expect(Object.getPrototypeOf(TNSEnums)).toBe(Object.prototype);
+    });
+
     it("Options", function () {
         expect(TNSOptions.TNSOption1).toBe(1);
         expect(TNSOptions.TNSOption2).toBe(2);
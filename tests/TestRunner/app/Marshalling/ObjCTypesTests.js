@@ -109,6 +109,20 @@ describe(module.id, function () {
         expect(block(1, 2, 3)).toBe(10);
     });
 
+    it("StoredNativeBlockKeepsIdentity", function () {
+        var object = TNSObjCTypes.alloc().init();
+        object.storeBlockWithScope(4);
+
+        var block = object.storedBlock;
+        expect(object.storedBlock).toBe(block);
+        expect(block(1, 2, 3)).toBe(10);
+
+        object.storeBlockWithScope(5);
+        expect(object.storedBlock).not.toBe(block);
+        expect(object.storedBlock.length).toBe(3);
+        expect(object.storedBlock(1, 2, 3)).toBe(11);
+    });
+
     it("MethodWithNSDate", function () {
         expect(TNSObjCTypes.alloc().init().methodWithNSDate(new Date(1e12))).toEqual(new Date(1e12));
         expect(TNSGetOutput()).toBe('2001-09-09 01:46:40 +0000');
@@ -29,6 +29,44 @@ describe(module.id, function () {
         expect(module).toBeDefined();
      });
 
+     it("repeated require returns the loaded exports", function () {
+        const first = require("./empty-file");
+        let same = true;
+        for (let i = 0; i < 1000; i++) {
+            same = same && require("./empty-file") === first;
+        }
+        expect(same).toBe(true);
+     });
+
+     it("require of a module which import() is still loading", function (done) {
+        let pendingMicrotaskRan = false;
+        Promise.resolve().then(() => pendingMicrotaskRan = true);
+
+        const imported = import("./pending-import");
+        expect(() => require("./pending-import")).toThrowError(/being loaded by an import\(\)/);
+        expect(pendingMicrotaskRan).toBe(false);
+
+        imported.then(() => {
+            expect(require("./pending-import").loaded).toBe(true);
+            done();
+        }, done.fail);
+     });
+
+     it("require does not run pending application microtasks", function (done) {
+        let pendingMicrotaskRan = false;
+        Promise.resolve().then(() => pendingMicrotaskRan = true);
+
+        const module = require("./microtask-queue");
+        expect(pendingMicrotaskRan).toBe(false);
+        expect(module.bodyMicrotaskRan).toBe(false);
+
+        Promise.resolve().then(() => {
+            expect(pendingMicrotaskRan).toBe(true);
+            expect(module.bodyMicrotaskRan).toBe(true);
+            done();
+        });
+     });
+
      it("'use strict'; statement is respected", function(){
         let requireFunc = () => require("./strict-violation-use-strict");
         expect(requireFunc).toThrowError("Cannot delete unqualified property 'x' in strict mode.");
@@ -0,0 +1,5 @@
+Promise.resolve().then(() => {
+    exports.bodyMicrotaskRan = true;
+});
+
+exports.bodyMicrotaskRan = false;
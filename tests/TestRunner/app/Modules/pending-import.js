@@ -0,0 +1 @@
+exports.loaded = true;
@@ -150,3 +150,67 @@ describe("Constructing Objective-C classes with new operator", function () {
         });
     })
 });
+
+// The test app sets ios.weakClassConstructors, so constructors without references can be collected
+describe("Weakly held class constructors", function () {
+    it("should keep the identity of a constructor while it is referenced", function () {
+        var constructor = TNSClassWithPlaceholder;
+        __collect();
+
+        expect(TNSClassWithPlaceholder).toBe(constructor);
+        expect(new TNSClassWithPlaceholder().constructor).toBe(constructor);
+    });
+
+    it("should keep the constructor of live instances", function () {
+        var instance = new TNSClassWithPlaceholder();
+        __collect();
+
+        expect(instance instanceof TNSClassWithPlaceholder).toBe(true);
+        expect(Object.getPrototypeOf(instance)).toBe(TNSClassWithPlaceholder.prototype);
+        expect(instance.constructor).toBe(TNSClassWithPlaceholder);
+    });
+
+    it("should rematerialize a working constructor after the references are dropped", function () {
+        (function () {
+            var instance = new TNSClassWithPlaceholder();
+            expect(instance.description).toBe("real");
+        })();
+        __collect();
+
+        var instance = new TNSClassWithPlaceholder();
+        expect(instance.description).toBe("real");
+        expect(instance instanceof TNSClassWithPlaceholder).toBe(true);
+        expect(instance instanceof NSObject).toBe(true);
+        expect(Object.getPrototypeOf(instance)).toBe(TNSClassWithPlaceholder.prototype);
+        expect(Object.getPrototypeOf(TNSClassWithPlaceholder.prototype)).toBe(NSObject.prototype);
+        expect(TNSClassWithPlaceholder.prototype.constructor).toBe(TNSClassWithPlaceholder);
+        expect(TNSClassWithPlaceholder.alloc().init() instanceof TNSClassWithPlaceholder).toBe(true);
+    });
+
+    it("should not be cached as properties of the global object", function () {
+        expect(Object.getOwnPropertyDescriptor(global, "TNSClassWithPlaceholder")).toBeUndefined();
+        expect(typeof TNSClassWithPlaceholder).toBe("function");
+    });
+});
+
+describe("Interop heap usage", function () {
+    it("should report the bytes held by each materialized class under its name", function () {
+        var instance = new TNSCInterface();
+        var usage = TNSInteropHeapUsage();
+
+        expect(usage.objectForKey("TNSCInterface")).toBeGreaterThan(0);
+        expect(usage.objectForKey("NSObject")).toBeGreaterThan(0);
+        expect(usage.objectForKey("TNSNeverMaterializedClass")).toBeNull();
+        UNUSED(instance);
+    });
+
+    it("should report only classes, with a positive size", function () {
+        var usage = TNSInteropHeapUsage();
+        var names = usage.allKeys;
+        for (var i = 0; i < names.count; i++) {
+            var name = names.objectAtIndex(i);
+            expect(NSClassFromString(name)).not.toBeNull();
+            expect(usage.objectForKey(name)).toBeGreaterThan(0);
+        }
+    });
+});
@@ -15,4 +15,54 @@ describe("Runtime exposes", function () {
     var timeDelta = timeEnd - timeStart;
     expect(Math.abs(dateDelta - timeDelta)).toBeLessThan(dateDelta * 0.25);
   });
+
+  it("__setTimeout, which fires timers in order with their arguments", function(done) {
+    var log = [];
+    __setTimeout(function(a, b) { log.push("late " + a + b); }, 20, 1, 2);
+    __setTimeout(function() { log.push("first"); });
+    __setTimeout(function() { log.push("second"); }, 0);
+    var cleared = __setTimeout(function() { log.push("cleared"); }, 10);
+    __clearTimeout(cleared);
+
+    __setTimeout(function() {
+      expect(log).toEqual(["first", "second", "late 12"]);
+      done();
+    }, 50);
+  });
+
+  it("__setInterval, which fires until the interval is cleared", function(done) {
+    var count = 0;
+    var id = __setInterval(function() {
+      count++;
+      if (count === 3) {
+        __clearInterval(id);
+        __setTimeout(function() {
+          expect(count).toBe(3);
+          done();
+        }, 30);
+      }
+    }, 5);
+  });
+
+  it("SharedArrayBuffer, with Atomics.wait not allowed on the main thread", function() {
+    var view = new Int32Array(new SharedArrayBuffer(8));
+    expect(Atomics.add(view, 0, 2)).toBe(0);
+    expect(Atomics.load(view, 0)).toBe(2);
+    expect(Atomics.notify(view, 0)).toBe(0);
+    expect(function() { Atomics.wait(view, 0, 2, 0); }).toThrow();
+  });
+
+  it("__requestAnimationFrame, which invokes the callbacks of a frame with the same timestamp", function(done) {
+    var timestamps = [];
+    __requestAnimationFrame(function(timestamp) { timestamps.push(timestamp); });
+    var cancelled = __requestAnimationFrame(function() { timestamps.push("cancelled"); });
+    __requestAnimationFrame(function(timestamp) {
+      timestamps.push(timestamp);
+      expect(timestamps.length).toBe(2);
+      expect(timestamps[0]).toBe(timestamps[1]);
+      expect(typeof timestamps[0]).toBe("number");
+      done();
+    });
+    __cancelAnimationFrame(cancelled);
+  });
 });
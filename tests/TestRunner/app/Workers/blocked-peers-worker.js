@@ -0,0 +1,28 @@
+// Posts messages to a nested worker which is posting to it at the same time, with queues of one message
+// which block both of them, and reports how many messages went each way
+
+onmessage = function (message) {
+    var count = message.data.count;
+    var nested = new Worker("./producer-worker", { maxBufferedMessages: 1, bufferOverflow: "block" });
+    var receivedFromNested = 0;
+    var nestedDone = false;
+
+    nested.onmessage = function (response) {
+        var data = response.data;
+        if (data.done) {
+            nestedDone = true;
+        } else if (data.received !== undefined) {
+            postMessage({ sentToNested: count, receivedFromNested: receivedFromNested, nestedDone: nestedDone, nestedReceived: data.received });
+            nested.terminate();
+        } else {
+            receivedFromNested++;
+        }
+    };
+
+    // The nested worker starts posting as soon as it takes this, while this thread is still posting
+    nested.postMessage({ command: "produce", count: count });
+    for (var i = 0; i < count; i++) {
+        nested.postMessage({ index: i });
+    }
+    nested.postMessage({ command: "report" });
+};
@@ -0,0 +1,52 @@
+// Uses console.log() and __extends for the first time after replacing JSON.stringify. The helper scripts
+// behind them are evaluated on first use and read the globals as they are by then.
+
+var stringifyCalls = 0;
+var originalStringify = JSON.stringify;
+JSON.stringify = function () {
+    stringifyCalls++;
+    return originalStringify.apply(this, arguments);
+};
+
+var circular = { name: "circular" };
+circular.self = circular;
+console.log(circular);
+
+function Base() {
+    this.isBase = true;
+}
+Base.prototype.name = function () {
+    return "Base";
+};
+
+var Derived = (function (_super) {
+    __extends(Derived, _super);
+    function Derived() {
+        return _super !== null && _super.apply(this, arguments) || this;
+    }
+    Derived.prototype.name = function () {
+        return "Derived of " + _super.prototype.name.call(this);
+    };
+    return Derived;
+}(Base));
+
+var NativeDerived = (function (_super) {
+    __extends(NativeDerived, _super);
+    function NativeDerived() {
+        return _super !== null && _super.apply(this, arguments) || this;
+    }
+    NativeDerived.prototype.greet = function () {
+        return "NativeDerived";
+    };
+    return NativeDerived;
+}(NSObject));
+
+var derived = new Derived();
+postMessage({
+    stringifyCalls: stringifyCalls,
+    derivedName: derived.name(),
+    derivedIsBase: derived instanceof Base && derived.isBase,
+    derivedConstructor: derived.constructor === Derived,
+    nativeGreeting: NativeDerived.alloc().init().greet(),
+    nativeIsNSObject: NativeDerived.alloc().init() instanceof NSObject,
+});
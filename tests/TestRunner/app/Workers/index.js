@@ -0,0 +1,171 @@
+// The worker specs common for all runtimes are in the shared tests, these cover iOS specific options
+
+describe(module.id, function () {
+    var messagesCount = 100;
+
+    it("drops the messages which do not fit in the queue and reports them", function (done) {
+        var worker = new Worker("./queue-worker", { maxBufferedMessages: 2 });
+        var received = 0;
+        var dropped = 0;
+
+        function onSettled() {
+            if (received + dropped === messagesCount) {
+                expect(dropped).toBeGreaterThan(0);
+                expect(received).toBeGreaterThan(0);
+                worker.terminate();
+                done();
+            }
+        }
+
+        worker.onmessage = function () {
+            received++;
+            onSettled();
+        };
+        worker.onmessageerror = function (error) {
+            expect(error instanceof RangeError).toBe(true);
+            dropped++;
+            onSettled();
+        };
+
+        for (var i = 0; i < messagesCount; i++) {
+            expect(worker.postMessage(i)).toBeUndefined();
+        }
+        expect(worker.bufferedAmount).toBeGreaterThan(0);
+    });
+
+    it("rejects the promises of the messages which do not fit in the queue", function (done) {
+        var worker = new Worker("./queue-worker", { maxBufferedAmount: 64, bufferOverflow: "reject" });
+        var promises = [];
+        for (var i = 0; i < messagesCount; i++) {
+            promises.push(worker.postMessage("message " + i).then(function () {
+                return true;
+            }, function (error) {
+                expect(error instanceof RangeError).toBe(true);
+                return false;
+            }));
+        }
+
+        Promise.all(promises).then(function (results) {
+            expect(results[0]).toBe(true);
+            expect(results.indexOf(false)).toBeGreaterThan(0);
+            worker.terminate();
+            done();
+        });
+    });
+
+    it("shares the memory of a SharedArrayBuffer with the worker", function (done) {
+        var worker = new Worker("./shared-buffer-worker");
+        var buffer = new SharedArrayBuffer(8);
+        var view = new Int32Array(buffer);
+
+        worker.onmessage = function (message) {
+            expect(message.data.isSameBuffer).toBe(true);
+            expect(view[0]).toBe(42);
+
+            var returnedView = new Int32Array(message.data.buffer);
+            view[1] = 7;
+            expect(returnedView[1]).toBe(7);
+            expect(returnedView[0]).toBe(42);
+
+            worker.terminate();
+            done();
+        };
+
+        worker.postMessage({ buffer: buffer, sameBuffer: buffer });
+    });
+
+    it("throws instead of blocking the main thread when the queue is full", function () {
+        var worker = new Worker("./queue-worker", { maxBufferedMessages: 1, bufferOverflow: "block" });
+        worker.postMessage(0);
+        expect(function () {
+            for (var i = 1; i < messagesCount; i++) {
+                worker.postMessage(i);
+            }
+        }).toThrowError(RangeError);
+        worker.terminate();
+    });
+
+    describe("a worker posting faster than its parent takes the messages", function () {
+        function peakResidentMegabytes() {
+            var usage = new interop.Reference(rusage, new rusage());
+            getrusage(0 /* RUSAGE_SELF */, usage);
+            // ru_maxrss is in bytes on Darwin
+            return usage.value.ru_maxrss / (1024 * 1024);
+        }
+
+        function busyWait(milliseconds) {
+            var start = Date.now();
+            while (Date.now() - start < milliseconds) {
+            }
+        }
+
+        it("blocks the worker until the slow parent catches up", function (done) {
+            var payloadSize = 1024 * 1024;
+            var maxBufferedAmount = 4 * payloadSize;
+            var worker = new Worker("./producer-worker", { maxBufferedAmount: maxBufferedAmount, bufferOverflow: "block" });
+            var residentBefore = peakResidentMegabytes();
+            var received = [];
+
+            worker.onmessage = function (message) {
+                var data = message.data;
+                if (data.done) {
+                    console.log("Workers: " + received.length + " MB from a blocked worker in " + data.elapsed + " ms, peak resident size " + residentBefore.toFixed(1) + " MB before " + peakResidentMegabytes().toFixed(1) + " MB after");
+
+                    expect(received.length).toBe(messagesCount / 2);
+                    for (var i = 0; i < received.length; i++) {
+                        expect(received[i]).toBe(i);
+                    }
+
+                    // The parent takes a message every 10 ms, so posts which found the queue full waited for it
+                    expect(data.longestPost).toBeGreaterThan(5);
+                    expect(data.maxBufferedAmount).toBeGreaterThan(0);
+                    expect(data.maxBufferedAmount).not.toBeGreaterThan(maxBufferedAmount);
+                    worker.postMessage({ command: "report" });
+                    return;
+                }
+
+                if (data.received !== undefined) {
+                    // Everything the worker posted has been taken
+                    expect(data.bufferedAmount).toBe(0);
+                    worker.terminate();
+                    done();
+                    return;
+                }
+
+                expect(data.payload.length).toBe(payloadSize);
+                received.push(data.index);
+                busyWait(10);
+            };
+
+            worker.postMessage({ command: "produce", count: messagesCount / 2, payloadSize: payloadSize });
+        });
+
+        it("does not deadlock when a worker and its nested worker are both blocked", function (done) {
+            var worker = new Worker("./blocked-peers-worker");
+            worker.onmessage = function (message) {
+                expect(message.data.nestedDone).toBe(true);
+                expect(message.data.receivedFromNested).toBe(messagesCount);
+                expect(message.data.nestedReceived).toBe(messagesCount);
+                worker.terminate();
+                done();
+            };
+
+            worker.postMessage({ count: messagesCount });
+        });
+    });
+
+    it("logs and extends classes in a fresh worker with replaced globals", function (done) {
+        var worker = new Worker("./fresh-globals-worker");
+        worker.onmessage = function (message) {
+            // console.log() of the circular object went through the replaced JSON.stringify
+            expect(message.data.stringifyCalls).toBe(1);
+            expect(message.data.derivedName).toBe("Derived of Base");
+            expect(message.data.derivedIsBase).toBe(true);
+            expect(message.data.derivedConstructor).toBe(true);
+            expect(message.data.nativeGreeting).toBe("NativeDerived");
+            expect(message.data.nativeIsNSObject).toBe(true);
+            worker.terminate();
+            done();
+        };
+    });
+});
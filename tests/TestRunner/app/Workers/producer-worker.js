@@ -0,0 +1,30 @@
+// Posts messages to its parent as fast as it can when asked to, and counts the messages it receives
+
+var received = 0;
+
+function produce(count, payloadSize) {
+    var payload = new Array(payloadSize + 1).join("x");
+    var start = Date.now();
+    var longestPost = 0;
+    var maxBufferedAmount = 0;
+
+    for (var i = 0; i < count; i++) {
+        var postStart = Date.now();
+        postMessage({ index: i, payload: payload });
+        longestPost = Math.max(longestPost, Date.now() - postStart);
+        maxBufferedAmount = Math.max(maxBufferedAmount, bufferedAmount);
+    }
+
+    postMessage({ done: true, elapsed: Date.now() - start, longestPost: longestPost, maxBufferedAmount: maxBufferedAmount });
+}
+
+onmessage = function (message) {
+    var data = message.data;
+    if (data.command === "produce") {
+        produce(data.count, data.payloadSize || 0);
+    } else if (data.command === "report") {
+        postMessage({ received: received, bufferedAmount: bufferedAmount });
+    } else {
+        received++;
+    }
+};
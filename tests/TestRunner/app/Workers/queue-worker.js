@@ -0,0 +1,14 @@
+// Echoes messages, the first one after keeping the worker busy for a while so that the queue to it fills up
+
+var isFirstMessage = true;
+
+onmessage = function (message) {
+    if (isFirstMessage) {
+        isFirstMessage = false;
+        var start = Date.now();
+        while (Date.now() - start < 200) {
+        }
+    }
+
+    postMessage(message.data);
+};
@@ -0,0 +1,7 @@
+// Writes to a SharedArrayBuffer it has been posted and posts it back
+
+onmessage = function (message) {
+    var view = new Int32Array(message.data.buffer);
+    view[0] = 42;
+    postMessage({ buffer: message.data.buffer, isSameBuffer: message.data.buffer === message.data.sameBuffer });
+};
@@ -39,6 +39,7 @@ import "./Marshalling/NSStringTests";
 import "./Marshalling/TypesTests";
 import "./Marshalling/PointerTests";
 import "./Marshalling/ReferenceTests";
+import "./Marshalling/ArgumentWriteKindTests";
 import "./Marshalling/FunctionPointerTests";
 import "./Marshalling/EnumTests";
 import "./Marshalling/ProtocolTests";
@@ -60,12 +61,17 @@ import "./DeclarationConflicts";
 
 import "./Promises";
 import "./Modules";
+import "./Workers";
 
 import "./RuntimeImplementedAPIs";
 
-// Tests common for all runtimes.
-require("./shared").runAllTests();
+if (args.containsObject("-benchmarks")) {
+    require("./Benchmarks").run();
+} else {
+    // Tests common for all runtimes.
+    require("./shared").runAllTests();
 
-execute();
+    execute();
+}
 
 UIApplicationMain(0, null, null, null);